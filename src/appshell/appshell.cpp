@@ -20,6 +20,7 @@
 #include "appshell.h"
 
 #include <QApplication>
+#include <QElapsedTimer>
 #include <QQmlApplicationEngine>
 #ifndef Q_OS_WASM
 #include <QThreadPool>
@@ -50,6 +51,9 @@ void AppShell::addModule(mu::framework::IModuleSetup* module)
 
 int AppShell::run(int argc, char** argv)
 {
+    QElapsedTimer startupTimer;
+    startupTimer.start();
+
     // ====================================================
     // Setup global Qt application variables
     // ====================================================
@@ -70,12 +74,34 @@ int AppShell::run(int argc, char** argv)
     QCoreApplication::setOrganizationDomain("musescore.org");
     QCoreApplication::setApplicationVersion(QString::fromStdString(framework::Version::fullVersion()));
 
+    // ====================================================
+    // Parse command line options
+    // ====================================================
+    CommandLineController commandLine;
+    commandLine.parse(QCoreApplication::arguments());
+    const framework::IApplication::RunMode runMode = commandLine.runMode();
+    const bool isEditor = runMode == framework::IApplication::RunMode::Editor;
+
+    //! NOTE The converter sets up only the modules it needs,
+    //! so it doesn't pay for the UI, audio output, MIDI, network...
+    if (!isEditor) {
+        QList<mu::framework::IModuleSetup*> used;
+        for (mu::framework::IModuleSetup* m : m_modules) {
+            if (m->isUsedByConverter()) {
+                used.push_back(m);
+            }
+        }
+        m_modules = used;
+    }
+
     // ====================================================
     // Setup modules: Resources, Exports, Imports, UiTypes
     // ====================================================
     globalModule.registerResources();
     globalModule.registerExports();
-    globalModule.registerUiTypes();
+    if (isEditor) {
+        globalModule.registerUiTypes();
+    }
 
     for (mu::framework::IModuleSetup* m : m_modules) {
         m->registerResources();
@@ -87,17 +113,16 @@ int AppShell::run(int argc, char** argv)
 
     globalModule.resolveImports();
     for (mu::framework::IModuleSetup* m : m_modules) {
-        m->registerUiTypes();
+        if (isEditor) {
+            m->registerUiTypes();
+        }
         m->resolveImports();
     }
 
     // ====================================================
-    // Parse and apply command line options
+    // Apply command line options
     // ====================================================
-    CommandLineController commandLine;
-    commandLine.parse(QCoreApplication::arguments());
     commandLine.apply();
-    framework::IApplication::RunMode runMode = muapplication()->runMode();
 
     // ====================================================
     // Setup modules: onInit
@@ -127,7 +152,8 @@ int AppShell::run(int argc, char** argv)
         // Process Converter
         // ====================================================
         auto task = commandLine.converterTask();
-        QMetaObject::invokeMethod(qApp, [this, task]() {
+        QMetaObject::invokeMethod(qApp, [this, task, startupTimer]() {
+                LOGI() << "converter startup time: " << startupTimer.elapsed() << " ms";
                 int code = processConverter(task);
                 qApp->exit(code);
             }, Qt::QueuedConnection);
@@ -208,7 +234,12 @@ int AppShell::processConverter(const CommandLineController::ConverterTask& task)
 {
     Ret ret;
     if (task.isBatchMode) {
-        ret = converter()->batchConvert(task.inputFile);
+        converter::IConverterController::BatchOptions options;
+        options.jobs = task.jobs;
+        options.reportPath = task.reportFile;
+        options.jobTimeoutSec = task.jobTimeoutSec;
+        options.workerArgs = task.workerArgs;
+        ret = converter()->batchConvert(task.inputFile, options);
         if (!ret) {
             LOGE() << "failed batch convert, error: " << ret.toString();
         }
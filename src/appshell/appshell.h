@@ -32,7 +32,6 @@
 namespace mu::appshell {
 class AppShell
 {
-    INJECT(appshell, framework::IApplication, muapplication)
     INJECT(appshell, converter::IConverterController, converter)
 
 public:
@@ -18,6 +18,9 @@
 //=============================================================================
 #include "commandlinecontroller.h"
 
+#include <QGuiApplication>
+#include <QThread>
+
 #include "log.h"
 
 using namespace mu::appshell;
@@ -37,8 +40,23 @@ void CommandLineController::parse(const QStringList& args)
     m_parser.addOption(QCommandLineOption({ "r", "image-resolution" }, "Set output resolution for image export", "DPI"));
     m_parser.addOption(QCommandLineOption({ "j", "job" }, "Process a conversion job", "file"));
     m_parser.addOption(QCommandLineOption({ "o", "export-to" }, "Export to 'file'. Format depends on file's extension", "file"));
+    m_parser.addOption(QCommandLineOption("layout-threads",
+                                          "Lay out measures on 'n' threads, 0 for one per core (experimental)", "n"));
+    m_parser.addOption(QCommandLineOption("jobs", "Convert 'n' files of a conversion job at a time, 0 for one per core", "n"));
+    m_parser.addOption(QCommandLineOption("report", "Write the results of a conversion job to a JSON 'file'", "file"));
+    m_parser.addOption(QCommandLineOption("job-timeout",
+                                          "Stop converting a file of a conversion job after 's' seconds, 0 for no limit", "s"));
 
     m_parser.process(args);
+    m_args = args;
+}
+
+IApplication::RunMode CommandLineController::runMode() const
+{
+    if (m_parser.isSet("o") || m_parser.isSet("j")) {
+        return IApplication::RunMode::Converter;
+    }
+    return IApplication::RunMode::Editor;
 }
 
 void CommandLineController::apply()
@@ -75,6 +93,16 @@ void CommandLineController::apply()
         }
     }
 
+    if (m_parser.isSet("layout-threads")) {
+        bool ok = false;
+        int threads = m_parser.value("layout-threads").toInt(&ok);
+        if (ok && threads >= 0) {
+            notationConfiguration()->setLayoutThreads(threads);
+        } else {
+            LOGE() << "Option: --layout-threads not recognized thread count: " << m_parser.value("layout-threads");
+        }
+    }
+
     if (m_parser.isSet("o")) {
         application()->setRunMode(IApplication::RunMode::Converter);
         if (scorefiles.size() < 1) {
@@ -92,7 +120,55 @@ void CommandLineController::apply()
         application()->setRunMode(IApplication::RunMode::Converter);
         m_converterTask.isBatchMode = true;
         m_converterTask.inputFile = m_parser.value("j");
+
+        if (m_parser.isSet("jobs")) {
+            bool ok = false;
+            int jobs = m_parser.value("jobs").toInt(&ok);
+            if (ok && jobs >= 0) {
+                m_converterTask.jobs = jobs > 0 ? jobs : QThread::idealThreadCount();
+            } else {
+                LOGE() << "Option: --jobs not recognized job count: " << m_parser.value("jobs");
+            }
+        }
+        m_converterTask.reportFile = m_parser.value("report");
+
+        if (m_parser.isSet("job-timeout")) {
+            bool ok = false;
+            int timeout = m_parser.value("job-timeout").toInt(&ok);
+            if (ok && timeout >= 0) {
+                m_converterTask.jobTimeoutSec = timeout;
+            } else {
+                LOGE() << "Option: --job-timeout not recognized seconds: " << m_parser.value("job-timeout");
+            }
+        }
+
+        m_converterTask.workerArgs = workerArgs();
+    }
+}
+
+//! NOTE Workers convert one file of the batch each, with all other options of this process.
+//! Qt removes its own options like -platform from the arguments, so the platform is passed on explicitly.
+QStringList CommandLineController::workerArgs() const
+{
+    static const QStringList batchOptions { "j", "job", "jobs", "report", "job-timeout", "o", "export-to" };
+
+    QStringList args;
+    for (int i = 1; i < m_args.size(); ++i) {
+        const QString& arg = m_args.at(i);
+        QString name = arg.section('=', 0, 0);
+        while (name.startsWith('-')) {
+            name.remove(0, 1);
+        }
+        if (arg.startsWith('-') && batchOptions.contains(name)) {
+            if (!arg.contains('=')) {
+                ++i;        // skip the value
+            }
+            continue;
+        }
+        args << arg;
     }
+    args << "-platform" << QGuiApplication::platformName();
+    return args;
 }
 
 CommandLineController::ConverterTask CommandLineController::converterTask() const
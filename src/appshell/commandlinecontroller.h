@@ -26,6 +26,7 @@
 #include "global/iapplication.h"
 #include "ui/iuiconfiguration.h"
 #include "importexport/imagesexport/iimagesexportconfiguration.h"
+#include "notation/inotationconfiguration.h"
 
 namespace mu::appshell {
 class CommandLineController
@@ -33,6 +34,7 @@ class CommandLineController
     INJECT(appshell, framework::IApplication, application)
     INJECT(appshell, ui::IUiConfiguration, uiConfiguration)
     INJECT(appshell, iex::imagesexport::IImagesExportConfiguration, imagesExportConfiguration)
+    INJECT(appshell, notation::INotationConfiguration, notationConfiguration)
 public:
     CommandLineController() = default;
 
@@ -40,16 +42,26 @@ public:
         bool isBatchMode = false;
         QString inputFile;
         QString outputFile;
+        int jobs = 1;
+        QString reportFile;
+        int jobTimeoutSec = 600;
+        QStringList workerArgs;     // options applying to each file of a batch
     };
 
     void parse(const QStringList& args);
     void apply();
 
+    //! NOTE Known right after parse, before the modules are set up
+    framework::IApplication::RunMode runMode() const;
+
     ConverterTask converterTask() const;
 
 private:
 
+    QStringList workerArgs() const;
+
     QCommandLineParser m_parser;
+    QStringList m_args;
     ConverterTask m_converterTask;
 };
 }
@@ -39,6 +39,11 @@ std::string CloudModule::moduleName() const
     return "cloud";
 }
 
+bool CloudModule::isUsedByConverter() const
+{
+    return false;
+}
+
 void CloudModule::registerExports()
 {
     m_accountController = new AccountController();
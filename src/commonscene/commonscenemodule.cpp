@@ -28,6 +28,11 @@ std::string CommonSceneModule::moduleName() const
     return "commonscene";
 }
 
+bool CommonSceneModule::isUsedByConverter() const
+{
+    return false;
+}
+
 void CommonSceneModule::registerExports()
 {
 }
@@ -28,6 +28,7 @@ class CommonSceneModule : public framework::IModuleSetup
 public:
 
     std::string moduleName() const override;
+    bool isUsedByConverter() const override;
 
     void registerExports() override;
     void resolveImports() override;
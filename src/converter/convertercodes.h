@@ -29,6 +29,8 @@ enum class Err {
 
     BatchJobFileFailedOpen = 1301,
     BatchJobFileFailedParse = 1302,
+    BatchJobFailed = 1303,
+    BatchJobTimedOut = 1304,
 
     ConvertTypeUnknown = 1310,
 
@@ -36,6 +38,8 @@ enum class Err {
 
     OutFileFailedOpen = 1330,
     OutFileFailedWrite = 1331,
+
+    ReportFileFailedWrite = 1340,
 };
 
 inline Ret make_ret(Err e)
@@ -19,6 +19,8 @@
 #ifndef MU_CONVERTER_ICONVERTERCONTROLLER_H
 #define MU_CONVERTER_ICONVERTERCONTROLLER_H
 
+#include <QStringList>
+
 #include "modularity/imoduleexport.h"
 #include "ret.h"
 #include "io/path.h"
@@ -30,8 +32,15 @@ class IConverterController : MODULE_EXPORT_INTERFACE
 public:
     virtual ~IConverterController() = default;
 
+    struct BatchOptions {
+        int jobs = 1;               // jobs converted at the same time, each in its own process if > 1
+        io::path reportPath;        // JSON report of the results of all jobs, none if empty
+        int jobTimeoutSec = 600;    // a worker process converting a job longer is killed, 0 for no limit
+        QStringList workerArgs;     // command line options passed on to worker processes
+    };
+
     virtual Ret fileConvert(const io::path& in, const io::path& out) = 0;
-    virtual Ret batchConvert(const io::path& batchJobFile) = 0;
+    virtual Ret batchConvert(const io::path& batchJobFile, const BatchOptions& options) = 0;
 };
 }
 
@@ -18,19 +18,49 @@
 //=============================================================================
 #include "convertercontroller.h"
 
+#include <functional>
+#include <memory>
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEventLoop>
 #include <QFile>
+#include <QFileInfo>
+#include <QProcess>
+#include <QTemporaryDir>
+#include <QTimer>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QJsonParseError>
 
+#ifdef Q_OS_UNIX
+#include <sys/resource.h>
+#endif
+
 #include "log.h"
 #include "convertercodes.h"
 #include "stringutils.h"
 
 using namespace mu::converter;
 
-mu::Ret ConverterController::batchConvert(const io::path& batchJobFile)
+//! NOTE The peak resident size of this process, over all jobs it converted
+static qint64 peakMemoryKb()
+{
+#ifdef Q_OS_UNIX
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#ifdef Q_OS_MAC
+        return usage.ru_maxrss / 1024;     // bytes on macOS
+#else
+        return usage.ru_maxrss;
+#endif
+    }
+#endif
+    return -1;
+}
+
+mu::Ret ConverterController::batchConvert(const io::path& batchJobFile, const BatchOptions& options)
 {
     RetVal<BatchJob> batchJob = parseBatchJob(batchJobFile);
     if (!batchJob.ret) {
@@ -38,16 +68,234 @@ mu::Ret ConverterController::batchConvert(const io::path& batchJobFile)
         return batchJob.ret;
     }
 
-    Ret ret = make_ret(Ret::Code::Ok);
-    for (const Job& job : batchJob.val) {
-        ret = fileConvert(job.in, job.out);
+    QElapsedTimer timer;
+    timer.start();
+
+    JobResults results = (options.jobs > 1 && batchJob.val.size() > 1)
+                         ? convertInWorkers(batchJob.val, options)
+                         : convertSequentially(batchJob.val);
+
+    size_t failed = 0;
+    for (const JobResult& r : results) {
+        if (r.code != int(Ret::Code::Ok)) {
+            LOGE() << "failed convert, err: " << r.code << " " << r.error << ", in: " << r.job.in << ", out: " << r.job.out;
+            ++failed;
+        }
+    }
+    LOGI() << "converted " << results.size() - failed << " of " << results.size() << " files in " << timer.elapsed() << " ms";
+
+    if (!options.reportPath.empty()) {
+        Ret ret = writeReport(options.reportPath, results, timer.elapsed());
         if (!ret) {
-            LOGE() << "failed convert, err: " << ret.toString() << ", in: " << job.in << ", out: " << job.out;
-            break;
+            return ret;
+        }
+    }
+
+    return failed ? make_ret(Err::BatchJobFailed) : make_ret(Ret::Code::Ok);
+}
+
+ConverterController::JobResults ConverterController::convertSequentially(const BatchJob& batchJob)
+{
+    JobResults results;
+    for (const Job& job : batchJob) {
+        QElapsedTimer timer;
+        timer.start();
+        Ret ret = fileConvert(job.in, job.out);
+
+        JobResult r;
+        r.job = job;
+        r.code = ret.code();
+        r.error = ret.text();
+        r.elapsedMs = timer.elapsed();
+        results.push_back(r);
+    }
+    // the process peak is the peak of the job only if it is the only one, as in a worker
+    if (results.size() == 1) {
+        results.front().peakMemoryKb = peakMemoryKb();
+    }
+    return results;
+}
+
+//! NOTE libmscore keeps global state (image store, fonts, MScore statics),
+//! so jobs run in parallel in worker processes of this executable.
+//! Each worker converts a batch of one job and reports it like convertSequentially().
+ConverterController::JobResults ConverterController::convertInWorkers(const BatchJob& batchJob,
+                                                                      const BatchOptions& options)
+{
+    std::vector<Job> jobs(batchJob.begin(), batchJob.end());
+    JobResults results(jobs.size());
+
+    QTemporaryDir tempDir;
+    if (!tempDir.isValid()) {
+        LOGE() << "failed create temporary directory, converting sequentially";
+        return convertSequentially(batchJob);
+    }
+
+    QEventLoop loop;
+    size_t next = 0;
+    int running = 0;
+
+    std::function<void()> startNext = [&]() {
+        while (running < options.jobs && next < jobs.size()) {
+            const size_t idx = next++;
+            const Job& job = jobs[idx];
+            results[idx].job = job;
+
+            const QString jobPath = tempDir.filePath(QString("job%1.json").arg(idx));
+            const QString reportPath = tempDir.filePath(QString("report%1.json").arg(idx));
+
+            QFile jobFile(jobPath);
+            if (!jobFile.open(QIODevice::WriteOnly)) {
+                results[idx].code = int(Err::BatchJobFileFailedOpen);
+                continue;
+            }
+            QJsonObject obj;
+            obj["in"] = job.in.toQString();
+            obj["out"] = job.out.toQString();
+            jobFile.write(QJsonDocument(QJsonArray { obj }).toJson());
+            jobFile.close();
+
+            QStringList args = options.workerArgs;
+            args << "-j" << jobPath << "--report" << reportPath;
+
+            QProcess* process = new QProcess();
+            process->setProcessChannelMode(QProcess::ForwardedChannels);
+
+            auto timer = std::make_shared<QElapsedTimer>();
+            timer->start();
+
+            auto timedOut = std::make_shared<bool>(false);
+            QTimer* timeout = nullptr;
+            if (options.jobTimeoutSec > 0) {
+                timeout = new QTimer(process);
+                timeout->setSingleShot(true);
+                QObject::connect(timeout, &QTimer::timeout, [process, timedOut, job]() {
+                    LOGE() << "worker timed out, killing it, in: " << job.in;
+                    *timedOut = true;
+                    process->kill();
+                });
+            }
+
+            auto finished = [&, process, idx, reportPath, timer, timeout, timedOut](int exitCode) {
+                if (timeout) {
+                    timeout->stop();
+                }
+                JobResult& r = results[idx];
+                RetVal<JobResults> report = readReport(reportPath);
+                if (*timedOut) {
+                    r.code = int(Err::BatchJobTimedOut);
+                    r.error = "worker process timed out";
+                } else if (report.ret && report.val.size() == 1) {
+                    r = report.val.front();
+                } else {
+                    // the worker crashed or could not write its report
+                    r.code = exitCode ? exitCode : int(Err::UnknownError);
+                    r.error = "worker process failed";
+                }
+                r.job = jobs[idx];
+                r.elapsedMs = timer->elapsed();
+
+                process->deleteLater();
+                --running;
+                startNext();
+                if (running == 0) {
+                    loop.quit();
+                }
+            };
+
+            QObject::connect(process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
+                             [finished](int exitCode, QProcess::ExitStatus) { finished(exitCode); });
+            QObject::connect(process, &QProcess::errorOccurred, [finished](QProcess::ProcessError error) {
+                    if (error == QProcess::FailedToStart) {
+                        finished(int(Err::UnknownError));
+                    }
+                });
+
+            ++running;
+            process->start(QCoreApplication::applicationFilePath(), args);
+            if (timeout) {
+                timeout->start(options.jobTimeoutSec * 1000);
+            }
+        }
+    };
+
+    startNext();
+    if (running > 0) {
+        loop.exec();
+    }
+
+    return results;
+}
+
+mu::Ret ConverterController::writeReport(const io::path& reportPath, const JobResults& results, qint64 elapsedMs) const
+{
+    QJsonArray jobs;
+    int failed = 0;
+    for (const JobResult& r : results) {
+        QJsonObject obj;
+        obj["in"] = r.job.in.toQString();
+        obj["out"] = r.job.out.toQString();
+        obj["code"] = r.code;
+        obj["status"] = r.code == int(Ret::Code::Ok) ? "ok" : "failed";
+        if (!r.error.empty()) {
+            obj["error"] = QString::fromStdString(r.error);
+        }
+        obj["elapsedMs"] = r.elapsedMs;
+        obj["peakMemoryKb"] = r.peakMemoryKb;
+        jobs.append(obj);
+        if (r.code != int(Ret::Code::Ok)) {
+            ++failed;
         }
     }
 
-    return ret;
+    QJsonObject report;
+    report["total"] = int(results.size());
+    report["failed"] = failed;
+    report["elapsedMs"] = elapsedMs;
+    report["processPeakMemoryKb"] = peakMemoryKb();
+    report["jobs"] = jobs;
+
+    QFile file(reportPath.toQString());
+    if (!file.open(QIODevice::WriteOnly)) {
+        LOGE() << "failed open report file: " << reportPath;
+        return make_ret(Err::ReportFileFailedWrite);
+    }
+    file.write(QJsonDocument(report).toJson());
+    return make_ret(Ret::Code::Ok);
+}
+
+mu::RetVal<ConverterController::JobResults> ConverterController::readReport(const io::path& reportPath) const
+{
+    RetVal<JobResults> rv;
+    QFile file(reportPath.toQString());
+    if (!file.open(QIODevice::ReadOnly)) {
+        rv.ret = make_ret(Err::BatchJobFileFailedOpen);
+        return rv;
+    }
+
+    QJsonParseError err;
+    QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &err);
+    if (err.error != QJsonParseError::NoError || !doc.isObject()) {
+        rv.ret = make_ret(Err::BatchJobFileFailedParse, err.errorString().toStdString());
+        return rv;
+    }
+
+    const QJsonArray jobs = doc.object().value("jobs").toArray();
+    for (const QJsonValue v : jobs) {
+        QJsonObject obj = v.toObject();
+
+        JobResult r;
+        r.job.in = obj["in"].toString();
+        r.job.out = obj["out"].toString();
+        r.code = obj["code"].toInt();
+        r.error = obj["error"].toString().toStdString();
+        r.elapsedMs = qint64(obj["elapsedMs"].toDouble());
+        r.peakMemoryKb = qint64(obj["peakMemoryKb"].toDouble(-1));
+        rv.val.push_back(std::move(r));
+    }
+
+    rv.ret = make_ret(Ret::Code::Ok);
+    return rv;
 }
 
 mu::Ret ConverterController::fileConvert(const io::path& in, const io::path& out)
@@ -71,6 +319,13 @@ mu::Ret ConverterController::fileConvert(const io::path& in, const io::path& out
         return make_ret(Err::InFileFailedLoad);
     }
 
+    //! NOTE The first page is written to out, as before; the following pages of
+    //! scores with several pages are written next to it as <name>-<page>.<suffix>
+    const int pagesCount = static_cast<int>(masterNotation->notation()->elements()->pages().size());
+    if (pagesCount > 1 && (suffix == "png" || suffix == "svg")) {
+        return writePages(writer, masterNotation->notation(), out, pagesCount);
+    }
+
     QFile file(out.toQString());
     if (!file.open(QFile::WriteOnly)) {
         return make_ret(Err::OutFileFailedOpen);
@@ -87,6 +342,34 @@ mu::Ret ConverterController::fileConvert(const io::path& in, const io::path& out
     return make_ret(Ret::Code::Ok);
 }
 
+mu::Ret ConverterController::writePages(notation::INotationWriterPtr writer, notation::INotationPtr notation, const io::path& out,
+                                        int pagesCount) const
+{
+    QFileInfo outInfo(out.toQString());
+
+    std::vector<std::unique_ptr<QFile> > files;
+    std::vector<system::IODevice*> devices;
+    for (int pageNumber = 0; pageNumber < pagesCount; ++pageNumber) {
+        QString fileName = pageNumber == 0
+                           ? out.toQString()
+                           : QString("%1/%2-%3.%4").arg(outInfo.path(), outInfo.completeBaseName()).arg(pageNumber + 1).arg(outInfo.suffix());
+        auto file = std::make_unique<QFile>(fileName);
+        if (!file->open(QFile::WriteOnly)) {
+            return make_ret(Err::OutFileFailedOpen);
+        }
+        devices.push_back(file.get());
+        files.push_back(std::move(file));
+    }
+
+    Ret ret = writer->writePages(notation, devices, 0);
+    if (!ret) {
+        LOGE() << "failed write, err: " << ret.toString() << ", path: " << out;
+        return make_ret(Err::OutFileFailedWrite);
+    }
+
+    return make_ret(Ret::Code::Ok);
+}
+
 mu::RetVal<ConverterController::BatchJob> ConverterController::parseBatchJob(const io::path& batchJobFile) const
 {
     RetVal<BatchJob> rv;
@@ -20,6 +20,7 @@
 #define MU_CONVERTER_CONVERTERCONTROLLER_H
 
 #include <list>
+#include <vector>
 
 #include "../iconvertercontroller.h"
 
@@ -39,7 +40,7 @@ public:
     ConverterController() = default;
 
     Ret fileConvert(const io::path& in, const io::path& out) override;
-    Ret batchConvert(const io::path& batchJobFile) override;
+    Ret batchConvert(const io::path& batchJobFile, const BatchOptions& options) override;
 
 private:
 
@@ -48,9 +49,26 @@ private:
         io::path out;
     };
 
+    struct JobResult {
+        Job job;
+        int code = 0;
+        std::string error;
+        qint64 elapsedMs = 0;
+        qint64 peakMemoryKb = -1;   // peak resident size of the process converting only this job, -1 if unknown
+    };
+
     using BatchJob = std::list<Job>;
+    using JobResults = std::vector<JobResult>;
 
     RetVal<BatchJob> parseBatchJob(const io::path& batchJobFile) const;
+
+    JobResults convertSequentially(const BatchJob& batchJob);
+    JobResults convertInWorkers(const BatchJob& batchJob, const BatchOptions& options);
+
+    Ret writePages(notation::INotationWriterPtr writer, notation::INotationPtr notation, const io::path& out, int pagesCount) const;
+
+    Ret writeReport(const io::path& reportPath, const JobResults& results, qint64 elapsedMs) const;
+    RetVal<JobResults> readReport(const io::path& reportPath) const;
 };
 }
 
@@ -43,6 +43,11 @@ std::string ExtensionsModule::moduleName() const
     return "extensions";
 }
 
+bool ExtensionsModule::isUsedByConverter() const
+{
+    return false;
+}
+
 void ExtensionsModule::registerExports()
 {
     framework::ioc()->registerExport<IExtensionsConfiguration>(moduleName(), m_extensionsConfiguration);
@@ -27,6 +27,7 @@ class ExtensionsModule : public framework::IModuleSetup
 public:
 
     std::string moduleName() const override;
+    bool isUsedByConverter() const override;
 
     void registerExports() override;
     void registerResources() override;
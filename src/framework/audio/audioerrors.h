@@ -41,6 +41,10 @@ enum class Err {
     SoundFontNotLoaded = 332,
     SoundFontFailedLoad = 333,
     SoundFontFailedUnload = 334,
+
+    // offline render
+    RenderAborted = 340,
+    RenderNoSynthesizer = 341,
 };
 
 inline Ret make_ret(Err e)
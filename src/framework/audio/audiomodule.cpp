@@ -35,6 +35,7 @@
 #include "internal/audiosanitizer.h"
 #include "internal/audiothread.h"
 #include "internal/audiobuffer.h"
+#include "internal/offline/offlinerenderer.h"
 
 // synthesizers
 #include "internal/synthesizers/fluidsynth/fluidsynth.h"
@@ -98,6 +99,7 @@ void AudioModule::registerExports()
     ioc()->registerExport<IAudioConfiguration>(moduleName(), s_audioConfiguration);
     ioc()->registerExport<IAudioDriver>(moduleName(), s_audioDriver);
     ioc()->registerExport<ISequencer>(moduleName(), s_rpcSequencer);
+    ioc()->registerExport<IOfflineRenderer>(moduleName(), std::make_shared<OfflineRenderer>());
 
     // synthesizers
     std::shared_ptr<synth::ISynthesizersRegister> sreg = std::make_shared<synth::SynthesizersRegister>();
@@ -125,7 +127,7 @@ void AudioModule::registerUiTypes()
     ioc()->resolve<ui::IUiEngine>(moduleName())->addSourceImportPath(audio_QML_IMPORT);
 }
 
-void AudioModule::onInit(const framework::IApplication::RunMode&)
+void AudioModule::onInit(const framework::IApplication::RunMode& mode)
 {
     /** We have three layers
         ------------------------
@@ -160,6 +162,12 @@ void AudioModule::onInit(const framework::IApplication::RunMode&)
     // Init configuration
     s_audioConfiguration->init();
 
+    //! NOTE The converter renders audio with the offline renderer only,
+    //! it needs neither the worker nor the audio driver
+    if (mode == framework::IApplication::RunMode::Converter) {
+        return;
+    }
+
     // Setup rpc system and worker
     s_rpcSequencer->setup();
     s_audioWorker->channel()->setupMainThread();
@@ -214,7 +222,9 @@ void AudioModule::onInit(const framework::IApplication::RunMode&)
 
 void AudioModule::onDeinit()
 {
-    s_audioDriver->close();
+    if (s_audioDriver->isOpened()) {
+        s_audioDriver->close();
+    }
     s_audioWorker->stop([]() {
         ONLY_AUDIO_WORKER_THREAD;
         s_rpcControllers->deinit();
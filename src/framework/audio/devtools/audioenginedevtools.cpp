@@ -35,6 +35,21 @@ AudioEngineDevTools::AudioEngineDevTools(QObject* parent)
     sequencer()->positionChanged().onNotify(this, [this]() {
         emit timeChanged();
     });
+
+    m_listenID = rpcChannel()->listen([this](const Msg& msg) {
+        if (msg.target != Target(TargetName::DevTools)) {
+            return;
+        }
+
+        if (msg.method == "renderProfile") {
+            setRenderProfile(msg.args.arg<RenderProfile>(0));
+        }
+    });
+}
+
+AudioEngineDevTools::~AudioEngineDevTools()
+{
+    rpcChannel()->unlisten(m_listenID);
 }
 
 void AudioEngineDevTools::playSine()
@@ -253,3 +268,46 @@ void AudioEngineDevTools::makeArpeggio()
         m_midiStream->stream.send(chunk);
     });
 }
+
+void AudioEngineDevTools::requestRenderProfile()
+{
+    rpcChannel()->send(Msg(TargetName::DevTools, "requestRenderProfile"));
+}
+
+void AudioEngineDevTools::resetRenderProfile()
+{
+    rpcChannel()->send(Msg(TargetName::DevTools, "resetRenderProfile"));
+}
+
+QVariantMap AudioEngineDevTools::renderProfile() const
+{
+    return m_renderProfile;
+}
+
+void AudioEngineDevTools::setRenderProfile(const RenderProfile& profile)
+{
+    auto statsToMap = [](const RenderProfiler::Stats& stats) {
+        QVariantMap map;
+        map["blocks"] = qulonglong(stats.blocks);
+        map["deadlineMisses"] = qulonglong(stats.deadlineMisses);
+        map["dropped"] = qulonglong(stats.dropped);
+        map["p50"] = stats.p50;
+        map["p99"] = stats.p99;
+        map["max"] = stats.max;
+        return map;
+    };
+
+    QVariantMap channels;
+    for (const auto& channel : profile.channels) {
+        channels[QString::number(channel.first)] = statsToMap(channel.second);
+    }
+
+    m_renderProfile.clear();
+    m_renderProfile["blockSamples"] = profile.blockSamples;
+    m_renderProfile["underruns"] = qulonglong(profile.underruns);
+    m_renderProfile["overruns"] = qulonglong(profile.overruns);
+    m_renderProfile["mixer"] = statsToMap(profile.mixer);
+    m_renderProfile["channels"] = channels;
+
+    emit renderProfileChanged();
+}
@@ -22,6 +22,7 @@
 #include <QObject>
 #include <QTimer>
 #include <QVariantList>
+#include <QVariantMap>
 
 #include <optional>
 #include "modularity/ioc.h"
@@ -32,6 +33,7 @@
 #include "global/iinteractive.h"
 #include "iaudiostream.h"
 #include "internal/rpc/irpcchannel.h"
+#include "internal/worker/renderprofiler.h"
 
 namespace mu::audio {
 class AudioEngineDevTools : public QObject, public async::Asyncable
@@ -45,9 +47,11 @@ class AudioEngineDevTools : public QObject, public async::Asyncable
 
     Q_PROPERTY(float time READ time NOTIFY timeChanged)
     Q_PROPERTY(QVariantList devices READ devices NOTIFY devicesChanged)
+    Q_PROPERTY(QVariantMap renderProfile READ renderProfile NOTIFY renderProfileChanged)
 
 public:
     explicit AudioEngineDevTools(QObject* parent = nullptr);
+    ~AudioEngineDevTools() override;
 
     Q_INVOKABLE void playSine();
     Q_INVOKABLE void stopSine();
@@ -86,12 +90,21 @@ public:
 
     float time() const;
 
+    Q_INVOKABLE void requestRenderProfile();
+    Q_INVOKABLE void resetRenderProfile();
+    QVariantMap renderProfile() const;
+
 signals:
     void timeChanged();
     void devicesChanged();
+    void renderProfileChanged();
 
 private:
     void makeArpeggio();
+    void setRenderProfile(const RenderProfile& profile);
+
+    rpc::IRpcChannel::ListenID m_listenID = 0;
+    QVariantMap m_renderProfile;
 
     std::shared_ptr<midi::MidiStream> m_midiStream = nullptr;
     std::shared_ptr<IAudioStream> m_audioStream = nullptr;
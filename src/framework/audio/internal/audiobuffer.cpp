@@ -17,97 +17,113 @@
 //  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
 //=============================================================================
 #include "audiobuffer.h"
+#include <algorithm>
 #include <cstring>
 #include "log.h"
 
 using namespace mu::audio;
 
+static unsigned int nextPowerOfTwo(unsigned int v)
+{
+    unsigned int p = 1;
+    while (p < v) {
+        p <<= 1;
+    }
+    return p;
+}
+
 AudioBuffer::AudioBuffer(unsigned int streamsPerSample, unsigned int size)
     : m_streamsPerSample(streamsPerSample)
 {
-    m_data.resize(size * m_streamsPerSample, 0.f);
+    //! NOTE The storage is never reallocated after construction,
+    //! the driver may call pop at any moment
+    unsigned int samples = nextPowerOfTwo(std::max(size, 2 * (FILL_SAMPLES + FILL_OVER)));
+    m_data.resize(nextPowerOfTwo(samples * m_streamsPerSample), 0.f);
+    m_mask = m_data.size() - 1;
 }
 
 void AudioBuffer::setSource(std::shared_ptr<IAudioSource> source)
 {
-    std::lock_guard<std::recursive_mutex> lock(m_mutex);
     m_source = source;
 }
 
 void AudioBuffer::forward()
 {
-    std::lock_guard<std::recursive_mutex> lock(m_mutex);
     fillup();
 }
 
 void AudioBuffer::push(const float* source, int sampleCount)
 {
-    std::lock_guard<std::recursive_mutex> lock(m_mutex);
-
-    unsigned int from = m_writeIndex;
-    auto memStep = sizeof(float);
-    auto to = m_writeIndex + sampleCount * m_streamsPerSample;
-    if (to > m_data.size()) {
-        to = m_data.size() - 1;
-    }
-    auto count = to - from;
-    std::memcpy(m_data.data() + m_writeIndex, source, count * memStep);
-    m_writeIndex += count;
-
-    int left = sampleCount * m_streamsPerSample - count;
-    if (left > 0) {
-        std::memcpy(m_data.data(), source + count, left * memStep);
-        m_writeIndex = left;
+    if (sampleCount <= 0) {
+        return;
     }
 
-    if (m_writeIndex >= m_data.size()) {
-        m_writeIndex -= m_data.size();
+    //! NOTE Only the producer writes m_writeIndex
+    uint64_t write = m_writeIndex.load(std::memory_order_relaxed);
+    uint64_t read = m_readIndex.load(std::memory_order_acquire);
+
+    uint64_t free = m_data.size() - (write - read);
+    uint64_t count = std::min<uint64_t>(static_cast<uint64_t>(sampleCount) * m_streamsPerSample, free);
+    count -= count % m_streamsPerSample;
+
+    if (count < static_cast<uint64_t>(sampleCount) * m_streamsPerSample) {
+        m_overrunCount.fetch_add(sampleCount - count / m_streamsPerSample, std::memory_order_relaxed);
     }
+
+    uint64_t pos = write & m_mask;
+    uint64_t first = std::min<uint64_t>(count, m_data.size() - pos);
+    std::memcpy(m_data.data() + pos, source, first * sizeof(float));
+    std::memcpy(m_data.data(), source + first, (count - first) * sizeof(float));
+
+    m_writeIndex.store(write + count, std::memory_order_release);
 }
 
 void AudioBuffer::pop(float* dest, unsigned int sampleCount)
 {
-    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    //! NOTE Only the consumer writes m_readIndex
+    uint64_t read = m_readIndex.load(std::memory_order_relaxed);
+    uint64_t write = m_writeIndex.load(std::memory_order_acquire);
 
-    //catch up if we are fall behind
-    if (sampleCount > sampleLag()) {
-        //! TODO We have to decide to wait or skip.
-        //! We cannot make a direct call, this is a thread-unsafe.
-        //fillup();
-    }
+    uint64_t requested = static_cast<uint64_t>(sampleCount) * m_streamsPerSample;
+    uint64_t count = std::min(requested, write - read);
 
-    unsigned int from = m_readIndex;
-    auto memStep = sizeof(float);
-    auto to = m_readIndex + sampleCount * m_streamsPerSample;
-    if (to > m_data.size()) {
-        to = m_data.size();
-    }
-    auto count = to - from;
-    std::memcpy(dest, m_data.data() + from, count * memStep);
-    m_readIndex += count;
-
-    int left = sampleCount * m_streamsPerSample - count;
-    if (left > 0) {
-        std::memcpy(dest + count, m_data.data(), left * memStep);
-        m_readIndex = left;
-    }
+    uint64_t pos = read & m_mask;
+    uint64_t first = std::min<uint64_t>(count, m_data.size() - pos);
+    std::memcpy(dest, m_data.data() + pos, first * sizeof(float));
+    std::memcpy(dest + first, m_data.data(), (count - first) * sizeof(float));
 
-    if (m_readIndex >= m_data.size()) {
-        m_readIndex -= m_data.size();
+    m_readIndex.store(read + count, std::memory_order_release);
+
+    //! NOTE We fell behind the worker: play silence instead of stale data
+    //! and let the worker catch up on its next forward
+    if (count < requested) {
+        std::memset(dest + count, 0, (requested - count) * sizeof(float));
+        m_underrunCount.fetch_add(1, std::memory_order_relaxed);
     }
 }
 
 void AudioBuffer::setMinSampleLag(unsigned int lag)
 {
-    std::lock_guard<std::recursive_mutex> lock(m_mutex);
-
-    IF_ASSERT_FAILED(lag < m_data.size()) {
-        lag = m_data.size();
+    unsigned int maxLag = capacity() - FILL_SAMPLES - FILL_OVER;
+    IF_ASSERT_FAILED(lag <= maxLag) {
+        lag = maxLag;
     }
     m_minSampleLag = lag;
-    if (m_data.size() < 2 * m_minSampleLag * m_streamsPerSample) {
-        m_data.resize(2 * m_minSampleLag * m_streamsPerSample, 0.f);
-    }
+}
+
+unsigned int AudioBuffer::capacity() const
+{
+    return m_data.size() / m_streamsPerSample;
+}
+
+uint64_t AudioBuffer::underrunCount() const
+{
+    return m_underrunCount.load(std::memory_order_relaxed);
+}
+
+uint64_t AudioBuffer::overrunCount() const
+{
+    return m_overrunCount.load(std::memory_order_relaxed);
 }
 
 void AudioBuffer::fillup()
@@ -125,12 +141,8 @@ void AudioBuffer::fillup()
 
 unsigned int AudioBuffer::sampleLag() const
 {
-    unsigned int lag = 0;
-    if (m_readIndex <= m_writeIndex) {
-        lag = m_writeIndex - m_readIndex;
-    } else {
-        lag = m_writeIndex + m_data.size() - m_readIndex;
-    }
+    uint64_t write = m_writeIndex.load(std::memory_order_relaxed);
+    uint64_t read = m_readIndex.load(std::memory_order_acquire);
 
-    return lag / m_streamsPerSample;
+    return (write - read) / m_streamsPerSample;
 }
@@ -25,6 +25,10 @@
 #include "iaudiobuffer.h"
 
 namespace mu::audio {
+//! NOTE Single producer / single consumer ring buffer.
+//! The producer is the audio worker (forward, push, setSource, setMinSampleLag),
+//! the consumer is the audio driver callback (pop).
+//! Neither side ever takes a lock, so the driver callback cannot be blocked by the worker.
 class AudioBuffer : public IAudioBuffer
 {
     const static unsigned int DEFAULT_SIZE = 16384;
@@ -41,17 +45,34 @@ public:
     void pop(float* dest, unsigned int sampleCount) override;
     void setMinSampleLag(unsigned int lag) override;
 
+    //! capacity in samples (frames of streamsPerSample values), at least the requested size.
+    //! The storage is size * streamsPerSample values rounded up to a power of two, the capacity is
+    //! the storage divided by streamsPerSample, so it is a power of two only if streamsPerSample is
+    unsigned int capacity() const;
+
+    //! count of pop calls that could not be fully served and were padded with silence
+    uint64_t underrunCount() const override;
+
+    //! count of samples dropped by push because the buffer was full
+    uint64_t overrunCount() const override;
+
 private:
 
     unsigned int sampleLag() const;
     void fillup();
 
-    std::recursive_mutex m_mutex; //! TODO get rid *recursive*
     unsigned int m_streamsPerSample = 0;
     unsigned int m_minSampleLag = FILL_SAMPLES;
-    unsigned int m_writeIndex = 0;
-    unsigned int m_readIndex = 0;
+
+    //! NOTE Indices are in values (not samples) and grow monotonically,
+    //! the position in m_data is index & m_mask
+    std::atomic<uint64_t> m_writeIndex = 0;
+    std::atomic<uint64_t> m_readIndex = 0;
+    std::atomic<uint64_t> m_underrunCount = 0;
+    std::atomic<uint64_t> m_overrunCount = 0;
+
     std::vector<float> m_data = {};
+    uint64_t m_mask = 0;
     std::shared_ptr<IAudioSource> m_source = nullptr;
 };
 }
@@ -24,6 +24,7 @@ using namespace mu::audio;
 
 static std::thread::id s_as_mainThreadID;
 static std::thread::id s_as_workerThreadID;
+static thread_local bool s_as_isRenderThread = false;
 
 void AudioSanitizer::setupMainThread()
 {
@@ -47,5 +48,10 @@ std::thread::id AudioSanitizer::workerThread()
 
 bool AudioSanitizer::isWorkerThread()
 {
-    return std::this_thread::get_id() == s_as_workerThreadID;
+    return std::this_thread::get_id() == s_as_workerThreadID || s_as_isRenderThread;
+}
+
+void AudioSanitizer::setupRenderThread()
+{
+    s_as_isRenderThread = true;
 }
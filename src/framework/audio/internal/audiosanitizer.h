@@ -35,6 +35,10 @@ public:
     static void setupWorkerThread();
     static std::thread::id workerThread();
     static bool isWorkerThread();
+
+    //! render threads work for the worker while it waits for them,
+    //! so they count as worker thread
+    static void setupRenderThread();
 };
 }
 
@@ -0,0 +1,138 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2021 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include "audiosemaphore.h"
+
+#include <QtGlobal>
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#elif defined(Q_OS_MAC)
+#include <dispatch/dispatch.h>
+#else
+#include <cerrno>
+#include <ctime>
+#include <semaphore.h>
+#endif
+
+using namespace mu::audio;
+
+AudioSemaphore::AudioSemaphore(int count)
+    : m_count(count)
+{
+#if defined(Q_OS_WIN)
+    m_handle = CreateSemaphoreW(nullptr, 0, MAXLONG, nullptr);
+#elif defined(Q_OS_MAC)
+    m_handle = dispatch_semaphore_create(0);
+#else
+    sem_t* sem = new sem_t;
+    sem_init(sem, 0, 0);
+    m_handle = sem;
+#endif
+}
+
+AudioSemaphore::~AudioSemaphore()
+{
+#if defined(Q_OS_WIN)
+    CloseHandle(static_cast<HANDLE>(m_handle));
+#elif defined(Q_OS_MAC)
+    dispatch_release(static_cast<dispatch_semaphore_t>(m_handle));
+#else
+    sem_t* sem = static_cast<sem_t*>(m_handle);
+    sem_destroy(sem);
+    delete sem;
+#endif
+}
+
+void AudioSemaphore::release()
+{
+    if (m_count.fetch_add(1, std::memory_order_release) < 0) {
+        systemPost();
+    }
+}
+
+void AudioSemaphore::acquire()
+{
+    if (m_count.fetch_sub(1, std::memory_order_acquire) > 0) {
+        return;
+    }
+    systemWait(std::chrono::microseconds(-1));
+}
+
+bool AudioSemaphore::tryAcquireFor(std::chrono::microseconds timeout)
+{
+    if (m_count.fetch_sub(1, std::memory_order_acquire) > 0) {
+        return true;
+    }
+
+    if (systemWait(timeout)) {
+        return true;
+    }
+
+    //! NOTE Timed out, stop waiting unless a release() has already posted for us
+    int count = m_count.load(std::memory_order_relaxed);
+    while (count < 0) {
+        if (m_count.compare_exchange_weak(count, count + 1, std::memory_order_relaxed)) {
+            return false;
+        }
+    }
+
+    systemWait(std::chrono::microseconds(-1));
+    return true;
+}
+
+void AudioSemaphore::systemPost()
+{
+#if defined(Q_OS_WIN)
+    ReleaseSemaphore(static_cast<HANDLE>(m_handle), 1, nullptr);
+#elif defined(Q_OS_MAC)
+    dispatch_semaphore_signal(static_cast<dispatch_semaphore_t>(m_handle));
+#else
+    sem_post(static_cast<sem_t*>(m_handle));
+#endif
+}
+
+bool AudioSemaphore::systemWait(std::chrono::microseconds timeout)
+{
+#if defined(Q_OS_WIN)
+    DWORD msec = timeout.count() < 0 ? INFINITE : static_cast<DWORD>((timeout.count() + 999) / 1000);
+    return WaitForSingleObject(static_cast<HANDLE>(m_handle), msec) == WAIT_OBJECT_0;
+#elif defined(Q_OS_MAC)
+    dispatch_time_t time = timeout.count() < 0 ? DISPATCH_TIME_FOREVER
+                           : dispatch_time(DISPATCH_TIME_NOW, static_cast<int64_t>(timeout.count()) * 1000);
+    return dispatch_semaphore_wait(static_cast<dispatch_semaphore_t>(m_handle), time) == 0;
+#else
+    sem_t* sem = static_cast<sem_t*>(m_handle);
+    if (timeout.count() < 0) {
+        while (sem_wait(sem) != 0 && errno == EINTR) {
+        }
+        return true;
+    }
+
+    timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    long long nsec = deadline.tv_nsec + static_cast<long long>(timeout.count()) * 1000;
+    deadline.tv_sec += static_cast<time_t>(nsec / 1000000000);
+    deadline.tv_nsec = static_cast<long>(nsec % 1000000000);
+
+    int ret = 0;
+    while ((ret = sem_timedwait(sem, &deadline)) != 0 && errno == EINTR) {
+    }
+    return ret == 0;
+#endif
+}
@@ -0,0 +1,54 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2021 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_AUDIO_AUDIOSEMAPHORE_H
+#define MU_AUDIO_AUDIOSEMAPHORE_H
+
+#include <atomic>
+#include <chrono>
+
+namespace mu::audio {
+//! NOTE Counting semaphore for waking threads from the audio threads.
+//! release() never blocks or locks: it is an atomic increment,
+//! and it calls the system only if a thread is waiting.
+class AudioSemaphore
+{
+public:
+    explicit AudioSemaphore(int count = 0);
+    ~AudioSemaphore();
+
+    AudioSemaphore(const AudioSemaphore&) = delete;
+    AudioSemaphore& operator=(const AudioSemaphore&) = delete;
+
+    void release();
+    void acquire();
+
+    //! returns false if the semaphore was not released before the timeout
+    bool tryAcquireFor(std::chrono::microseconds timeout);
+
+private:
+    void systemPost();
+    bool systemWait(std::chrono::microseconds timeout);  // negative timeout waits forever
+
+    //! a negative count is the number of waiting threads
+    std::atomic<int> m_count { 0 };
+    void* m_handle = nullptr;
+};
+}
+
+#endif // MU_AUDIO_AUDIOSEMAPHORE_H
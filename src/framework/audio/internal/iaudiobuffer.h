@@ -19,6 +19,7 @@
 #ifndef MU_AUDIO_IAUDIOBUFFER_H
 #define MU_AUDIO_IAUDIOBUFFER_H
 
+#include <cstdint>
 #include <memory>
 #include "iaudiosource.h"
 
@@ -34,6 +35,9 @@ public:
     virtual void push(const float* source, int sampleCount) = 0;
     virtual void pop(float* dest, unsigned int sampleCount) = 0;
     virtual void setMinSampleLag(unsigned int lag) = 0;
+
+    virtual uint64_t underrunCount() const = 0;
+    virtual uint64_t overrunCount() const = 0;
 };
 
 using IAudioBufferPtr = std::shared_ptr<IAudioBuffer>;
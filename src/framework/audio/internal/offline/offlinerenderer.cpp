@@ -0,0 +1,452 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include "offlinerenderer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <thread>
+
+#include <QFileInfo>
+
+#include "log.h"
+#include "audioerrors.h"
+#include "internal/worker/mixkernel.h"
+#include "internal/synthesizers/fluidsynth/fluidsynth.h"
+#include "internal/synthesizers/zerberus/zerberussynth.h"
+
+using namespace mu;
+using namespace mu::audio;
+using namespace mu::audio::synth;
+using namespace mu::midi;
+
+static constexpr float SILENCE_THRESHOLD = 1e-5f;
+static constexpr tempo_t DEFAULT_TEMPO = 500000; // 120 bpm
+static constexpr uint64_t SF3_INFLATE_RATIO = 6; // compressed samples are inflated on load
+
+OfflineRenderer::SampleTimeline::SampleTimeline(const MidiData& data, unsigned int sampleRate)
+{
+    TempoMap tempoMap = data.tempoMap;
+    if (tempoMap.empty() || tempoMap.begin()->first > 0) {
+        tempoMap.insert({ 0, tempoMap.empty() ? DEFAULT_TEMPO : tempoMap.begin()->second });
+    }
+
+    double sample = 0.0;
+    const Segment* prev = nullptr;
+    for (const auto& it : tempoMap) {
+        if (prev) {
+            sample += (it.first - prev->startTick) * prev->samplesPerTick;
+        }
+
+        Segment s;
+        s.startTick = it.first;
+        s.startSample = sample;
+        s.samplesPerTick = (static_cast<double>(it.second) / 1000000.0) * sampleRate / data.division;
+
+        prev = &m_segments.insert({ it.first, s }).first->second;
+    }
+}
+
+uint64_t OfflineRenderer::SampleTimeline::sample(tick_t tick) const
+{
+    auto it = m_segments.upper_bound(tick);
+    --it;
+
+    const Segment& s = it->second;
+    return static_cast<uint64_t>(std::llround(s.startSample + (tick - s.startTick) * s.samplesPerTick));
+}
+
+framework::ProgressChannel OfflineRenderer::progress() const
+{
+    return m_progress;
+}
+
+ISynthesizerPtr OfflineRenderer::createSynthesizer(const SynthName& name, unsigned int sampleRate) const
+{
+    //! NOTE The registered synthesizers belong to the audio worker,
+    //! here we need our own instances with the same sound fonts
+    ISynthesizerPtr synth;
+    if (name == "Zerberus") {
+        auto zerberus = std::make_shared<ZerberusSynth>();
+        zerberus->setRealtime(false);
+        synth = zerberus;
+    } else if (name == "Fluid") {
+        synth = std::make_shared<FluidSynth>();
+    } else {
+        return nullptr;
+    }
+
+    synth->setSampleRate(sampleRate);
+    synth->init();
+    synth->addSoundFonts(soundFontsProvider()->soundFontPathsForSynth(name));
+
+    if (!synth->isValid()) {
+        LOGW() << "synth " << name << " has no sound fonts";
+        return nullptr;
+    }
+
+    return synth;
+}
+
+Ret OfflineRenderer::createLanes(const MidiData& data, const Spec& spec)
+{
+    releaseLanes();
+
+    std::set<channel_t> channels = data.channels();
+
+    ISynthesizerPtr defaultSynth = synthesizersRegister()->defaultSynthesizer();
+    SynthName defaultName = defaultSynth ? defaultSynth->name() : SynthName("Fluid");
+
+    std::set<SynthName> synthNames;
+    for (channel_t ch : channels) {
+        auto synthIt = data.synthMap.find(ch);
+        synthNames.insert(synthIt != data.synthMap.end() ? synthIt->second : defaultName);
+    }
+
+    size_t laneCount = spec.threads > 0 ? spec.threads : std::thread::hardware_concurrency();
+    laneCount = std::max<size_t>(1, std::min({ laneCount, channels.size(), maxLaneCount(synthNames, spec) }));
+    m_lanes.resize(laneCount);
+
+    size_t laneIdx = 0;
+    for (channel_t ch : channels) {
+        m_channelLanes[ch] = laneIdx;
+        laneIdx = (laneIdx + 1) % laneCount;
+    }
+
+    //! NOTE Synthesizers are created (and sound fonts are loaded) here, in the caller thread,
+    //! Zerberus shares the loaded instruments between its instances and isn't safe to load concurrently
+    for (Lane& lane : m_lanes) {
+        std::map<SynthName, ISynthesizerPtr> created;
+
+        auto synthByName = [this, &lane, &created, &spec](const SynthName& name) -> ISynthesizerPtr {
+            auto it = created.find(name);
+            if (it != created.end()) {
+                return it->second;
+            }
+
+            ISynthesizerPtr synth = createSynthesizer(name, spec.sampleRate);
+            created[name] = synth;
+            if (synth) {
+                lane.synths.push_back({ synth, {} });
+            }
+            return synth;
+        };
+
+        for (const auto& it : m_channelLanes) {
+            channel_t ch = it.first;
+            if (&m_lanes.at(it.second) != &lane) {
+                continue;
+            }
+
+            auto synthIt = data.synthMap.find(ch);
+            ISynthesizerPtr synth = synthIt != data.synthMap.end() ? synthByName(synthIt->second) : nullptr;
+            if (!synth) {
+                synth = synthByName(defaultName);
+            }
+
+            if (!synth) {
+                return make_ret(Err::RenderNoSynthesizer);
+            }
+
+            lane.channelSynths[ch] = synth;
+            for (SynthInstance& inst : lane.synths) {
+                if (inst.synth == synth) {
+                    inst.channels.insert(ch);
+                }
+            }
+        }
+
+        for (const SynthInstance& inst : lane.synths) {
+            inst.synth->setupChannels(data.initEventsForChannels(inst.channels));
+            inst.synth->setIsActive(true);
+        }
+
+        lane.synthBuffer.assign(spec.blockSize * AUDIO_CHANNELS, 0.f);
+    }
+
+    //! NOTE One pool for the whole render, the caller renders a lane too.
+    //! A window takes much longer than waking a thread, so the lanes stay parked between the windows
+    m_lanePool = std::make_unique<RenderPool>(m_lanes.size() - 1);
+
+    LOGI() << "channels: " << channels.size() << ", render lanes: " << m_lanes.size();
+
+    return make_ret(Err::NoError);
+}
+
+size_t OfflineRenderer::maxLaneCount(const std::set<SynthName>& synthNames, const Spec& spec) const
+{
+    //! NOTE Zerberus shares the loaded instruments between its instances,
+    //! the other synthesizers load their own copy of the sound fonts, so every extra lane costs that much memory
+    uint64_t laneBytes = 0;
+    for (const SynthName& name : synthNames) {
+        if (name == "Zerberus") {
+            continue;
+        }
+
+        for (const io::path& path : soundFontsProvider()->soundFontPathsForSynth(name)) {
+            QFileInfo fileInfo(path.toQString());
+            uint64_t bytes = static_cast<uint64_t>(std::max<qint64>(0, fileInfo.size()));
+            if (fileInfo.suffix().toLower() == "sf3") {
+                bytes *= SF3_INFLATE_RATIO;
+            }
+            laneBytes += bytes;
+        }
+    }
+
+    if (laneBytes == 0) {
+        return std::numeric_limits<size_t>::max();
+    }
+
+    uint64_t budget = static_cast<uint64_t>(spec.laneMemoryMb) * 1024 * 1024;
+    return static_cast<size_t>(1 + budget / laneBytes);
+}
+
+void OfflineRenderer::releaseLanes()
+{
+    for (const Lane& lane : m_lanes) {
+        for (const SynthInstance& inst : lane.synths) {
+            inst.synth->allSoundsOff();
+        }
+    }
+
+    m_lanePool.reset();
+    m_lanes.clear();
+    m_channelLanes.clear();
+}
+
+void OfflineRenderer::renderLane(Lane& lane, uint64_t fromSample, uint64_t toSample)
+{
+    const unsigned int maxCount = static_cast<unsigned int>(lane.synthBuffer.size() / AUDIO_CHANNELS);
+
+    auto renderSynths = [&lane, fromSample, maxCount](uint64_t from, uint64_t to) {
+        float* out = lane.buffer.data() + (from - fromSample) * AUDIO_CHANNELS;
+        while (from < to) {
+            unsigned int count = static_cast<unsigned int>(std::min<uint64_t>(to - from, maxCount));
+            for (const SynthInstance& inst : lane.synths) {
+                inst.synth->writeBuf(lane.synthBuffer.data(), count);
+                mixPlanar(out, lane.synthBuffer.data(), 1.f, count * AUDIO_CHANNELS);
+            }
+            out += count * AUDIO_CHANNELS;
+            from += count;
+        }
+    };
+
+    uint64_t pos = fromSample;
+    size_t handled = 0;
+    for (const auto& it : lane.events) {
+        if (it.first >= toSample) {
+            break;
+        }
+
+        uint64_t eventSample = std::max(it.first, pos);
+        renderSynths(pos, eventSample);
+        pos = eventSample;
+
+        auto synthIt = lane.channelSynths.find(it.second.channel());
+        if (synthIt != lane.channelSynths.end()) {
+            synthIt->second->handleEvent(it.second);
+        }
+        ++handled;
+    }
+
+    renderSynths(pos, toSample);
+    lane.events.erase(lane.events.begin(), lane.events.begin() + handled);
+}
+
+void OfflineRenderer::renderWindow(uint64_t fromSample, uint64_t toSample)
+{
+    const size_t size = (toSample - fromSample) * AUDIO_CHANNELS;
+    for (Lane& lane : m_lanes) {
+        lane.buffer.assign(size, 0.f);
+    }
+
+    m_windowFrom = fromSample;
+    m_windowTo = toSample;
+    m_lanePool->run([](void* context, size_t index) {
+        OfflineRenderer* renderer = static_cast<OfflineRenderer*>(context);
+        renderLane(renderer->m_lanes[index], renderer->m_windowFrom, renderer->m_windowTo);
+    }, this, m_lanes.size());
+
+    float* out = m_lanes.front().buffer.data();
+    for (size_t i = 1; i < m_lanes.size(); ++i) {
+        mixPlanar(out, m_lanes[i].buffer.data(), 1.f, size);
+    }
+}
+
+bool OfflineRenderer::renderTo(uint64_t toSample, const BlockReceiver& receiver)
+{
+    while (m_renderedSamples < toSample) {
+        uint64_t windowEnd = std::min(toSample, m_renderedSamples + m_windowSize);
+        renderWindow(m_renderedSamples, windowEnd);
+
+        uint64_t count = windowEnd - m_renderedSamples;
+        m_renderedSamples = windowEnd;
+
+        if (!push(m_lanes.front().buffer.data(), count, receiver)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool OfflineRenderer::push(const float* data, uint64_t sampleCount, const BlockReceiver& receiver)
+{
+    while (sampleCount > 0) {
+        unsigned int count = static_cast<unsigned int>(std::min<uint64_t>(sampleCount, m_blockSize - m_blockFilled));
+        std::copy(data, data + count * AUDIO_CHANNELS, m_block.begin() + m_blockFilled * AUDIO_CHANNELS);
+
+        m_blockFilled += count;
+        data += count * AUDIO_CHANNELS;
+        sampleCount -= count;
+
+        if (m_blockFilled == m_blockSize && !flush(receiver)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool OfflineRenderer::flush(const BlockReceiver& receiver)
+{
+    if (m_blockFilled == 0) {
+        return true;
+    }
+
+    const float* data = m_block.data();
+    size_t size = m_blockFilled * AUDIO_CHANNELS;
+
+    m_lastPeak = 0.f;
+    for (size_t i = 0; i < size; ++i) {
+        m_lastPeak = std::max(m_lastPeak, std::fabs(data[i]));
+    }
+
+    bool ok = receiver(data, m_blockFilled);
+    m_blockFilled = 0;
+
+    return ok;
+}
+
+bool OfflineRenderer::renderTail(const BlockReceiver& receiver, const Spec& spec)
+{
+    //! NOTE Let the release and reverb ring out, stop at the first silent block
+    uint64_t maxTail = static_cast<uint64_t>(spec.maxTailMsec) * spec.sampleRate / 1000;
+    uint64_t tailEnd = m_renderedSamples + maxTail;
+
+    if (!flush(receiver)) {
+        return false;
+    }
+
+    while (m_renderedSamples < tailEnd) {
+        uint64_t n = std::min<uint64_t>(m_blockSize, tailEnd - m_renderedSamples);
+        if (!renderTo(m_renderedSamples + n, receiver) || !flush(receiver)) {
+            return false;
+        }
+
+        if (m_lastPeak < SILENCE_THRESHOLD) {
+            break;
+        }
+    }
+
+    return true;
+}
+
+Ret OfflineRenderer::render(const Source& source, const BlockReceiver& receiver, const Spec& spec)
+{
+    TRACEFUNC;
+
+    IF_ASSERT_FAILED(spec.sampleRate > 0 && spec.blockSize > 0) {
+        return make_ret(Err::EngineInvalidParameter);
+    }
+
+    IF_ASSERT_FAILED(receiver) {
+        return make_ret(Err::EngineInvalidParameter);
+    }
+
+    Ret ret = createLanes(source.initData, spec);
+    if (!ret) {
+        releaseLanes();
+        return ret;
+    }
+
+    //! NOTE The lanes are synchronized once per window, a second of audio keeps that cheap
+    m_blockSize = spec.blockSize;
+    m_windowSize = std::max(spec.blockSize, spec.sampleRate);
+    m_blockFilled = 0;
+    m_renderedSamples = 0;
+    m_lastPeak = 0.f;
+    m_block.assign(m_blockSize * AUDIO_CHANNELS, 0.f);
+
+    SampleTimeline timeline(source.initData, spec.sampleRate);
+
+    auto chunkAt = [&source](tick_t tick) -> Chunk {
+        auto it = source.initData.chunks.find(tick);
+        if (it != source.initData.chunks.end()) {
+            return it->second;
+        }
+        return source.chunkRequest ? source.chunkRequest(tick) : Chunk();
+    };
+
+    bool aborted = false;
+    tick_t tick = 0;
+    while (!aborted && tick < source.lastTick) {
+        Chunk chunk = chunkAt(tick);
+        if (chunk.endTick <= tick) {
+            break;
+        }
+
+        for (const auto& it : chunk.events) {
+            const Event& event = it.second;
+            if (!event) {
+                continue;
+            }
+
+            auto laneIt = m_channelLanes.find(event.channel());
+            if (laneIt == m_channelLanes.end()) {
+                continue;
+            }
+
+            //! NOTE Events are queued per lane and rendered a window at a time
+            uint64_t sample = timeline.sample(it.first);
+            if (sample >= m_renderedSamples + m_windowSize && !renderTo(sample, receiver)) {
+                aborted = true;
+                break;
+            }
+
+            m_lanes[laneIt->second].events.push_back({ sample, event });
+        }
+
+        tick = chunk.endTick;
+        m_progress.send(framework::Progress(std::min(tick, source.lastTick), source.lastTick));
+    }
+
+    if (!aborted) {
+        aborted = !renderTo(timeline.sample(source.lastTick), receiver) || !renderTail(receiver, spec);
+    }
+
+    releaseLanes();
+
+    if (aborted) {
+        return make_ret(Err::RenderAborted);
+    }
+
+    LOGI() << "rendered " << m_renderedSamples << " samples";
+    return make_ret(Err::NoError);
+}
@@ -0,0 +1,109 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_AUDIO_OFFLINERENDERER_H
+#define MU_AUDIO_OFFLINERENDERER_H
+
+#include <map>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "../../iofflinerenderer.h"
+#include "modularity/ioc.h"
+#include "isynthesizer.h"
+#include "isynthesizersregister.h"
+#include "isoundfontsprovider.h"
+#include "internal/worker/renderpool.h"
+
+namespace mu::audio {
+class OfflineRenderer : public IOfflineRenderer
+{
+    INJECT(audio, synth::ISynthesizersRegister, synthesizersRegister)
+    INJECT(audio, synth::ISoundFontsProvider, soundFontsProvider)
+
+public:
+    Ret render(const Source& source, const BlockReceiver& receiver, const Spec& spec) override;
+    framework::ProgressChannel progress() const override;
+
+private:
+    //! NOTE Maps ticks to sample positions with the tempo map of the data
+    class SampleTimeline
+    {
+    public:
+        SampleTimeline(const midi::MidiData& data, unsigned int sampleRate);
+        uint64_t sample(midi::tick_t tick) const;
+
+    private:
+        struct Segment {
+            midi::tick_t startTick = 0;
+            double startSample = 0.0;
+            double samplesPerTick = 0.0;
+        };
+        std::map<midi::tick_t, Segment> m_segments;
+    };
+
+    struct SynthInstance {
+        synth::ISynthesizerPtr synth;
+        std::set<midi::channel_t> channels;
+    };
+
+    //! NOTE A lane renders a subset of the midi channels with its own synthesizer instances.
+    //! Lanes don't share any state, so they render the same window in parallel on the lane pool,
+    //! their outputs are summed afterwards. Every synthesizer keeps its state (voices, controllers,
+    //! reverb) from one window to the next, so there are no seams between the windows.
+    struct Lane {
+        std::vector<SynthInstance> synths;
+        std::map<midi::channel_t, synth::ISynthesizerPtr> channelSynths;
+        std::vector<std::pair<uint64_t, midi::Event> > events;   //! events of the current window
+        std::vector<float> buffer;                              //! output of the current window
+        std::vector<float> synthBuffer;
+    };
+
+    Ret createLanes(const midi::MidiData& data, const Spec& spec);
+    size_t maxLaneCount(const std::set<synth::SynthName>& synthNames, const Spec& spec) const;
+    synth::ISynthesizerPtr createSynthesizer(const synth::SynthName& name, unsigned int sampleRate) const;
+    void releaseLanes();
+
+    void renderWindow(uint64_t fromSample, uint64_t toSample);
+    static void renderLane(Lane& lane, uint64_t fromSample, uint64_t toSample);
+
+    //! render all synthesizers up to toSample, pass full blocks to the receiver
+    bool renderTo(uint64_t toSample, const BlockReceiver& receiver);
+    bool push(const float* data, uint64_t sampleCount, const BlockReceiver& receiver);
+    bool flush(const BlockReceiver& receiver);
+    bool renderTail(const BlockReceiver& receiver, const Spec& spec);
+
+    std::vector<Lane> m_lanes;
+    std::unique_ptr<RenderPool> m_lanePool;
+    uint64_t m_windowFrom = 0;
+    uint64_t m_windowTo = 0;
+    std::map<midi::channel_t, size_t> m_channelLanes;
+
+    std::vector<float> m_block;
+    unsigned int m_blockSize = 0;
+    unsigned int m_blockFilled = 0;
+    uint64_t m_renderedSamples = 0;
+    uint64_t m_windowSize = 0;
+    float m_lastPeak = 0.f;
+
+    framework::ProgressChannel m_progress;
+};
+}
+
+#endif // MU_AUDIO_OFFLINERENDERER_H
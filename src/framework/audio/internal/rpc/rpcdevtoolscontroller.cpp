@@ -132,4 +132,14 @@ void RpcDevToolsController::doBind()
             }
         }
     });
+
+    // Render profile
+
+    bindMethod("requestRenderProfile", [this](const Args&) {
+        sendToMain(Msg(target(), "renderProfile", Args::make_arg1<RenderProfile>(audioEngine()->renderProfile())));
+    });
+
+    bindMethod("resetRenderProfile", [this](const Args&) {
+        audioEngine()->resetRenderProfile();
+    });
 }
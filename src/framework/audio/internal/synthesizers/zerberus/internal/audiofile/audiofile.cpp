@@ -12,6 +12,7 @@
 
 #include "audiofile.h"
 
+#include <algorithm>
 #include <vector>
 #include <math.h>
 #include <climits>
@@ -80,6 +81,37 @@ bool AudioFile::open(const QByteArray& b)
     return sf != 0;
 }
 
+//---------------------------------------------------------
+//   openFile
+//    read the file on demand, for streaming
+//---------------------------------------------------------
+
+bool AudioFile::openFile(const QString& path)
+{
+    file.reset(new QFile(path));
+    if (!file->open(QIODevice::ReadOnly)) {
+        file.reset();
+        return false;
+    }
+    idx = 0;
+    sf  = sf_open_virtual(&sfio, SFM_READ, &info, this);
+    if (!sf) {
+        return false;
+    }
+    hasInstrument = sf_command(sf, SFC_GET_INSTRUMENT, &inst, sizeof(inst)) == SF_TRUE;
+    _type = info.format & SF_FORMAT_OGG ? fltp : s16p;
+    return true;
+}
+
+//---------------------------------------------------------
+//   seekFrame
+//---------------------------------------------------------
+
+sf_count_t AudioFile::seekFrame(sf_count_t frame)
+{
+    return sf_seek(sf, frame, SEEK_SET);
+}
+
 //---------------------------------------------------------
 //   error
 //---------------------------------------------------------
@@ -141,9 +173,12 @@ sf_count_t AudioFile::seek(sf_count_t offset, int whence)
         idx += offset;
         break;
     case SEEK_END:
-        idx = buf.size() + offset;
+        idx = getFileLen() + offset;
         break;
     }
+    if (file) {
+        file->seek(idx);
+    }
     return idx;
 }
 
@@ -153,6 +188,13 @@ sf_count_t AudioFile::seek(sf_count_t offset, int whence)
 
 sf_count_t AudioFile::read(void* ptr, sf_count_t count)
 {
+    if (file) {
+        count = file->read(static_cast<char*>(ptr), count);
+        if (count > 0) {
+            idx += count;
+        }
+        return std::max(count, sf_count_t(0));
+    }
     count = qMin(count, (sf_count_t)(buf.size() - idx));
     memcpy(ptr, buf.data() + idx, count);
     idx += count;
@@ -13,7 +13,10 @@
 #ifndef __AUDIOFILE_H__
 #define __AUDIOFILE_H__
 
+#include <memory>
+
 #include <QByteArray>
+#include <QFile>
 
 #include <sndfile.h>
 
@@ -33,7 +36,8 @@ class AudioFile
     SF_INSTRUMENT inst;
     bool hasInstrument { false };
     QByteArray buf;    // used during read of Sample
-    int idx { 0 };
+    std::unique_ptr<QFile> file;      // read on demand instead of buf
+    sf_count_t idx { 0 };
     FormatType _type { fltp };
 
 public:
@@ -41,14 +45,16 @@ public:
     ~AudioFile();
 
     bool open(const QByteArray&);
+    bool openFile(const QString& path);
     const char* error() const;
     sf_count_t readData(short* data, sf_count_t frames);
+    sf_count_t seekFrame(sf_count_t frame);
 
     int channels() const { return info.channels; }
     sf_count_t frames() const { return info.frames; }
     int samplerate() const { return info.samplerate; }
 
-    sf_count_t getFileLen() const { return buf.size(); }
+    sf_count_t getFileLen() const { return file ? file->size() : buf.size(); }
     sf_count_t tell() const { return idx; }
     sf_count_t read(void* ptr, sf_count_t count);
     sf_count_t write(const void* ptr, sf_count_t count);
@@ -56,6 +62,8 @@ public:
     unsigned int loopStart(int v = 0) { return hasInstrument ? inst.loops[v].start : -1; }
     unsigned int loopEnd(int v = 0) { return hasInstrument ? inst.loops[v].end : -1; }
     int loopMode(int v = 0) { return hasInstrument ? inst.loops[v].mode : -1; }
+    bool hasLoop() const { return hasInstrument && inst.loop_count > 0; }
+    bool isFloat() const { return _type == fltp; }
 };
 
 #endif
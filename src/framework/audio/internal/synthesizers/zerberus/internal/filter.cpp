@@ -22,6 +22,11 @@
 
 #include <functional>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MU_ZERBERUS_SSE
+#include <xmmintrin.h>
+#endif
+
 #include "zerberus.h"
 #include "zone.h"
 
@@ -195,105 +200,102 @@ void ZFilter::update()
 }
 
 //---------------------------------------------------------
-//   apply
+//   interpolateBlock
 //---------------------------------------------------------
 
-float ZFilter::apply(float inputValue, bool leftChannel)
+void ZFilter::interpolateBlock(float* out, const unsigned* phases, const float* const taps[4], int count)
 {
-    float value = 0.f;
-    const auto applyBqEquation = [this, &inputValue](float& histX1, float& histX2, float& histY1, float& histY2) {
-        //apply filter
-        /*
-                                   float y = d.b0 * x + d.b1 * d.x1 + d.b2 * d.x2 +
-                                             d.a1 * d.y1 + d.a2 * d.y2;
-                                   d.x2 = d.x1;
-                                   d.x1 = x;
-                                   d.y2 = d.y1;
-                                   d.y1 = y;
-                                   return y;
-                              */
-        float value = b0 * inputValue + b1 * histX1 + b2 * histX2 + a1 * histY1 + a2
-                      * histY2;
-        histX2 = histX1;
-        histX1 = inputValue;
-        histY2 = histY1;
-        histY1 = value;
-        return value;
-    };
-    const auto applyHPF1PEquation = [this, &inputValue](float& histX1, float& histY1) {
-        float value = b0 * inputValue + b1 * histX1 - a1 * histY1;
-        histX1 = inputValue;
-        histY1 = value;
-        return value;
-    };
-    const auto applyLPF1PEquation = [this, &inputValue](float& histY1) {
-        float value = b0 * inputValue - a1 * histY1;
-        histY1 = value;
-        return value;
-    };
-    if (leftChannel) {
-        switch (sampleZone->fil_type) {
-        case FilterType::hpf_2p:
-        case FilterType::lpf_2p:
-        case FilterType::bpf_2p:
-        case FilterType::brf_2p: {
-            value = applyBqEquation(monoL.histX1, monoL.histX2, monoL.histY1, monoL.histY2);
-            break;
-        }
-        case FilterType::hpf_1p: {
-            value = applyHPF1PEquation(monoL.histX1, monoL.histY1);
-            break;
-        }
-        case FilterType::lpf_1p: {
-            value = applyLPF1PEquation(monoL.histY1);
-            break;
-        }
-        default:
-            qWarning() << "this equation is not implemented" << (int)sampleZone->fil_type;
-        }
-    } else { //right channel in stereo samples
-        switch (sampleZone->fil_type) {
-        case FilterType::hpf_2p:
-        case FilterType::lpf_2p:
-        case FilterType::bpf_2p:
-        case FilterType::brf_2p: {
-            value = applyBqEquation(monoR.histX1, monoR.histX2, monoR.histY1, monoR.histY2);
-            break;
-        }
-        case FilterType::hpf_1p: {
-            value = applyHPF1PEquation(monoR.histX1, monoR.histY1);
-            break;
-        }
-        case FilterType::lpf_1p: {
-            value = applyLPF1PEquation(monoR.histY1);
-            break;
-        }
-        default:
-            qWarning() << "this equation is not implemented" << (int)sampleZone->fil_type;
-        }
-    }
+    int i = 0;
 
-    if (filter_coeff_incr_count) {
-        --filter_coeff_incr_count;
-        a1 += a1_incr;
-        a2 += a2_incr;
-        b0 += b0_incr;
-        b1 += b1_incr;
-        b2 += b2_incr;
+#if defined(MU_ZERBERUS_SSE)
+    for (; i + 4 <= count; i += 4) {
+        // a row of the table holds the four coefficients of one frame,
+        // transposed a row holds one coefficient of four frames
+        __m128 c0 = _mm_loadu_ps(interpCoeff[phases[i]]);
+        __m128 c1 = _mm_loadu_ps(interpCoeff[phases[i + 1]]);
+        __m128 c2 = _mm_loadu_ps(interpCoeff[phases[i + 2]]);
+        __m128 c3 = _mm_loadu_ps(interpCoeff[phases[i + 3]]);
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+        __m128 v = _mm_mul_ps(c0, _mm_loadu_ps(taps[0] + i));
+        v = _mm_add_ps(v, _mm_mul_ps(c1, _mm_loadu_ps(taps[1] + i)));
+        v = _mm_add_ps(v, _mm_mul_ps(c2, _mm_loadu_ps(taps[2] + i)));
+        v = _mm_add_ps(v, _mm_mul_ps(c3, _mm_loadu_ps(taps[3] + i)));
+        _mm_storeu_ps(out + i, v);
     }
+#endif
 
-    return value;
+    for (; i < count; ++i) {
+        const auto& interpValTable = interpCoeff[phases[i]];
+        out[i] = interpValTable[0] * taps[0][i]
+                 + interpValTable[1] * taps[1][i]
+                 + interpValTable[2] * taps[2][i]
+                 + interpValTable[3] * taps[3][i];
+    }
 }
 
 //---------------------------------------------------------
-//   interpolate
+//   applyBlock
+//    the filter is recursive, so frames are processed one
+//    after another, but with the filter type resolved once
 //---------------------------------------------------------
 
-float ZFilter::interpolate(unsigned phase, short prevVal, short currVal, short nextVal, short nextNextVal) const
+template<typename Equation>
+void ZFilter::applyBlock(float* left, float* right, int count, Equation equation)
 {
-    const auto& interpValTable = interpCoeff[phase];
-    return interpValTable[0] * prevVal
-           + interpValTable[1] * currVal
-           + interpValTable[2] * nextVal
-           + interpValTable[3] * nextNextVal;
+    const auto stepCoefficients = [this]() {
+        if (filter_coeff_incr_count) {
+            --filter_coeff_incr_count;
+            a1 += a1_incr;
+            a2 += a2_incr;
+            b0 += b0_incr;
+            b1 += b1_incr;
+            b2 += b2_incr;
+        }
+    };
+
+    for (int i = 0; i < count; ++i) {
+        left[i] = equation(left[i], monoL);
+        stepCoefficients();
+        if (right) {
+            right[i] = equation(right[i], monoR);
+            stepCoefficients();
+        }
+    }
+}
+
+void ZFilter::applyBlock(float* left, float* right, int count)
+{
+    switch (sampleZone->fil_type) {
+    case FilterType::hpf_2p:
+    case FilterType::lpf_2p:
+    case FilterType::bpf_2p:
+    case FilterType::brf_2p:
+        applyBlock(left, right, count, [this](float inputValue, FilterData& d) {
+            float value = b0 * inputValue + b1 * d.histX1 + b2 * d.histX2 + a1 * d.histY1 + a2 * d.histY2;
+            d.histX2 = d.histX1;
+            d.histX1 = inputValue;
+            d.histY2 = d.histY1;
+            d.histY1 = value;
+            return value;
+        });
+        break;
+    case FilterType::hpf_1p:
+        applyBlock(left, right, count, [this](float inputValue, FilterData& d) {
+            float value = b0 * inputValue + b1 * d.histX1 - a1 * d.histY1;
+            d.histX1 = inputValue;
+            d.histY1 = value;
+            return value;
+        });
+        break;
+    case FilterType::lpf_1p:
+        applyBlock(left, right, count, [this](float inputValue, FilterData& d) {
+            float value = b0 * inputValue - a1 * d.histY1;
+            d.histY1 = value;
+            return value;
+        });
+        break;
+    default:
+        qWarning() << "this equation is not implemented" << (int)sampleZone->fil_type;
+    }
 }
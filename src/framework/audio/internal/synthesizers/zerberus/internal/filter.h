@@ -30,8 +30,11 @@ public:
     void initialize(const Zerberus* zerberus, const Zone* z, int velocity);
 
     void update();
-    float apply(float inputValue, bool leftChannel);
-    float interpolate(unsigned phase, short prevVal, short currVal, short nextVal, short nextNextVal) const;   //pure function
+
+    //! filters both channels of a stereo sample frame by frame, right is nullptr for mono
+    void applyBlock(float* left, float* right, int count);
+    //! out[i] = interpolation of taps[0..3][i] at phases[i]
+    static void interpolateBlock(float* out, const unsigned* phases, const float* const taps[4], int count);
 
 private:
     const Zerberus* zerberus;
@@ -58,6 +61,9 @@ private:
     FilterData monoL;
     FilterData monoR;
 
+    template<typename Equation>
+    void applyBlock(float* left, float* right, int count, Equation equation);
+
     // normalized filter coefficients (bX = bX/a0 and aX = aX/a0)
     // see Robert Bristow-Johnson's 'Cookbook formulae for audio EQ biquad filter coefficients'
     float b0 = 0.f;                // b0 / a0
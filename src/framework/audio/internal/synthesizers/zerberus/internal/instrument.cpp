@@ -23,6 +23,7 @@
 #include "instrument.h"
 #include "zone.h"
 #include "sample.h"
+#include "samplestream.h"
 
 #include "framework/global/xmlreader.h"
 
@@ -45,8 +46,14 @@ Sample::~Sample()
 //   readSample
 //---------------------------------------------------------
 
-Sample* ZInstrument::readSample(const QString& s, MQZipReader* uz)
+Sample* ZInstrument::readSample(const QString& s, MQZipReader* uz, bool streamable)
 {
+    if (streamable && !uz) {
+        if (Sample* sa = readStreamedSample(s)) {
+            return sa;
+        }
+    }
+
     if (uz) {
         QVector<MQZipReader::FileInfo> fi = uz->fileInfoList();
 
@@ -93,6 +100,65 @@ Sample* ZInstrument::readSample(const QString& s, MQZipReader* uz)
     return sa;
 }
 
+//---------------------------------------------------------
+//   readStreamedSample
+//    read only the beginning of long samples, the rest is
+//    streamed by the SampleStreamer while playing
+//    returns nullptr if the sample cannot be streamed
+//---------------------------------------------------------
+
+Sample* ZInstrument::readStreamedSample(const QString& s)
+{
+    AudioFile a;
+    if (!a.openFile(s)) {
+        return nullptr;
+    }
+
+    //! NOTE Looping samples jump back to data which may not be resident any more,
+    //! ogg samples are normalized over the whole block read
+    if (a.hasLoop() || a.isFloat() || a.channels() > SampleStream::MAX_CHANNELS) {
+        return nullptr;
+    }
+
+    int channel = a.channels();
+    sf_count_t frames = a.frames();
+    int sr = a.samplerate();
+    sf_count_t resident = sf_count_t(sr) * STREAM_RESIDENT_MSEC / 1000;
+    if (resident < 3 || frames <= resident * 2) {
+        return nullptr;
+    }
+
+    short* data = new short[(resident + 3) * channel];
+    if (resident != a.readData(data + channel, resident)) {
+        qDebug("Sample read failed: %s\n", a.error());
+        delete[] data;
+        return nullptr;
+    }
+    for (int i = 0; i < channel; ++i) {
+        data[i]                              = data[channel + i];
+        data[(resident + 1) * channel + i] = data[resident * channel + i];
+        data[(resident + 2) * channel + i] = data[resident * channel + i];
+    }
+
+    Sample* sa = new Sample(channel, data, frames, sr);
+    sa->setStreamed(s, resident);
+    return sa;
+}
+
+//---------------------------------------------------------
+//   hasStreamedSamples
+//---------------------------------------------------------
+
+bool ZInstrument::hasStreamedSamples() const
+{
+    for (const Zone* z : _zones) {
+        if (z->sample && z->sample->isStreamed()) {
+            return true;
+        }
+    }
+    return false;
+}
+
 //---------------------------------------------------------
 //   ZInstrument
 //---------------------------------------------------------
@@ -128,14 +194,17 @@ bool ZInstrument::load(const QString& path)
     instrumentPath = path;
     QFileInfo fi(path);
     _name = fi.completeBaseName();
+    bool ok = false;
     if (fi.isFile()) {
-        return loadFromFile(path);
-    }
-    if (fi.isDir()) {
-        return loadFromDir(path);
+        ok = loadFromFile(path);
+    } else if (fi.isDir()) {
+        ok = loadFromDir(path);
+    } else {
+        qDebug("not file nor dir %s", qPrintable(path));
+        return false;
     }
-    qDebug("not file nor dir %s", qPrintable(path));
-    return false;
+    _zoneIndex.build(_zones);
+    return ok;
 }
 
 //---------------------------------------------------------
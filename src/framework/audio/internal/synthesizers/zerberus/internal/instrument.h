@@ -16,6 +16,8 @@
 #include <list>
 #include <QString>
 
+#include "zoneindex.h"
+
 class MQZipReader;
 
 namespace mu::zerberus {
@@ -36,12 +38,14 @@ class ZInstrument
     int _program;
     QString instrumentPath;
     std::list<Zone*> _zones;
+    ZoneIndex _zoneIndex;
     int _setcc[128];
 
     bool loadFromFile(const QString&);
     bool loadSfz(const QString&);
     bool loadFromDir(const QString&);
     bool read(const QByteArray&, MQZipReader*, const QString& path);
+    Sample* readStreamedSample(const QString& path);
 
 public:
     ZInstrument(Zerberus*);
@@ -55,8 +59,10 @@ public:
     QString path() const { return instrumentPath; }
     const std::list<Zone*>& zones() const { return _zones; }
     std::list<Zone*>& zones() { return _zones; }
-    Sample* readSample(const QString& s, MQZipReader* uz);
+    Sample* readSample(const QString& s, MQZipReader* uz, bool streamable = false);
+    bool hasStreamedSamples() const;
     void addZone(Zone* z) { _zones.push_back(z); }
+    const ZoneIndex& zoneIndex() const { return _zoneIndex; }
     void addRegion(SfzRegion&);
     int getSetCC(int v) { return _setcc[v]; }
 
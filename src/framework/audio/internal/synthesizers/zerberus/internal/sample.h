@@ -30,9 +30,12 @@ class Sample
     long long _loopEnd   { 0 };
     int _loopMode     { 0 };
 
+    QString _path;                  // set if only the beginning is resident
+    long long _residentFrames { 0 };
+
 public:
-    Sample(int ch, short* val, int f, int sr)
-        : _channel(ch), _data(val), _frames(f), _sampleRate(sr) {}
+    Sample(int ch, short* val, long long f, int sr)
+        : _channel(ch), _data(val), _frames(f), _sampleRate(sr), _residentFrames(f) {}
     ~Sample();
     bool read(const QString&);
     long long frames() const { return _frames; }
@@ -46,6 +49,12 @@ public:
     long long loopStart() { return _loopStart; }
     long long loopEnd() { return _loopEnd; }
     int loopMode() { return _loopMode; }
+
+    //! the frames after residentFrames() are streamed from path() while playing
+    void setStreamed(const QString& path, long long residentFrames) { _path = path; _residentFrames = residentFrames; }
+    bool isStreamed() const { return _residentFrames < _frames; }
+    long long residentFrames() const { return _residentFrames; }
+    const QString& path() const { return _path; }
 };
 }
 
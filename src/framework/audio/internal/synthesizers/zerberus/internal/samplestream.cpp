@@ -0,0 +1,285 @@
+//=============================================================================
+//  Zerberus
+//  Zample player
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+#include "samplestream.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#include "audiofile/audiofile.h"
+#include "sample.h"
+
+using namespace mu::zerberus;
+
+//---------------------------------------------------------
+//   SampleStream
+//---------------------------------------------------------
+
+SampleStream::SampleStream()
+    : _buffer(CAPACITY * MAX_CHANNELS)
+{
+}
+
+SampleStream::~SampleStream() = default;
+
+//---------------------------------------------------------
+//   ~SampleStreamer
+//---------------------------------------------------------
+
+SampleStreamer::~SampleStreamer()
+{
+    stop();
+}
+
+//---------------------------------------------------------
+//   start
+//    called when an instrument with streamed samples is
+//    loaded, not from the audio thread
+//---------------------------------------------------------
+
+void SampleStreamer::start(int streams)
+{
+    if (_running) {
+        return;
+    }
+
+    //! NOTE A stream for every voice, so a voice never finds them all in use
+    while (int(_streams.size()) < streams) {
+        _streams.push_back(std::unique_ptr<SampleStream>(new SampleStream()));
+    }
+
+    _running = true;
+    _thread = std::thread([this]() { run(); });
+}
+
+//---------------------------------------------------------
+//   stop
+//---------------------------------------------------------
+
+void SampleStreamer::stop()
+{
+    if (!_running) {
+        return;
+    }
+
+    _running = false;
+    wake();
+    _thread.join();
+    reportUnderruns();
+
+    for (auto& stream : _streams) {
+        stream->_file.reset();
+        stream->_sample = nullptr;
+        stream->_state = SampleStream::State::FREE;
+    }
+}
+
+//---------------------------------------------------------
+//   acquire
+//    returns nullptr if the sample cannot be streamed
+//    or all streams are in use
+//---------------------------------------------------------
+
+SampleStream* SampleStreamer::acquire(const Sample* sample, long long startFrame)
+{
+    if (!_running || sample->channel() > SampleStream::MAX_CHANNELS) {
+        return nullptr;
+    }
+
+    for (auto& s : _streams) {
+        SampleStream::State state = SampleStream::State::FREE;
+        if (!s->_state.compare_exchange_strong(state, SampleStream::State::ACQUIRING, std::memory_order_acquire)) {
+            continue;
+        }
+
+        s->_sample = sample;
+        s->_channels = sample->channel();
+        s->_frames = sample->frames();
+        s->_startFrame = startFrame;
+        s->_readFrame.store(startFrame, std::memory_order_relaxed);
+        s->_writeFrame.store(startFrame, std::memory_order_relaxed);
+        s->_failed.store(false, std::memory_order_relaxed);
+        s->_state.store(SampleStream::State::REQUESTED, std::memory_order_release);
+        wake();
+        return s.get();
+    }
+
+    return nullptr;
+}
+
+//---------------------------------------------------------
+//   release
+//---------------------------------------------------------
+
+void SampleStreamer::release(SampleStream* stream)
+{
+    stream->_state.store(SampleStream::State::RELEASED, std::memory_order_release);
+    wake();
+}
+
+//---------------------------------------------------------
+//   setReadFrame
+//    wakes the reader when there is room for a read
+//---------------------------------------------------------
+
+void SampleStreamer::setReadFrame(SampleStream* stream, long long frame)
+{
+    stream->_readFrame.store(frame, std::memory_order_release);
+
+    const long long write = stream->writeFrame();
+    const long long room = std::min(frame + SampleStream::CAPACITY, stream->frames()) - write;
+    if (room > 0 && room >= std::min(READ_FRAMES, stream->frames() - write)) {
+        wake();
+    }
+}
+
+//---------------------------------------------------------
+//   waitFor
+//---------------------------------------------------------
+
+void SampleStreamer::waitFor(const SampleStream* stream, long long frame)
+{
+    //! NOTE The reader keeps at most CAPACITY frames after the read position
+    frame = std::min({ frame, stream->frames(), stream->readFrame() + SampleStream::CAPACITY });
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (_running && stream->writeFrame() < frame && !stream->failed()) {
+        const auto timeout = std::chrono::duration_cast<std::chrono::microseconds>(deadline - std::chrono::steady_clock::now());
+        _waiting.store(true, std::memory_order_release);
+        wake();
+        if (timeout.count() <= 0 || !_written.tryAcquireFor(timeout)) {
+            addUnderrun();
+            return;
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   wake
+//    lock free, only the first wake() after a pass of the
+//    reader releases the semaphore
+//---------------------------------------------------------
+
+void SampleStreamer::wake()
+{
+    if (!_pending.exchange(true, std::memory_order_acq_rel)) {
+        _wakeup.release();
+    }
+}
+
+//---------------------------------------------------------
+//   reportUnderruns
+//    reader thread
+//---------------------------------------------------------
+
+void SampleStreamer::reportUnderruns()
+{
+    const int underruns = _underruns.load(std::memory_order_relaxed);
+    if (underruns != _reportedUnderruns) {
+        qWarning("Zerberus: %d streamed frames were not read in time", underruns - _reportedUnderruns);
+        _reportedUnderruns = underruns;
+    }
+}
+
+//---------------------------------------------------------
+//   run
+//---------------------------------------------------------
+
+void SampleStreamer::run()
+{
+    //! NOTE The underruns are reported at most once a second
+    static const std::chrono::seconds REPORT_INTERVAL(1);
+
+    while (_running) {
+        //! NOTE A wake() from now on makes another pass
+        _pending.store(false, std::memory_order_release);
+
+        bool busy = false;
+        for (auto& s : _streams) {
+            switch (s->_state.load(std::memory_order_acquire)) {
+            case SampleStream::State::REQUESTED: {
+                open(*s);
+                SampleStream::State state = SampleStream::State::REQUESTED;
+                s->_state.compare_exchange_strong(state, SampleStream::State::STREAMING, std::memory_order_acq_rel);
+                busy = true;
+                break;
+            }
+            case SampleStream::State::STREAMING:
+                busy |= fill(*s);
+                break;
+            case SampleStream::State::RELEASED:
+                s->_file.reset();
+                s->_sample = nullptr;
+                s->_state.store(SampleStream::State::FREE, std::memory_order_release);
+                break;
+            default:
+                break;
+            }
+        }
+
+        if (_waiting.exchange(false, std::memory_order_acq_rel)) {
+            _written.release();
+        }
+
+        if (!busy) {
+            _wakeup.tryAcquireFor(REPORT_INTERVAL);
+            reportUnderruns();
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   open
+//---------------------------------------------------------
+
+void SampleStreamer::open(SampleStream& stream)
+{
+    stream._file.reset(new AudioFile());
+    if (!stream._file->openFile(stream._sample->path())
+        || stream._file->seekFrame(stream._startFrame) != stream._startFrame) {
+        qDebug("Zerberus: cannot stream <%s>", qPrintable(stream._sample->path()));
+        stream._file.reset();
+        stream._failed.store(true, std::memory_order_release);
+    }
+}
+
+//---------------------------------------------------------
+//   fill
+//    reads the next frames if there is room for them,
+//    returns false if there was nothing to do
+//---------------------------------------------------------
+
+bool SampleStreamer::fill(SampleStream& stream)
+{
+    if (!stream._file) {
+        return false;
+    }
+
+    const long long write = stream._writeFrame.load(std::memory_order_relaxed);
+    const long long end = std::min(stream.readFrame() + SampleStream::CAPACITY, stream._frames);
+    if (write >= end) {
+        return false;
+    }
+
+    const long long ringPos = write % SampleStream::CAPACITY;
+    const long long count = std::min({ end - write, READ_FRAMES, SampleStream::CAPACITY - ringPos });
+    short* dst = stream._buffer.data() + ringPos * stream._channels;
+
+    long long read = stream._file->readData(dst, count);
+    if (read < count) {
+        read = std::max(read, 0ll);
+        std::memset(dst + read * stream._channels, 0, (count - read) * stream._channels * sizeof(short));
+    }
+
+    stream._writeFrame.store(write + count, std::memory_order_release);
+    return true;
+}
@@ -0,0 +1,138 @@
+//=============================================================================
+//  Zerberus
+//  Zample player
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#ifndef MU_ZERBERUS_SAMPLESTREAM_H
+#define MU_ZERBERUS_SAMPLESTREAM_H
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "internal/audiosemaphore.h"
+
+class AudioFile;
+
+namespace mu::zerberus {
+class Sample;
+
+//! NOTE Long samples keep only their beginning in memory,
+//! the rest is read while the voice plays it
+static const int STREAM_RESIDENT_MSEC = 500;
+
+//---------------------------------------------------------
+//   SampleStream
+//    ring buffer with the frames of a sample ahead of
+//    a playing voice, filled by the SampleStreamer thread
+//---------------------------------------------------------
+
+class SampleStream
+{
+public:
+    static constexpr long long CAPACITY = 1 << 14;     // frames
+    static constexpr int MAX_CHANNELS = 2;
+
+    SampleStream();
+    ~SampleStream();
+
+    //! returns 0 for the frames which are not read yet
+    short value(long long frame, int channel) const
+    {
+        if (frame >= _writeFrame.load(std::memory_order_acquire) || frame < _startFrame) {
+            return 0;
+        }
+        return _buffer[(frame % CAPACITY) * _channels + channel];
+    }
+
+    long long readFrame() const { return _readFrame.load(std::memory_order_relaxed); }
+    long long writeFrame() const { return _writeFrame.load(std::memory_order_acquire); }
+    long long frames() const { return _frames; }
+    bool failed() const { return _failed.load(std::memory_order_acquire); }
+
+private:
+    friend class SampleStreamer;
+
+    enum class State {
+        FREE,
+        ACQUIRING,      // taken by the audio thread
+        REQUESTED,      // the reader has to open the sample
+        STREAMING,
+        RELEASED        // the reader has to close the sample
+    };
+
+    std::atomic<State> _state { State::FREE };
+    const Sample* _sample { nullptr };
+    int _channels { 1 };
+    long long _frames { 0 };
+    long long _startFrame { 0 };
+    std::atomic<long long> _readFrame { 0 };
+    std::atomic<long long> _writeFrame { 0 };
+    std::atomic<bool> _failed { false };
+    std::vector<short> _buffer;
+
+    std::unique_ptr<AudioFile> _file;     // used by the reader only
+};
+
+//---------------------------------------------------------
+//   SampleStreamer
+//    owns the streams of a Zerberus instance and the
+//    thread reading them
+//---------------------------------------------------------
+
+class SampleStreamer
+{
+public:
+    static constexpr long long READ_FRAMES = 4096;       // frames per read
+
+    SampleStreamer() = default;
+    ~SampleStreamer();
+
+    //! streams is the number of voices which may play streamed samples at once
+    void start(int streams);
+    void stop();
+
+    //! audio thread
+    SampleStream* acquire(const Sample* sample, long long startFrame);
+    void release(SampleStream* stream);
+    //! the frames before frame are not needed any more
+    void setReadFrame(SampleStream* stream, long long frame);
+
+    //! blocks until the frames before frame are read, for the offline rendering
+    void waitFor(const SampleStream* stream, long long frame);
+
+    bool isRealtime() const { return _realtime; }
+    void setRealtime(bool arg) { _realtime = arg; }
+
+    int underruns() const { return _underruns.load(std::memory_order_relaxed); }
+    void addUnderrun() { _underruns.fetch_add(1, std::memory_order_relaxed); }
+
+private:
+    void run();
+    void open(SampleStream& stream);
+    bool fill(SampleStream& stream);
+    void wake();
+    void reportUnderruns();
+
+    std::vector<std::unique_ptr<SampleStream> > _streams;
+    std::thread _thread;
+    std::atomic<bool> _running { false };
+    mu::audio::AudioSemaphore _wakeup;         // the reader has something to do
+    std::atomic<bool> _pending { false };
+    mu::audio::AudioSemaphore _written;        // the reader is done with a pass, for waitFor()
+    std::atomic<bool> _waiting { false };
+    std::atomic<int> _underruns { 0 };
+    int _reportedUnderruns { 0 };
+    bool _realtime { true };
+};
+}
+
+#endif //MU_ZERBERUS_SAMPLESTREAM_H
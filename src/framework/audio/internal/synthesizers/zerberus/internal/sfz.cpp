@@ -306,7 +306,10 @@ void ZInstrument::addRegion(SfzRegion& r)
         }
     }
     Zone* z = new Zone;
-    z->sample = readSample(r.sample, 0);
+    //! NOTE Only the samples which are played through once may be streamed
+    bool streamable = (r.loop_mode == LoopMode::NO_LOOP || r.loop_mode == LoopMode::ONE_SHOT)
+                      || (r.loopStart == -1 && r.loopEnd == -1);
+    z->sample = readSample(r.sample, 0, streamable);
     if (z->sample) {
         //qDebug("Sample Loop - start %ll, end %ll, mode %d", z->sample->loopStart(), z->sample->loopEnd(), z->sample->loopMode());
         // if there is no opcode defining loop ranges, use sample definitions as fallback (according to spec)
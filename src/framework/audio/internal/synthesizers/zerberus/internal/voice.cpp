@@ -11,6 +11,8 @@
 //=============================================================================
 
 #include <stdio.h>
+#include <algorithm>
+#include <climits>
 
 #include "voice.h"
 #include "instrument.h"
@@ -18,6 +20,9 @@
 #include "zerberus.h"
 #include "zone.h"
 #include "sample.h"
+#include "samplestream.h"
+
+#include "internal/worker/mixkernel.h"
 
 //#include "midi/msynthesizer.h"
 
@@ -108,6 +113,18 @@ void Voice::start(Channel* c, int key, int v, const Zone* zone, double durSinceN
     _loopEnd   = z->loopEnd;
     _samplesSinceStart = 0;
 
+    releaseStream();
+    if (s->isStreamed()) {
+        _residentEnd = (s->residentFrames() - z->offset) * audioChan;
+        _stream = _zerberus->streamer().acquire(s, std::max(s->residentFrames(), z->offset));
+        if (!_stream) {
+            //! NOTE The voice plays the resident frames only
+            _zerberus->streamer().addUnderrun();
+        }
+    } else {
+        _residentEnd = LLONG_MAX;
+    }
+
     _offMode  = z->offMode;
     _offBy    = z->offBy;
 
@@ -232,77 +249,170 @@ void Voice::updateEnvelopes()
 
 void Voice::process(int frames, float* p)
 {
+    if (_stream && !_zerberus->streamer().isRealtime()) {
+        long long lastFrame = phase.index() + z->offset + ((frames * phaseIncr.data) >> 8) + 4;
+        _zerberus->streamer().waitFor(_stream, lastFrame);
+    }
+
     filter.update();
 
     const float opcodePanLeftGain = 1.f - fmax(0.0f, z->pan / 100.0);   //[0, 1]
     const float opcodePanRightGain = 1.f + fmin(0.0f, z->pan / 100.0);   //[0, 1]
     const float leftChannelVol = gain * z->ccGain * _channel->panLeftGain() * opcodePanLeftGain;
     const float rightChannelVol = gain * z->ccGain * _channel->panRightGain() * opcodePanRightGain;
-    if (audioChan == 1) {
-        while (frames--) {
-            updateLoop();
+    const float monoGains[2] = { leftChannelVol, rightChannelVol };
+    const float stereoGains[4] = { leftChannelVol, 0.f, 0.f, rightChannelVol };
+
+    long long index[VOICE_BLOCK];
+    unsigned fract[VOICE_BLOCK];
+    float env[VOICE_BLOCK];
+    float tapData[2][4][VOICE_BLOCK];
+    float values[2][VOICE_BLOCK];
+    float out[VOICE_BLOCK * 2];
+
+    while (frames > 0) {
+        const int blockFrames = planBlock(std::min(frames, VOICE_BLOCK), index, fract, env);
+        if (!blockFrames) {
+            break;
+        }
 
-            long long idx = phase.index();
+        for (int c = 0; c < audioChan; ++c) {
+            float* const taps[4] = { tapData[c][0], tapData[c][1], tapData[c][2], tapData[c][3] };
+            gatherTaps(blockFrames, index, c, taps);
+            ZFilter::interpolateBlock(values[c], fract, taps, blockFrames);
+        }
+        filter.applyBlock(values[0], audioChan == 2 ? values[1] : nullptr, blockFrames);
 
-            if (idx >= eidx) {
-                off();
-                break;
+        if (audioChan == 1) {
+            for (int i = 0; i < blockFrames; ++i) {
+                out[i] = values[0][i] * env[i];
+            }
+            mu::audio::mixInterleaved(p, 2, out, 1, monoGains, blockFrames);
+        } else {
+            for (int i = 0; i < blockFrames; ++i) {
+                out[2 * i] = values[0][i] * env[i];
+                out[2 * i + 1] = values[1][i] * env[i];
             }
+            mu::audio::mixInterleaved(p, 2, out, 2, stereoGains, blockFrames);
+        }
+
+        p += 2 * blockFrames;
+        frames -= blockFrames;
+        if (isOff()) {
+            break;
+        }
+    }
+
+    if (_stream) {
+        // the interpolation reads one frame back
+        _zerberus->streamer().setReadFrame(_stream, phase.index() + z->offset - 1);
+    }
+}
 
-            float interpVal = filter.interpolate(phase.fract(),
-                                                 getData(idx - 1), getData(idx), getData(idx + 1), getData(idx + 2));
-            float v = filter.apply(interpVal, true);
+//---------------------------------------------------------
+//   isSteady
+//    the envelope keeps its value and there is no loop to
+//    watch, as while a note is held
+//---------------------------------------------------------
+
+bool Voice::isSteady() const
+{
+    if (_state != VoiceState::PLAYING && _state != VoiceState::SUSTAINED) {
+        return false;
+    }
+    bool validLoop = _loopEnd > 0 && _loopStart >= 0 && (_loopEnd <= (eidx / audioChan));
+    return !validLoop || loopMode() == LoopMode::NO_LOOP || loopMode() == LoopMode::ONE_SHOT;
+}
 
-            updateEnvelopes();
-            if (_state == VoiceState::OFF) {
+//---------------------------------------------------------
+//   planBlock
+//    advance the loop, the envelopes and the phase over the
+//    next frames and return the number of frames to render
+//    with their sample indices and envelope values.
+//    The block ends early when the voice goes off or starts
+//    looping, so getData() sees the same _looping for all
+//    frames of a block.
+//---------------------------------------------------------
+
+int Voice::planBlock(int frames, long long* index, unsigned* fract, float* env)
+{
+    int i = 0;
+
+    if (isSteady()) {
+        _looping = false;
+        const float val = envelopes[currentEnvelope].val;
+        for (; i < frames; ++i) {
+            long long idx = phase.index();
+            if (idx * audioChan >= eidx) {
+                off();
                 break;
             }
+            index[i] = idx;
+            fract[i] = phase.fract();
+            env[i] = val;
+            phase += phaseIncr;
+        }
+        _samplesSinceStart += i;
+        return i;
+    }
+
+    for (; i < frames; ++i) {
+        const bool wasLooping = _looping;
+        updateLoop();
+        if (i && _looping != wasLooping) {
+            break;
+        }
 
-            *p++ = v * envelopes[currentEnvelope].val * leftChannelVol;
-            *p++ = v * envelopes[currentEnvelope].val * rightChannelVol;
+        long long idx = phase.index();
+        if (idx * audioChan >= eidx) {
+            off();
+            break;
+        }
 
-            if (V1Envelopes::DELAY != currentEnvelope) {
-                phase += phaseIncr;
-            }
+        updateEnvelopes();
+        if (_state == VoiceState::OFF) {
+            break;
+        }
 
-            _samplesSinceStart++;
+        index[i] = idx;
+        fract[i] = phase.fract();
+        env[i] = envelopes[currentEnvelope].val;
+
+        if (V1Envelopes::DELAY != currentEnvelope) {
+            phase += phaseIncr;
         }
-    } else {
-        //
-        // handle interleaved stereo samples
-        //
-        while (frames--) {
-            updateLoop();
-
-            long long idx = phase.index() * 2;
-            if (idx >= eidx) {
-                off();
 
-                break;
-            }
+        _samplesSinceStart++;
+    }
 
-            float interpValL = filter.interpolate(phase.fract(),
-                                                  getData(idx - 2), getData(idx), getData(idx + 2), getData(idx + 4));
-            float interpValR = filter.interpolate(phase.fract(),
-                                                  getData(idx - 1), getData(idx + 1), getData(idx + 3),
-                                                  getData(idx + 5));
-            float valueL = filter.apply(interpValL, true);
-            float valueR = filter.apply(interpValR, false);
-
-            //apply volume
-            updateEnvelopes();
-            if (_state == VoiceState::OFF) {
-                break;
-            }
+    return i;
+}
 
-            *p++ = valueL * envelopes[currentEnvelope].val * leftChannelVol;
-            *p++ = valueR * envelopes[currentEnvelope].val * rightChannelVol;
+//---------------------------------------------------------
+//   gatherTaps
+//    the four sample values around each frame of a block
+//    for the interpolation
+//---------------------------------------------------------
 
-            if (V1Envelopes::DELAY != currentEnvelope) {
-                phase += phaseIncr;
-            }
+void Voice::gatherTaps(int frames, const long long* index, int channel, float* const taps[4]) const
+{
+    const long long first = (index[0] - 1) * audioChan + channel;
+    const long long last = (index[frames - 1] + 2) * audioChan + channel;
+
+    if (!_looping && first >= 0 && last < _residentEnd) {
+        for (int i = 0; i < frames; ++i) {
+            const short* d = data + (index[i] - 1) * audioChan + channel;
+            taps[0][i] = d[0];
+            taps[1][i] = d[audioChan];
+            taps[2][i] = d[2 * audioChan];
+            taps[3][i] = d[3 * audioChan];
+        }
+        return;
+    }
 
-            _samplesSinceStart++;
+    for (int i = 0; i < frames; ++i) {
+        for (int k = 0; k < 4; ++k) {
+            taps[k][i] = getData((index[i] + k - 1) * audioChan + channel);
         }
     }
 }
@@ -332,14 +442,14 @@ void Voice::updateLoop()
     }
 }
 
-short Voice::getData(long long pos)
+short Voice::getData(long long pos) const
 {
     if (pos < 0 && !_looping) {
         return 0;
     }
 
     if (!_looping) {
-        return data[pos];
+        return pos < _residentEnd ? data[pos] : streamedData(pos);
     }
 
     long long loopEnd = _loopEnd * audioChan;
@@ -354,6 +464,34 @@ short Voice::getData(long long pos)
     }
 }
 
+//---------------------------------------------------------
+//   streamedData
+//---------------------------------------------------------
+
+short Voice::streamedData(long long pos) const
+{
+    if (!_stream) {
+        return 0;
+    }
+    long long frame = pos / audioChan + z->offset;
+    if (frame >= _stream->writeFrame() && frame < _stream->frames()) {
+        _zerberus->streamer().addUnderrun();
+    }
+    return _stream->value(frame, pos % audioChan);
+}
+
+//---------------------------------------------------------
+//   releaseStream
+//---------------------------------------------------------
+
+void Voice::releaseStream()
+{
+    if (_stream) {
+        _zerberus->streamer().release(_stream);
+        _stream = nullptr;
+    }
+}
+
 //---------------------------------------------------------
 //   state
 //---------------------------------------------------------
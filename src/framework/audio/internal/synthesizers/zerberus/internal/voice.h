@@ -26,6 +26,7 @@ namespace mu::zerberus {
 class Channel;
 struct Zone;
 class Sample;
+class SampleStream;
 class Zerberus;
 
 enum class LoopMode : char;
@@ -33,6 +34,7 @@ enum class OffMode : char;
 enum class Trigger : char;
 
 static const int EG_SIZE    = 256;
+static const int VOICE_BLOCK = 64;    // frames Voice::process renders at once
 
 //---------------------------------------------------------
 //   Envelope
@@ -155,6 +157,15 @@ class Voice
 
     const Zone* z;
 
+    SampleStream* _stream { nullptr };
+    long long _residentEnd { 0 };        // data index of the first streamed value
+
+    short streamedData(long long pos) const;
+
+    bool isSteady() const;
+    int planBlock(int frames, long long* index, unsigned* fract, float* env);
+    void gatherTaps(int frames, const long long* index, int channel, float* const taps[4]) const;
+
 public:
     Voice(Zerberus*);
     Voice* next() const { return _next; }
@@ -164,7 +175,8 @@ public:
     void updateEnvelopes();
     void process(int frames, float*);
     void updateLoop();
-    short getData(long long pos);
+    short getData(long long pos) const;
+    void releaseStream();
 
     Channel* channel() const { return _channel; }
     int key() const { return _key; }
@@ -11,6 +11,7 @@
 //=============================================================================
 
 #include <stdio.h>
+#include <algorithm>
 
 #include <QFileInfo>
 
@@ -52,6 +53,7 @@ Zerberus::Zerberus()
 Zerberus::~Zerberus()
 {
     busy = true;
+    _streamer.stop();
     while (!instruments.empty()) {
         auto i  = instruments.front();
         auto it = instruments.begin();
@@ -82,7 +84,7 @@ void Zerberus::trigger(Channel* channel, int key, int velo, Trigger trigger, int
 {
     ZInstrument* i = channel->instrument();
     double random = (double)rand() / (double)RAND_MAX;
-    for (Zone* z : i->zones()) {
+    for (Zone* z : i->zoneIndex().candidates(trigger, key, velo)) {
         if (z->match(channel, key, velo, trigger, random, cc, ccVal)) {
             //
             // handle offBy voices
@@ -213,6 +215,8 @@ void Zerberus::process(unsigned frames, float* p, float*, float*)
     if (busy) {
         return;
     }
+    // the voices are mixed into the buffer
+    std::fill(p, p + frames * 2, 0.f);
     Voice* v = activeVoices;
     Voice* pv = 0;
     while (v) {
@@ -223,6 +227,7 @@ void Zerberus::process(unsigned frames, float* p, float*, float*)
             } else {
                 activeVoices = v->next();
             }
+            v->releaseStream();
             freeVoices.push(v);
         } else {
             pv = v;
@@ -357,6 +362,9 @@ bool Zerberus::loadInstrument(const QString& path)
         if (QFileInfo(instr->path()).fileName() == fileName) {
             instruments.push_back(instr);
             instr->setRefCount(instr->refCount() + 1);
+            if (instr->hasStreamedSamples()) {
+                _streamer.start(MAX_VOICES);
+            }
             if (instruments.size() == 1) {
                 for (int i = 0; i < MAX_CHANNELS; ++i) {
                     _channel[i]->setInstrument(instr);
@@ -372,6 +380,9 @@ bool Zerberus::loadInstrument(const QString& path)
 
     try {
         if (instr->load(path)) {
+            if (instr->hasStreamedSamples()) {
+                _streamer.start(MAX_VOICES);
+            }
             globalInstruments.push_back(instr);
             instruments.push_back(instr);
             instr->setRefCount(1);
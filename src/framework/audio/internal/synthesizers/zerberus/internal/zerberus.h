@@ -21,6 +21,7 @@
 #include <QString>
 
 #include "voice.h"
+#include "samplestream.h"
 
 namespace mu::zerberus {
 class Channel;
@@ -92,6 +93,8 @@ class Zerberus //: public Ms::Synthesizer
 
     float _sampleRate = 0.0f;
 
+    SampleStreamer _streamer;
+
     bool loadInstrument(const QString& path);
 
     void trigger(Channel*, int key, int velo, Trigger, int cc, int ccVal, double durSinceNoteOn);
@@ -105,6 +108,10 @@ public:
     float sampleRate() const { return _sampleRate; }
     void setSampleRate(float sr) { _sampleRate = sr; }
 
+    SampleStreamer& streamer() { return _streamer; }
+    //! NOTE Without realtime the voices wait for the streamed samples instead of dropping them
+    void setRealtime(bool arg) { _streamer.setRealtime(arg); }
+
     bool addSoundFont(const QString& path);
     bool removeSoundFont(const QString& path);
     QStringList soundFonts() const;
@@ -14,6 +14,7 @@
 #define MU_ZERBERUS_ZONE_H
 
 #include <map>
+#include <vector>
 
 namespace mu::zerberus {
 class Sample;
@@ -118,11 +119,13 @@ struct Zone {
     int locc[128];
     int hicc[128];
     bool useCC = false;
+    std::vector<int> ccChecks;    // controllers with a range other than 0-127
 
     Zone();
     ~Zone();
     bool match(Channel*, int key, int velo, Trigger, double rand, int cc, int ccVal);
     void updateCCGain(Channel* c);
+    void updateCCChecks();
 };
 }
 
@@ -0,0 +1,116 @@
+//=============================================================================
+//  Zerberus
+//  Zample player
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+#include "zoneindex.h"
+
+#include <algorithm>
+
+using namespace mu::zerberus;
+
+const std::vector<Zone*> ZoneIndex::_noZones;
+
+//---------------------------------------------------------
+//   clear
+//---------------------------------------------------------
+
+void ZoneIndex::clear()
+{
+    _bands.clear();
+    _ccZones.clear();
+}
+
+//---------------------------------------------------------
+//   build
+//    The zones keep the instrument order in every list,
+//    Zone::match() counts round robins in that order.
+//---------------------------------------------------------
+
+void ZoneIndex::build(const std::list<Zone*>& zones)
+{
+    clear();
+    _bands.resize(KEY_TRIGGERS * KEYS);
+
+    std::vector<std::vector<Zone*> > keyZones(KEY_TRIGGERS * KEYS);
+    for (Zone* z : zones) {
+        z->updateCCChecks();
+
+        if (z->trigger == Trigger::CC) {
+            _ccZones.push_back(z);
+            continue;
+        }
+        const int keyLo = std::max(int(z->keyLo), 0);
+        const int keyHi = std::min(int(z->keyHi), KEYS - 1);
+        for (int key = keyLo; key <= keyHi; ++key) {
+            keyZones[int(z->trigger) * KEYS + key].push_back(z);
+        }
+    }
+
+    std::vector<int> bounds;
+    for (size_t i = 0; i < keyZones.size(); ++i) {
+        const std::vector<Zone*>& kz = keyZones[i];
+        if (kz.empty()) {
+            continue;
+        }
+
+        // velocities at which the matching zones change
+        bounds.clear();
+        bounds.push_back(0);
+        for (const Zone* z : kz) {
+            bounds.push_back(std::max(int(z->veloLo), 0));
+            bounds.push_back(int(z->veloHi) + 1);
+        }
+        std::sort(bounds.begin(), bounds.end());
+        bounds.erase(std::unique(bounds.begin(), bounds.end()), bounds.end());
+
+        KeyBands& kb = _bands[i];
+        for (int velo : bounds) {
+            if (velo >= KEYS) {
+                break;
+            }
+            VelocityBand band;
+            band.veloLo = velo;
+            for (Zone* z : kz) {
+                if (z->veloLo <= velo && velo <= z->veloHi) {
+                    band.zones.push_back(z);
+                }
+            }
+            if (!kb.empty() && kb.back().zones == band.zones) {
+                continue;
+            }
+            kb.push_back(std::move(band));
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   candidates
+//    the zones which may match the note, Zone::match()
+//    still checks the controllers, random and sequence
+//---------------------------------------------------------
+
+const std::vector<Zone*>& ZoneIndex::candidates(Trigger trigger, int key, int velo) const
+{
+    if (trigger == Trigger::CC) {
+        return _ccZones;
+    }
+    if (key < 0 || key >= KEYS || velo < 0 || velo >= KEYS || _bands.empty()) {
+        return _noZones;
+    }
+
+    const KeyBands& kb = _bands[int(trigger) * KEYS + key];
+    auto it = std::upper_bound(kb.begin(), kb.end(), velo, [](int v, const VelocityBand& band) {
+        return v < band.veloLo;
+    });
+    if (it == kb.begin()) {
+        return _noZones;
+    }
+    return (--it)->zones;
+}
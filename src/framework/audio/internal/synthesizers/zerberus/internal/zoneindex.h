@@ -0,0 +1,54 @@
+//=============================================================================
+//  Zerberus
+//  Zample player
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#ifndef MU_ZERBERUS_ZONEINDEX_H
+#define MU_ZERBERUS_ZONEINDEX_H
+
+#include <list>
+#include <vector>
+
+#include "zone.h"
+
+namespace mu::zerberus {
+//---------------------------------------------------------
+//   ZoneIndex
+//    zones of an instrument by trigger, key and velocity,
+//    so that a note does not need to check every zone
+//---------------------------------------------------------
+
+class ZoneIndex
+{
+    //! zones of a key for the velocities from veloLo up to
+    //! the veloLo of the next band
+    struct VelocityBand {
+        int veloLo = 0;
+        std::vector<Zone*> zones;
+    };
+    typedef std::vector<VelocityBand> KeyBands;
+
+    static const int KEYS = 128;
+    static const int KEY_TRIGGERS = int(Trigger::CC);     // the triggers before CC depend on key and velocity
+
+    std::vector<KeyBands> _bands;         // KEY_TRIGGERS * KEYS
+    std::vector<Zone*> _ccZones;
+
+    static const std::vector<Zone*> _noZones;
+
+public:
+    void build(const std::list<Zone*>& zones);
+    void clear();
+
+    const std::vector<Zone*>& candidates(Trigger trigger, int key, int velo) const;
+};
+}
+
+#endif //MU_ZERBERUS_ZONEINDEX_H
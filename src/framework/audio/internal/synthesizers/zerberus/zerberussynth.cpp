@@ -66,6 +66,11 @@ Ret ZerberusSynth::init()
     return true;
 }
 
+void ZerberusSynth::setRealtime(bool arg)
+{
+    m_zerb->setRealtime(arg);
+}
+
 void ZerberusSynth::setSampleRate(unsigned int sampleRate)
 {
     m_sampleRate = sampleRate;
@@ -64,6 +64,9 @@ public:
     const float* data() const override;
     void setBufferSize(unsigned int samples) override;
 
+    //! NOTE Offline rendering waits for the streamed samples
+    void setRealtime(bool arg);
+
 private:
 
     zerberus::Zerberus* m_zerb = nullptr;
@@ -146,6 +146,32 @@ std::shared_ptr<IMixer> AudioEngine::mixer() const
     return m_mixer;
 }
 
+RenderProfile AudioEngine::renderProfile() const
+{
+    ONLY_AUDIO_WORKER_THREAD;
+    RenderProfile profile;
+    if (m_mixer) {
+        profile = m_mixer->renderProfile();
+    }
+    if (m_buffer) {
+        profile.underruns = m_buffer->underrunCount() - m_underrunBase;
+        profile.overruns = m_buffer->overrunCount() - m_overrunBase;
+    }
+    return profile;
+}
+
+void AudioEngine::resetRenderProfile()
+{
+    ONLY_AUDIO_WORKER_THREAD;
+    if (m_mixer) {
+        m_mixer->resetRenderStats();
+    }
+    if (m_buffer) {
+        m_underrunBase = m_buffer->underrunCount();
+        m_overrunBase = m_buffer->overrunCount();
+    }
+}
+
 std::shared_ptr<ISequencer> AudioEngine::sequencer() const
 {
     ONLY_AUDIO_WORKER_THREAD;
@@ -156,6 +182,8 @@ void AudioEngine::setAudioBuffer(IAudioBufferPtr buffer)
 {
     ONLY_AUDIO_WORKER_THREAD;
     m_buffer = buffer;
+    m_underrunBase = m_buffer ? m_buffer->underrunCount() : 0;
+    m_overrunBase = m_buffer ? m_buffer->overrunCount() : 0;
     if (m_buffer && m_mixer) {
         m_buffer->setSource(m_mixer->mixedSource());
     }
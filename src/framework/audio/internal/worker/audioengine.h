@@ -61,6 +61,10 @@ public:
     IAudioBufferPtr buffer() const override;
     void setAudioBuffer(IAudioBufferPtr buffer) override;
 
+    //! render load of the mixer and the channels, with the xruns of the buffer
+    RenderProfile renderProfile() const;
+    void resetRenderProfile();
+
 private:
 
     AudioEngine();
@@ -72,6 +76,8 @@ private:
     std::shared_ptr<IAudioDriver> m_driver = nullptr;
     std::shared_ptr<Mixer> m_mixer = nullptr;
     std::shared_ptr<IAudioBuffer> m_buffer = nullptr;
+    uint64_t m_underrunBase = 0;
+    uint64_t m_overrunBase = 0;
 
     // synthesizers
 
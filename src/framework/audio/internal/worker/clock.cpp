@@ -56,6 +56,11 @@ void Clock::forward(Clock::time_t samples)
     }
 }
 
+Clock::Status Clock::status() const
+{
+    return m_status;
+}
+
 void Clock::start()
 {
     m_status = Running;
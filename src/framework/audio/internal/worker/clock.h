@@ -53,6 +53,8 @@ public:
     void setSampleRate(unsigned int sampleRate);
     void forward(time_t samples);
 
+    Status status() const;
+
     void start();
     void reset();
     void stop();
@@ -83,6 +83,7 @@ void MIDIPlayer::loadMIDI(const std::shared_ptr<MidiStream>& stream)
 
     if (m_midiStream->isStreamingAllowed) {
         m_midiStream->stream.onReceive(this, [this](const Chunk& chunk) { onChunkReceived(chunk); });
+        m_midiStream->replace.onReceive(this, [this](const Chunk& chunk) { onChunkReplaced(chunk); });
     }
 
     if (m_midiStream->isStreamingAllowed && validChunkTick(0, m_midiData.chunks, REQUEST_BUFFER_SIZE) == 0) {
@@ -141,8 +142,34 @@ void MIDIPlayer::requestData(tick_t tick)
 void MIDIPlayer::onChunkReceived(const Chunk& chunk)
 {
     std::lock_guard<std::mutex> lock(m_dataMutex);
-    m_midiData.chunks.insert({ chunk.beginTick, chunk });
     m_streamState.requested = false;
+
+    //! NOTE An empty chunk means there is no more data
+    if (chunk.beginTick >= chunk.endTick) {
+        return;
+    }
+
+    m_midiData.replaceChunk(chunk);
+}
+
+void MIDIPlayer::onChunkReplaced(const Chunk& chunk)
+{
+    std::lock_guard<std::mutex> lock(m_dataMutex);
+
+    if (chunk.beginTick >= chunk.endTick) {
+        return;
+    }
+
+    //! NOTE The sounding notes may be gone, stop them on the next tick
+    auto playing = m_midiData.chunks.upper_bound(m_playTick);
+    if (playing != m_midiData.chunks.begin()) {
+        const Chunk& old = std::prev(playing)->second;
+        if (m_playTick < old.endTick && old.beginTick < chunk.endTick && chunk.beginTick < old.endTick) {
+            m_needClear = true;
+        }
+    }
+
+    m_midiData.replaceChunk(chunk);
 }
 
 void MIDIPlayer::forwardTime(unsigned long milliseconds)
@@ -159,6 +186,10 @@ void MIDIPlayer::forwardTime(unsigned long milliseconds)
         return;
     }
 
+    if (m_needClear.exchange(false)) {
+        sendClear();
+    }
+
     msec_t curMSec = m_curMSec + (delta * m_playSpeed);
     tick_t curTick = tick(curMSec);
     tick_t prevTicks = tick(m_prevMSec);
@@ -26,6 +26,7 @@
 #include <cstdint>
 #include <functional>
 #include <mutex>
+#include <atomic>
 
 #include "imidiplayer.h"
 #include "modularity/ioc.h"
@@ -91,6 +92,7 @@ private:
 
     void requestData(midi::tick_t tick);
     void onChunkReceived(const midi::Chunk& chunk);
+    void onChunkReplaced(const midi::Chunk& chunk);
 
     Status m_status = Status::Stoped;
     async::Channel<Status> m_statusChanged;
@@ -99,6 +101,7 @@ private:
     midi::MidiData m_midiData;
     std::shared_ptr<midi::MidiStream> m_midiStream = nullptr;
     std::map<uint8_t, midi::Event> m_noteCache = {};
+    std::atomic<bool> m_needClear{ false };
 
     float m_playSpeed = 1.f;
 
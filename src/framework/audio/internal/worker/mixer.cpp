@@ -17,6 +17,8 @@
 //  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
 //=============================================================================
 #include "mixer.h"
+#include <algorithm>
+#include "mixkernel.h"
 #include "log.h"
 #include "internal/audiosanitizer.h"
 
@@ -165,61 +167,115 @@ void Mixer::setBufferSize(unsigned int samples)
 void Mixer::forward(unsigned int sampleCount)
 {
     ONLY_AUDIO_WORKER_THREAD;
+    auto blockStart = std::chrono::steady_clock::now();
+
     std::fill(m_buffer.begin(), m_buffer.end(), 0.f);
 
     if (m_clock) {
         m_clock->forward(sampleCount);
     }
 
+    //! NOTE Only during playback the next block comes soon enough to spin for it
+    m_renderPool.setSpinning(m_clock && m_clock->status() == Clock::Running);
+
+    //! NOTE Without active inserts the master level can be folded into the channel gains,
+    //! so the mix is done in a single pass over the buffer
+    bool hasActiveInserts = std::any_of(m_insertList.cbegin(), m_insertList.cend(), [](const auto& insert) {
+        return insert.second->active();
+    });
+    float channelMasterLevel = hasActiveInserts ? 1.f : m_masterLevel;
+
+    renderChannels(sampleCount);
+
+    //! NOTE The mixdown stays on this thread and in channel order, so the sum does not depend on the render order
     for (auto& input : m_inputList) {
-        input.second->forward(sampleCount);
-        mixinChannel(input.second, sampleCount);
+        mixinChannel(*input.second, sampleCount, channelMasterLevel);
     }
 
-    for (auto& insert : m_insertList) {
-        if (insert.second->active()) {
-            insert.second->process(m_buffer.data(), m_buffer.data(), sampleCount);
+    if (hasActiveInserts) {
+        for (auto& insert : m_insertList) {
+            if (insert.second->active()) {
+                insert.second->process(m_buffer.data(), m_buffer.data(), sampleCount);
+            }
         }
+        applyGain(m_buffer.data(), m_masterLevel, m_buffer.size());
+    }
+
+    if (m_sampleRate > 0) {
+        m_blockProfiler.push(std::chrono::steady_clock::now() - blockStart,
+                             std::chrono::nanoseconds(uint64_t(sampleCount) * 1000000000 / m_sampleRate));
     }
-    std::transform(m_buffer.begin(), m_buffer.end(), m_buffer.begin(),
-                   [this](float sample) -> float { return sample * m_masterLevel; });
 }
 
-void Mixer::mixinChannel(std::shared_ptr<MixerChannel> channel, unsigned int samplesCount)
+void Mixer::renderChannels(unsigned int sampleCount)
 {
-    if (!channel->active()) {
-        return;
+    //! NOTE Every channel has its own source (a synthesizer, an audio track),
+    //! the sources are independent of each other, so the channels can be rendered in parallel
+    m_renderChannels.clear();
+    for (auto& input : m_inputList) {
+        m_renderChannels.push_back(input.second.get());
     }
-    channel->checkStreams();
-    switch (m_mode) {
-    case MONO:
-    case STEREO:
-        for (unsigned int i = 0; i < channel->streamCount(); ++i) {
-            mixinChannelStream(channel, i, samplesCount);
-        }
-        break;
+    m_renderSampleCount = sampleCount;
+
+    m_renderPool.run([](void* context, size_t index) {
+        Mixer* mixer = static_cast<Mixer*>(context);
+        mixer->m_renderChannels[index]->forward(mixer->m_renderSampleCount);
+    }, this, m_renderChannels.size());
+}
+
+void Mixer::resetRenderStats()
+{
+    ONLY_AUDIO_WORKER_THREAD;
+    m_blockProfiler.reset();
+    for (auto& input : m_inputList) {
+        input.second->renderProfiler().reset();
     }
 }
 
-void Mixer::mixinChannelStream(std::shared_ptr<MixerChannel> channel, unsigned int streamId, unsigned int samplesCount)
+RenderProfile Mixer::renderProfile()
 {
-    auto balance = channel->balance(streamId).real();
-    auto level = channel->level(streamId);
-    for (unsigned int i = 0; i < samplesCount; ++i) {
-        for (unsigned int j = 0; j < streamCount(); ++j) {
-            //linear cross
-            float gain = 0.5f * balance * ((j * 2.f) - 1) + 0.5f;
-            if (gain < 0) {
-                gain = 0;
-            }
-            if (gain > 1) {
-                gain = 1;
-            }
+    ONLY_AUDIO_WORKER_THREAD;
+    RenderProfile profile;
+    profile.blockSamples = m_renderSampleCount;
 
-            auto channelBuffer = channel->data();
-            if (channelBuffer) {
-                m_buffer[i * streamCount() + j] += gain * level * channelBuffer[i * channel->streamCount() + streamId];
-            }
+    m_blockProfiler.collect();
+    profile.mixer = m_blockProfiler.stats();
+
+    for (auto& input : m_inputList) {
+        RenderProfiler& channelProfiler = input.second->renderProfiler();
+        channelProfiler.collect();
+        profile.channels[input.first] = channelProfiler.stats();
+    }
+
+    return profile;
+}
+
+void Mixer::mixinChannel(MixerChannel& channel, unsigned int samplesCount, float masterLevel)
+{
+    if (!channel.active()) {
+        return;
+    }
+    channel.checkStreams();
+
+    const float* channelBuffer = channel.data();
+    if (!channelBuffer) {
+        return;
+    }
+
+    unsigned int srcStreams = channel.streamCount();
+    unsigned int destStreams = streamCount();
+
+    //! NOTE Gain matrix is computed once per block, row per channel stream
+    m_channelGains.resize(srcStreams * destStreams);
+    for (unsigned int s = 0; s < srcStreams; ++s) {
+        float balance = channel.balance(s).real();
+        float level = channel.level(s) * masterLevel;
+        for (unsigned int d = 0; d < destStreams; ++d) {
+            //linear cross
+            float gain = std::clamp(0.5f * balance * ((d * 2.f) - 1) + 0.5f, 0.f, 1.f);
+            m_channelGains[s * destStreams + d] = gain * level;
         }
     }
+
+    mixInterleaved(m_buffer.data(), destStreams, channelBuffer, srcStreams, m_channelGains.data(), samplesCount);
 }
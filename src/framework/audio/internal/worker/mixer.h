@@ -21,10 +21,13 @@
 
 #include <memory>
 #include <map>
+#include <vector>
 #include "imixer.h"
 #include "abstractaudiosource.h"
 #include "mixerchannel.h"
 #include "clock.h"
+#include "renderpool.h"
+#include "renderprofiler.h"
 
 namespace mu::audio {
 class Mixer : public IMixer, public AbstractAudioSource, public std::enable_shared_from_this<Mixer>
@@ -65,16 +68,31 @@ public:
 
     void setClock(std::shared_ptr<Clock> clock);
 
+    //! clear the load histograms of the blocks and of every channel
+    void resetRenderStats();
+
+    //! load histograms of the blocks and of every channel, call between the blocks
+    RenderProfile renderProfile();
+
 private:
+    //! render the channels on the render pool, returns after all of them are done
+    void renderChannels(unsigned int sampleCount);
+
     //! mix the channel in to the buffer
-    void mixinChannel(std::shared_ptr<MixerChannel> channel, unsigned int samplesCount);
-    void mixinChannelStream(std::shared_ptr<MixerChannel> channel, unsigned int streamId, unsigned int samplesCount);
+    void mixinChannel(MixerChannel& channel, unsigned int samplesCount, float masterLevel);
 
     Mode m_mode = STEREO;
     float m_masterLevel = 1.f;
     std::map<ChannelID, std::shared_ptr<MixerChannel> > m_inputList = {};
     std::map<unsigned int, std::shared_ptr<IAudioProcessor> > m_insertList = {};
     std::shared_ptr<Clock> m_clock;
+    std::vector<float> m_channelGains = {};
+
+    RenderPool m_renderPool;
+    std::vector<MixerChannel*> m_renderChannels = {};
+    unsigned int m_renderSampleCount = 0;
+
+    RenderProfiler m_blockProfiler;
 };
 }
 
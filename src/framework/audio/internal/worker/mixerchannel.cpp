@@ -47,6 +47,8 @@ void MixerChannel::forward(unsigned int sampleCount)
     IF_ASSERT_FAILED(m_source) {
         return;
     }
+    auto renderStart = std::chrono::steady_clock::now();
+
     m_source->forward(sampleCount);
 
     //you can use source's buffer as pre proccesing KEY, current buffer as post processing KEY
@@ -57,6 +59,11 @@ void MixerChannel::forward(unsigned int sampleCount)
             p.second->process(m_buffer.data(), m_buffer.data(), sampleCount);
         }
     }
+
+    if (m_sampleRate > 0) {
+        m_renderProfiler.push(std::chrono::steady_clock::now() - renderStart,
+                              std::chrono::nanoseconds(uint64_t(sampleCount) * 1000000000 / m_sampleRate));
+    }
 }
 
 void MixerChannel::setBufferSize(unsigned int samples)
@@ -158,6 +165,11 @@ void MixerChannel::setProcessor(unsigned int number, IAudioProcessorPtr proc)
     m_processorList[number] = proc;
 }
 
+RenderProfiler& MixerChannel::renderProfiler()
+{
+    return m_renderProfiler;
+}
+
 void MixerChannel::updateBalanceLevelMaps()
 {
     for (unsigned int c = 0; c < m_source->streamCount(); ++c) {
@@ -27,6 +27,7 @@
 #include "iaudioprocessor.h"
 #include "imixerchannel.h"
 #include "abstractaudiosource.h"
+#include "renderprofiler.h"
 
 namespace mu::audio {
 class MixerChannel : public IMixerChannel, public AbstractAudioSource, public async::Asyncable
@@ -56,6 +57,9 @@ public:
     IAudioProcessorPtr processor(unsigned int number) const override;
     void setProcessor(unsigned int number, IAudioProcessorPtr proc) override;
 
+    //! load of every forward(), filled from the render thread, read between the blocks
+    RenderProfiler& renderProfiler();
+
 protected:
     void updateBalanceLevelMaps();
 
@@ -64,6 +68,7 @@ protected:
     std::map<unsigned int, std::complex<float> > m_balance = {};
     std::map<unsigned int, float> m_level = {};
     std::map<unsigned int, IAudioProcessorPtr > m_processorList = {};
+    RenderProfiler m_renderProfiler;
 };
 }
 
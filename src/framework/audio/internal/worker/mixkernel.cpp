@@ -0,0 +1,197 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include "mixkernel.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MU_AUDIO_MIX_SSE
+#include <emmintrin.h>
+#endif
+
+#if defined(__AVX__)
+#define MU_AUDIO_MIX_AVX
+#include <immintrin.h>
+#endif
+
+using namespace mu::audio;
+
+void mu::audio::mixInterleavedScalar(float* dest, unsigned int destStreams,
+                                     const float* src, unsigned int srcStreams,
+                                     const float* gains, unsigned int sampleCount)
+{
+    for (unsigned int i = 0; i < sampleCount; ++i) {
+        const float* in = src + i * srcStreams;
+        float* out = dest + i * destStreams;
+        for (unsigned int s = 0; s < srcStreams; ++s) {
+            const float* row = gains + s * destStreams;
+            for (unsigned int d = 0; d < destStreams; ++d) {
+                out[d] += in[s] * row[d];
+            }
+        }
+    }
+}
+
+//! mono source to stereo destination
+static void mixMonoToStereo(float* dest, const float* src, const float* gains, unsigned int sampleCount)
+{
+    const float gl = gains[0];
+    const float gr = gains[1];
+    unsigned int i = 0;
+
+#if defined(MU_AUDIO_MIX_AVX)
+    const __m256 g8 = _mm256_setr_ps(gl, gr, gl, gr, gl, gr, gl, gr);
+    for (; i + 8 <= sampleCount; i += 8) {
+        __m256 s = _mm256_loadu_ps(src + i);                       // s0..s7
+        __m256 lo = _mm256_unpacklo_ps(s, s);                      // s0 s0 s1 s1 | s4 s4 s5 s5
+        __m256 hi = _mm256_unpackhi_ps(s, s);                      // s2 s2 s3 s3 | s6 s6 s7 s7
+        __m256 a = _mm256_permute2f128_ps(lo, hi, 0x20);           // s0 s0 s1 s1 s2 s2 s3 s3
+        __m256 b = _mm256_permute2f128_ps(lo, hi, 0x31);           // s4 s4 s5 s5 s6 s6 s7 s7
+        float* out = dest + 2 * i;
+        _mm256_storeu_ps(out, _mm256_add_ps(_mm256_loadu_ps(out), _mm256_mul_ps(a, g8)));
+        _mm256_storeu_ps(out + 8, _mm256_add_ps(_mm256_loadu_ps(out + 8), _mm256_mul_ps(b, g8)));
+    }
+#endif
+
+#if defined(MU_AUDIO_MIX_SSE)
+    const __m128 g4 = _mm_setr_ps(gl, gr, gl, gr);
+    for (; i + 4 <= sampleCount; i += 4) {
+        __m128 s = _mm_loadu_ps(src + i);
+        __m128 a = _mm_unpacklo_ps(s, s);   // s0 s0 s1 s1
+        __m128 b = _mm_unpackhi_ps(s, s);   // s2 s2 s3 s3
+        float* out = dest + 2 * i;
+        _mm_storeu_ps(out, _mm_add_ps(_mm_loadu_ps(out), _mm_mul_ps(a, g4)));
+        _mm_storeu_ps(out + 4, _mm_add_ps(_mm_loadu_ps(out + 4), _mm_mul_ps(b, g4)));
+    }
+#endif
+
+    for (; i < sampleCount; ++i) {
+        dest[2 * i] += src[i] * gl;
+        dest[2 * i + 1] += src[i] * gr;
+    }
+}
+
+//! stereo source to stereo destination, full 2x2 gain matrix
+static void mixStereoToStereo(float* dest, const float* src, const float* gains, unsigned int sampleCount)
+{
+    const float gll = gains[0];
+    const float glr = gains[1];
+    const float grl = gains[2];
+    const float grr = gains[3];
+    unsigned int i = 0;
+
+#if defined(MU_AUDIO_MIX_AVX)
+    const __m256 gl8 = _mm256_setr_ps(gll, glr, gll, glr, gll, glr, gll, glr);
+    const __m256 gr8 = _mm256_setr_ps(grl, grr, grl, grr, grl, grr, grl, grr);
+    for (; i + 4 <= sampleCount; i += 4) {
+        __m256 s = _mm256_loadu_ps(src + 2 * i);                    // l0 r0 l1 r1 ...
+        __m256 l = _mm256_shuffle_ps(s, s, _MM_SHUFFLE(2, 2, 0, 0)); // l0 l0 l1 l1 ...
+        __m256 r = _mm256_shuffle_ps(s, s, _MM_SHUFFLE(3, 3, 1, 1)); // r0 r0 r1 r1 ...
+        float* out = dest + 2 * i;
+        __m256 mixed = _mm256_add_ps(_mm256_mul_ps(l, gl8), _mm256_mul_ps(r, gr8));
+        _mm256_storeu_ps(out, _mm256_add_ps(_mm256_loadu_ps(out), mixed));
+    }
+#endif
+
+#if defined(MU_AUDIO_MIX_SSE)
+    const __m128 gl4 = _mm_setr_ps(gll, glr, gll, glr);
+    const __m128 gr4 = _mm_setr_ps(grl, grr, grl, grr);
+    for (; i + 2 <= sampleCount; i += 2) {
+        __m128 s = _mm_loadu_ps(src + 2 * i);
+        __m128 l = _mm_shuffle_ps(s, s, _MM_SHUFFLE(2, 2, 0, 0));
+        __m128 r = _mm_shuffle_ps(s, s, _MM_SHUFFLE(3, 3, 1, 1));
+        float* out = dest + 2 * i;
+        __m128 mixed = _mm_add_ps(_mm_mul_ps(l, gl4), _mm_mul_ps(r, gr4));
+        _mm_storeu_ps(out, _mm_add_ps(_mm_loadu_ps(out), mixed));
+    }
+#endif
+
+    for (; i < sampleCount; ++i) {
+        float l = src[2 * i];
+        float r = src[2 * i + 1];
+        dest[2 * i] += l * gll + r * grl;
+        dest[2 * i + 1] += l * glr + r * grr;
+    }
+}
+
+void mu::audio::mixPlanar(float* dest, const float* src, float gain, size_t count)
+{
+    size_t i = 0;
+
+#if defined(MU_AUDIO_MIX_AVX)
+    const __m256 g8 = _mm256_set1_ps(gain);
+    for (; i + 8 <= count; i += 8) {
+        _mm256_storeu_ps(dest + i, _mm256_add_ps(_mm256_loadu_ps(dest + i), _mm256_mul_ps(_mm256_loadu_ps(src + i), g8)));
+    }
+#endif
+
+#if defined(MU_AUDIO_MIX_SSE)
+    const __m128 g4 = _mm_set1_ps(gain);
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_ps(dest + i, _mm_add_ps(_mm_loadu_ps(dest + i), _mm_mul_ps(_mm_loadu_ps(src + i), g4)));
+    }
+#endif
+
+    for (; i < count; ++i) {
+        dest[i] += src[i] * gain;
+    }
+}
+
+void mu::audio::applyGain(float* buffer, float gain, size_t count)
+{
+    size_t i = 0;
+
+#if defined(MU_AUDIO_MIX_AVX)
+    const __m256 g8 = _mm256_set1_ps(gain);
+    for (; i + 8 <= count; i += 8) {
+        _mm256_storeu_ps(buffer + i, _mm256_mul_ps(_mm256_loadu_ps(buffer + i), g8));
+    }
+#endif
+
+#if defined(MU_AUDIO_MIX_SSE)
+    const __m128 g4 = _mm_set1_ps(gain);
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_ps(buffer + i, _mm_mul_ps(_mm_loadu_ps(buffer + i), g4));
+    }
+#endif
+
+    for (; i < count; ++i) {
+        buffer[i] *= gain;
+    }
+}
+
+void mu::audio::mixInterleaved(float* dest, unsigned int destStreams,
+                               const float* src, unsigned int srcStreams,
+                               const float* gains, unsigned int sampleCount)
+{
+    if (destStreams == 2 && srcStreams == 1) {
+        mixMonoToStereo(dest, src, gains, sampleCount);
+        return;
+    }
+
+    if (destStreams == 2 && srcStreams == 2) {
+        mixStereoToStereo(dest, src, gains, sampleCount);
+        return;
+    }
+
+    if (destStreams == 1 && srcStreams == 1) {
+        mixPlanar(dest, src, gains[0], sampleCount);
+        return;
+    }
+
+    mixInterleavedScalar(dest, destStreams, src, srcStreams, gains, sampleCount);
+}
@@ -0,0 +1,48 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_AUDIO_MIXKERNEL_H
+#define MU_AUDIO_MIXKERNEL_H
+
+#include <cstddef>
+
+namespace mu::audio {
+//! NOTE Block mixing kernels used by the Mixer.
+//! All functions are allocation-free and use SSE/AVX when the compiler targets it,
+//! otherwise a scalar implementation.
+
+//! Mix an interleaved source into an interleaved destination:
+//!   dest[i * destStreams + d] += sum_s(src[i * srcStreams + s] * gains[s * destStreams + d])
+//! gains is a srcStreams x destStreams matrix, row per source stream
+void mixInterleaved(float* dest, unsigned int destStreams,
+                    const float* src, unsigned int srcStreams,
+                    const float* gains, unsigned int sampleCount);
+
+//! dest[i] += src[i] * gain, for planar (one stream per buffer) data
+void mixPlanar(float* dest, const float* src, float gain, size_t count);
+
+//! buffer[i] *= gain
+void applyGain(float* buffer, float gain, size_t count);
+
+//! scalar implementation of mixInterleaved, reference for tests and benchmarks
+void mixInterleavedScalar(float* dest, unsigned int destStreams,
+                          const float* src, unsigned int srcStreams,
+                          const float* gains, unsigned int sampleCount);
+}
+
+#endif // MU_AUDIO_MIXKERNEL_H
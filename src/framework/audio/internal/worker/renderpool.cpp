@@ -0,0 +1,200 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include "renderpool.h"
+
+#include <algorithm>
+#include <string>
+
+#include "log.h"
+#include "runtime.h"
+#include "internal/audiosanitizer.h"
+
+#ifdef Q_OS_LINUX
+#include <pthread.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MU_AUDIO_CPU_RELAX() _mm_pause()
+#else
+#define MU_AUDIO_CPU_RELAX() std::this_thread::yield()
+#endif
+
+using namespace mu::audio;
+
+RenderPool::RenderPool(size_t threadCount)
+{
+#ifdef Q_OS_WASM
+    threadCount = 0;
+#endif
+    threadCount = std::min(threadCount, MAX_THREADS);
+
+    m_threads.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i) {
+        m_threads.emplace_back([this, i]() {
+            threadMain(i);
+        });
+    }
+}
+
+RenderPool::~RenderPool()
+{
+    m_running = false;
+    for (size_t i = 0; i < m_threads.size(); ++i) {
+        m_wakeup.release();
+    }
+    for (std::thread& thread : m_threads) {
+        thread.join();
+    }
+}
+
+size_t RenderPool::defaultThreadCount()
+{
+    unsigned int hardwareThreads = std::thread::hardware_concurrency();
+    if (hardwareThreads < 2) {
+        return 0;
+    }
+    return std::min(static_cast<size_t>(hardwareThreads - 1), MAX_THREADS);
+}
+
+size_t RenderPool::threadCount() const
+{
+    return m_threads.size();
+}
+
+void RenderPool::setSpinning(bool spinning)
+{
+    m_spinning.store(spinning, std::memory_order_relaxed);
+}
+
+void RenderPool::run(Task task, void* context, size_t taskCount)
+{
+    if (taskCount == 0) {
+        return;
+    }
+
+    if (m_threads.empty() || taskCount == 1) {
+        for (size_t i = 0; i < taskCount; ++i) {
+            task(context, i);
+        }
+        return;
+    }
+
+    ++m_generation;
+    m_task.store(task, std::memory_order_relaxed);
+    m_context.store(context, std::memory_order_relaxed);
+    m_taskCount.store(taskCount, std::memory_order_relaxed);
+    m_doneCount.store(0, std::memory_order_relaxed);
+    m_claim.store(m_generation << 32, std::memory_order_seq_cst);
+
+    wakeParked(taskCount - 1);
+
+    while (runNextTask(m_generation, task, context, taskCount)) {
+    }
+
+    while (m_doneCount.load(std::memory_order_acquire) < taskCount) {
+        MU_AUDIO_CPU_RELAX();
+    }
+
+    //! NOTE Close the job before the fields are reused, a thread which reads them
+    //! for the next job with this generation cannot claim anything
+    m_claim.store((m_generation << 32) | INDEX_MASK, std::memory_order_release);
+}
+
+bool RenderPool::runNextTask(uint64_t generation, Task task, void* context, size_t taskCount)
+{
+    uint64_t claim = m_claim.load(std::memory_order_acquire);
+    do {
+        if ((claim >> 32) != generation || (claim & INDEX_MASK) >= taskCount) {
+            return false;
+        }
+    } while (!m_claim.compare_exchange_weak(claim, claim + 1, std::memory_order_acq_rel));
+
+    task(context, static_cast<size_t>(claim & INDEX_MASK));
+    m_doneCount.fetch_add(1, std::memory_order_release);
+    return true;
+}
+
+//! NOTE Releasing the semaphore doesn't block, it calls the system only for a parked thread
+void RenderPool::wakeParked(size_t count)
+{
+    size_t parked = m_parked.load(std::memory_order_seq_cst);
+    size_t wake = std::min(parked, count);
+    while (wake > 0 && !m_parked.compare_exchange_weak(parked, parked - wake, std::memory_order_seq_cst)) {
+        wake = std::min(parked, count);
+    }
+
+    for (size_t i = 0; i < wake; ++i) {
+        m_wakeup.release();
+    }
+}
+
+void RenderPool::threadMain(size_t threadIndex)
+{
+    mu::runtime::setThreadName("audio_render_" + std::to_string(threadIndex));
+    AudioSanitizer::setupRenderThread();
+
+#ifdef Q_OS_LINUX
+    //! NOTE The audio worker keeps the first core, the render threads take one core each after it
+    unsigned int cores = std::thread::hardware_concurrency();
+    if (cores > 1) {
+        cpu_set_t cpuset;
+        CPU_ZERO(&cpuset);
+        CPU_SET((threadIndex + 1) % cores, &cpuset);
+        if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset) != 0) {
+            LOGW() << "failed pin render thread " << threadIndex;
+        }
+    }
+#endif
+
+    uint64_t lastGeneration = 0;
+    while (m_running.load(std::memory_order_relaxed)) {
+        uint64_t generation = m_claim.load(std::memory_order_acquire) >> 32;
+        if (generation != lastGeneration) {
+            lastGeneration = generation;
+
+            Task task = m_task.load(std::memory_order_relaxed);
+            void* context = m_context.load(std::memory_order_relaxed);
+            size_t taskCount = m_taskCount.load(std::memory_order_relaxed);
+            while (runNextTask(generation, task, context, taskCount)) {
+            }
+            continue;
+        }
+
+        if (m_spinning.load(std::memory_order_relaxed)) {
+            MU_AUDIO_CPU_RELAX();
+            continue;
+        }
+
+        m_parked.fetch_add(1, std::memory_order_seq_cst);
+
+        //! NOTE A job published before the thread was counted may not wake it,
+        //! so it takes its count back, unless run() has already released the semaphore for it
+        if ((m_claim.load(std::memory_order_seq_cst) >> 32) != lastGeneration || !m_running.load(std::memory_order_relaxed)) {
+            size_t parked = m_parked.load(std::memory_order_seq_cst);
+            while (parked > 0 && !m_parked.compare_exchange_weak(parked, parked - 1, std::memory_order_seq_cst)) {
+            }
+            if (parked > 0) {
+                continue;
+            }
+        }
+
+        m_wakeup.acquire();
+    }
+}
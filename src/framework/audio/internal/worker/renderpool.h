@@ -0,0 +1,83 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_AUDIO_RENDERPOOL_H
+#define MU_AUDIO_RENDERPOOL_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "internal/audiosemaphore.h"
+
+namespace mu::audio {
+//! NOTE Fixed set of threads which help the audio worker to render a block.
+//! run() publishes a job without locks, the calling thread takes part in it
+//! and returns when all tasks are done, so it is also the barrier before the mixdown.
+//! Idle threads are parked on a semaphore which run() releases, or spin while the blocks follow each other.
+//! Nothing is allocated after construction.
+class RenderPool
+{
+public:
+    using Task = void (*)(void* context, size_t index);
+
+    explicit RenderPool(size_t threadCount = defaultThreadCount());
+    ~RenderPool();
+
+    RenderPool(const RenderPool&) = delete;
+    RenderPool& operator=(const RenderPool&) = delete;
+
+    //! hardware threads minus the audio worker, at most MAX_THREADS
+    static size_t defaultThreadCount();
+    static constexpr size_t MAX_THREADS = 16;
+
+    size_t threadCount() const;
+
+    //! spinning idle threads take the next job sooner, set while the blocks come one after another
+    void setSpinning(bool spinning);
+
+    //! calls task(context, i) for i in [0, taskCount) and waits for all of them
+    void run(Task task, void* context, size_t taskCount);
+
+private:
+    static constexpr uint64_t INDEX_MASK = 0xffffffff;
+
+    void threadMain(size_t threadIndex);
+    bool runNextTask(uint64_t generation, Task task, void* context, size_t taskCount);
+    void wakeParked(size_t count);
+
+    std::vector<std::thread> m_threads;
+    std::atomic<bool> m_running { true };
+    std::atomic<bool> m_spinning { false };
+    std::atomic<size_t> m_parked { 0 };
+    AudioSemaphore m_wakeup;
+
+    //! generation of the current job in the high half, index of the next task in the low half,
+    //! so a late thread cannot take a task of a newer job
+    std::atomic<uint64_t> m_claim { 0 };
+    std::atomic<Task> m_task { nullptr };
+    std::atomic<void*> m_context { nullptr };
+    std::atomic<size_t> m_taskCount { 0 };
+    std::atomic<size_t> m_doneCount { 0 };
+    uint64_t m_generation = 0;
+};
+}
+
+#endif // MU_AUDIO_RENDERPOOL_H
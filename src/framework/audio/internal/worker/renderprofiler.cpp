@@ -0,0 +1,103 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include "renderprofiler.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace mu::audio;
+
+void RenderProfiler::push(std::chrono::nanoseconds time, std::chrono::nanoseconds deadline)
+{
+    if (deadline.count() <= 0) {
+        return;
+    }
+
+    //! NOTE Only the producer writes m_writeIndex
+    uint64_t write = m_writeIndex.load(std::memory_order_relaxed);
+    uint64_t read = m_readIndex.load(std::memory_order_acquire);
+    if (write - read >= RING_SIZE) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    m_ring[write % RING_SIZE] = static_cast<float>(time.count()) / static_cast<float>(deadline.count());
+    m_writeIndex.store(write + 1, std::memory_order_release);
+}
+
+void RenderProfiler::collect()
+{
+    //! NOTE Only the reader writes m_readIndex
+    uint64_t read = m_readIndex.load(std::memory_order_relaxed);
+    uint64_t write = m_writeIndex.load(std::memory_order_acquire);
+
+    for (; read != write; ++read) {
+        float percent = m_ring[read % RING_SIZE] * 100.f;
+        size_t bucket = std::min(static_cast<size_t>(percent), HISTOGRAM_SIZE - 1);
+        ++m_histogram[bucket];
+        ++m_blocks;
+        if (percent > 100.f) {
+            ++m_deadlineMisses;
+        }
+        m_max = std::max(m_max, percent);
+    }
+
+    m_readIndex.store(read, std::memory_order_release);
+}
+
+RenderProfiler::Stats RenderProfiler::stats() const
+{
+    Stats s;
+    s.blocks = m_blocks;
+    s.deadlineMisses = m_deadlineMisses;
+    s.dropped = m_dropped.load(std::memory_order_relaxed) - m_droppedBase;
+    s.p50 = percentile(0.5f);
+    s.p99 = percentile(0.99f);
+    s.max = m_max;
+    return s;
+}
+
+void RenderProfiler::reset()
+{
+    collect();
+    m_histogram.fill(0);
+    m_blocks = 0;
+    m_deadlineMisses = 0;
+    m_droppedBase = m_dropped.load(std::memory_order_relaxed);
+    m_max = 0.f;
+}
+
+float RenderProfiler::percentile(float fraction) const
+{
+    if (m_blocks == 0) {
+        return 0.f;
+    }
+
+    //! NOTE The upper edge of the bucket, so the result is never below the real value,
+    //! it is at most one percent above it
+    uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(fraction * m_blocks)));
+    uint64_t count = 0;
+    for (size_t i = 0; i < HISTOGRAM_SIZE - 1; ++i) {
+        count += m_histogram[i];
+        if (count >= rank) {
+            return std::min(static_cast<float>(i + 1), m_max);
+        }
+    }
+    return m_max;
+}
@@ -0,0 +1,89 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_AUDIO_RENDERPROFILER_H
+#define MU_AUDIO_RENDERPROFILER_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+
+namespace mu::audio {
+//! NOTE Collects the render time of the blocks as a load, the part of the block deadline it took.
+//! push() is called from the render path: it writes in to a fixed ring without locks and allocations
+//! and drops the value if the ring is full. collect() is called by a single reader between the blocks,
+//! it moves the values from the ring to a histogram, the statistics are taken from the histogram.
+class RenderProfiler
+{
+public:
+    static constexpr size_t RING_SIZE = 1024;
+    //! one bucket per percent of the deadline, the last one takes everything above
+    static constexpr size_t HISTOGRAM_SIZE = 401;
+
+    //! loads are in percent of the deadline
+    struct Stats {
+        uint64_t blocks = 0;
+        uint64_t deadlineMisses = 0;
+        uint64_t dropped = 0;
+        float p50 = 0.f;
+        float p99 = 0.f;
+        float max = 0.f;
+    };
+
+    RenderProfiler() = default;
+
+    RenderProfiler(const RenderProfiler&) = delete;
+    RenderProfiler& operator=(const RenderProfiler&) = delete;
+
+    //! producer side
+    void push(std::chrono::nanoseconds time, std::chrono::nanoseconds deadline);
+
+    //! reader side
+    void collect();
+    Stats stats() const;
+    void reset();
+
+private:
+    float percentile(float fraction) const;
+
+    std::array<float, RING_SIZE> m_ring = {};
+    std::atomic<uint64_t> m_writeIndex { 0 };
+    std::atomic<uint64_t> m_readIndex { 0 };
+    std::atomic<uint64_t> m_dropped { 0 };
+
+    std::array<uint64_t, HISTOGRAM_SIZE> m_histogram = {};
+    uint64_t m_blocks = 0;
+    uint64_t m_deadlineMisses = 0;
+    uint64_t m_droppedBase = 0;
+    float m_max = 0.f;
+};
+
+//! NOTE What the devtools receive from the worker
+struct RenderProfile {
+    unsigned int blockSamples = 0;
+    RenderProfiler::Stats mixer;
+    std::map<unsigned int /*channel id*/, RenderProfiler::Stats> channels;
+    uint64_t underruns = 0;
+    uint64_t overruns = 0;
+};
+}
+
+#endif // MU_AUDIO_RENDERPROFILER_H
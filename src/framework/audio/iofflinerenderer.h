@@ -0,0 +1,65 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_AUDIO_IOFFLINERENDERER_H
+#define MU_AUDIO_IOFFLINERENDERER_H
+
+#include <functional>
+
+#include "modularity/imoduleexport.h"
+#include "ret.h"
+#include "global/progress.h"
+#include "midi/miditypes.h"
+
+namespace mu::audio {
+//! NOTE Renders midi data to audio without the audio driver and the real-time clock,
+//! as fast as the CPU allows. Works in the caller thread with its own synthesizer instances,
+//! so it doesn't interfere with the playback.
+class IOfflineRenderer : MODULE_EXPORT_INTERFACE
+{
+    INTERFACE_ID(IOfflineRenderer)
+
+public:
+    virtual ~IOfflineRenderer() = default;
+
+    //! return the chunk starting at fromTick, an empty chunk means the end of the data
+    using ChunkRequest = std::function<midi::Chunk(midi::tick_t fromTick)>;
+
+    //! receive interleaved stereo samples, return false to abort rendering
+    using BlockReceiver = std::function<bool (const float* data, unsigned int sampleCount)>;
+
+    struct Source {
+        midi::MidiData initData;    //! NOTE Chunks are optional, missing ones are requested
+        midi::tick_t lastTick = 0;
+        ChunkRequest chunkRequest;
+    };
+
+    struct Spec {
+        unsigned int sampleRate = 44100;
+        unsigned int blockSize = 4096;      //! samples per block passed to the receiver
+        unsigned int maxTailMsec = 5000;    //! how long the synthesizers may ring after the last event
+        unsigned int threads = 0;           //! parallel render lanes, 0 - as many as the cpu has cores
+        unsigned int laneMemoryMb = 1024;   //! memory the sound font copies of the extra lanes may take
+    };
+
+    virtual Ret render(const Source& source, const BlockReceiver& receiver, const Spec& spec) = 0;
+    virtual framework::ProgressChannel progress() const = 0;
+};
+}
+
+#endif // MU_AUDIO_IOFFLINERENDERER_H
@@ -12,6 +12,15 @@ Rectangle {
         id: devtools
     }
 
+    // the worker drains its profiler rings when the profile is requested,
+    // so ask often enough that the rings do not fill up during playback
+    Timer {
+        interval: 1000
+        repeat: true
+        running: true
+        onTriggered: devtools.requestRenderProfile()
+    }
+
     Column {
         anchors.fill: parent
 
@@ -113,6 +122,36 @@ Rectangle {
             }
         }
 
+        Row {
+            anchors.left:  parent.left
+            anchors.right: parent.right
+            height:  40
+            spacing: 8
+            FlatButton {
+                text: "Render profile"
+                width: 120
+                onClicked: devtools.requestRenderProfile()
+            }
+
+            FlatButton {
+                text: "Reset profile"
+                width: 120
+                onClicked: devtools.resetRenderProfile()
+            }
+
+            Text {
+                property var mixer: devtools.renderProfile.mixer
+                anchors.verticalCenter: parent.verticalCenter
+                text: mixer ? "blocks: " + mixer.blocks + " (" + devtools.renderProfile.blockSamples + " samples)"
+                              + ", p50: " + mixer.p50.toFixed(0) + "%"
+                              + ", p99: " + mixer.p99.toFixed(0) + "%"
+                              + ", max: " + mixer.max.toFixed(0) + "%"
+                              + ", misses: " + mixer.deadlineMisses
+                              + ", underruns: " + devtools.renderProfile.underruns
+                            : ""
+            }
+        }
+
         Row {
             anchors.left:  parent.left
             anchors.right: parent.right
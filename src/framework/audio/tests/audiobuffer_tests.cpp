@@ -0,0 +1,213 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "internal/audiobuffer.h"
+
+using namespace mu::audio;
+
+class AudioBufferTests : public ::testing::Test
+{
+public:
+};
+
+//! NOTE Stereo source that produces a running counter, never 0
+class CountingSource : public IAudioSource
+{
+public:
+    static float value(uint64_t n) { return static_cast<float>(n % 1000000 + 1); }
+
+    void setSampleRate(unsigned int) override {}
+    unsigned int streamCount() const override { return 2; }
+    mu::async::Channel<unsigned int> streamsCountChanged() const override { return m_streamsCountChanged; }
+
+    void forward(unsigned int sampleCount) override
+    {
+        m_data.resize(2 * sampleCount);
+        for (unsigned int i = 0; i < sampleCount; ++i) {
+            m_data[2 * i] = value(m_position);
+            m_data[2 * i + 1] = -value(m_position);
+            ++m_position;
+        }
+    }
+
+    const float* data() const override { return m_data.data(); }
+    void setBufferSize(unsigned int samples) override { m_data.resize(2 * samples); }
+
+private:
+    uint64_t m_position = 0;
+    std::vector<float> m_data;
+    mu::async::Channel<unsigned int> m_streamsCountChanged;
+};
+
+TEST_F(AudioBufferTests, AudioBuffer_CapacityIsPowerOfTwo)
+{
+    //! GIVEN Buffer with not power of two size
+
+    AudioBuffer buffer(2, 10000);
+
+    //! CHECK Capacity is rounded up
+
+    EXPECT_EQ(buffer.capacity(), 16384u);
+}
+
+TEST_F(AudioBufferTests, AudioBuffer_PushPop)
+{
+    //! GIVEN Stereo buffer with some data
+
+    AudioBuffer buffer(2, 4096);
+
+    std::vector<float> in(2 * 100);
+    for (size_t i = 0; i < in.size(); ++i) {
+        in[i] = static_cast<float>(i);
+    }
+    buffer.push(in.data(), 100);
+
+    //! DO Pop the same amount
+
+    std::vector<float> out(in.size(), -1.f);
+    buffer.pop(out.data(), 100);
+
+    //! CHECK Data is the same, no underruns
+
+    EXPECT_EQ(in, out);
+    EXPECT_EQ(buffer.underrunCount(), 0u);
+}
+
+TEST_F(AudioBufferTests, AudioBuffer_UnderrunZeroFill)
+{
+    //! GIVEN Buffer with less data than requested
+
+    AudioBuffer buffer(2, 4096);
+
+    std::vector<float> in(2 * 10, 1.f);
+    buffer.push(in.data(), 10);
+
+    //! DO Pop more than available
+
+    std::vector<float> out(2 * 20, -1.f);
+    buffer.pop(out.data(), 20);
+
+    //! CHECK Available data is returned, the rest is silence
+
+    for (size_t i = 0; i < 2 * 10; ++i) {
+        EXPECT_EQ(out[i], 1.f);
+    }
+    for (size_t i = 2 * 10; i < out.size(); ++i) {
+        EXPECT_EQ(out[i], 0.f);
+    }
+    EXPECT_EQ(buffer.underrunCount(), 1u);
+}
+
+TEST_F(AudioBufferTests, AudioBuffer_Wraparound)
+{
+    //! GIVEN Buffer filled and drained many times its capacity
+
+    AudioBuffer buffer(2, 4096);
+    const unsigned int block = 1000; // not a divisor of capacity
+
+    std::vector<float> in(2 * block);
+    std::vector<float> out(2 * block);
+    float value = 0.f;
+
+    for (int n = 0; n < 100; ++n) {
+        for (size_t i = 0; i < in.size(); ++i) {
+            in[i] = value++;
+        }
+        buffer.push(in.data(), block);
+        buffer.pop(out.data(), block);
+
+        //! CHECK Data survives crossing the end of the storage
+        ASSERT_EQ(in, out);
+    }
+
+    EXPECT_EQ(buffer.underrunCount(), 0u);
+    EXPECT_EQ(buffer.overrunCount(), 0u);
+}
+
+TEST_F(AudioBufferTests, AudioBuffer_Overrun)
+{
+    //! GIVEN Full buffer
+
+    AudioBuffer buffer(2, 4096);
+    std::vector<float> in(2 * buffer.capacity(), 1.f);
+    buffer.push(in.data(), buffer.capacity());
+
+    //! DO Push more
+
+    buffer.push(in.data(), 10);
+
+    //! CHECK Extra samples are dropped, not written over unread data
+
+    EXPECT_EQ(buffer.overrunCount(), 10u);
+}
+
+TEST_F(AudioBufferTests, AudioBuffer_ProducerConsumerStress)
+{
+    //! GIVEN Worker thread filling the buffer from a counting source
+    //! and driver thread reading it with a small block size
+
+    auto source = std::make_shared<CountingSource>();
+    AudioBuffer buffer(2, 4096);
+    buffer.setMinSampleLag(256);
+    buffer.setSource(source);
+
+    const uint64_t total = 500000;
+    const unsigned int popBlock = 64;
+
+    std::atomic<bool> done = false;
+    std::thread worker([&]() {
+        while (!done) {
+            buffer.forward();
+            std::this_thread::yield();
+        }
+    });
+
+    //! DO Read until enough samples are received
+
+    std::vector<float> out(2 * popBlock);
+    uint64_t received = 0;
+    uint64_t errors = 0;
+    while (received < total) {
+        buffer.pop(out.data(), popBlock);
+        for (unsigned int i = 0; i < popBlock; ++i) {
+            float left = out[2 * i];
+            float right = out[2 * i + 1];
+            if (left == 0.f && right == 0.f) {
+                continue; // underrun silence
+            }
+            if (left != CountingSource::value(received) || right != -left) {
+                ++errors;
+            }
+            ++received;
+        }
+    }
+
+    done = true;
+    worker.join();
+
+    //! CHECK Sequence is intact: no lost, duplicated or torn samples
+
+    EXPECT_EQ(errors, 0u);
+    EXPECT_EQ(buffer.overrunCount(), 0u);
+}
@@ -0,0 +1,113 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "internal/worker/mixkernel.h"
+
+using namespace mu::audio;
+
+//! NOTE Compares the block mixing kernel with the former per-sample Mixer loop,
+//! for 1..64 channels of stereo synth output into a stereo mix
+
+static constexpr unsigned int BLOCK_SIZE = 1024;
+static constexpr unsigned int STREAMS = 2;
+
+struct MixFixture {
+    std::vector<std::vector<float> > channels;
+    std::vector<float> balance;
+    std::vector<float> level;
+    std::vector<float> out;
+
+    explicit MixFixture(size_t channelCount)
+    {
+        channels.resize(channelCount);
+        for (size_t c = 0; c < channelCount; ++c) {
+            channels[c].resize(BLOCK_SIZE * STREAMS);
+            for (size_t i = 0; i < channels[c].size(); ++i) {
+                channels[c][i] = static_cast<float>((i + c) % 17) / 17.f;
+            }
+            balance.push_back(static_cast<float>(c % 3) - 1.f);
+            level.push_back(0.8f);
+        }
+        out.resize(BLOCK_SIZE * STREAMS);
+    }
+};
+
+static void BM_MixLegacy(benchmark::State& state)
+{
+    MixFixture f(state.range(0));
+    const float master = 0.9f;
+
+    for (auto _ : state) {
+        std::fill(f.out.begin(), f.out.end(), 0.f);
+        for (size_t c = 0; c < f.channels.size(); ++c) {
+            for (unsigned int streamId = 0; streamId < STREAMS; ++streamId) {
+                for (unsigned int i = 0; i < BLOCK_SIZE; ++i) {
+                    for (unsigned int j = 0; j < STREAMS; ++j) {
+                        float gain = 0.5f * f.balance[c] * ((j * 2.f) - 1) + 0.5f;
+                        if (gain < 0) {
+                            gain = 0;
+                        }
+                        if (gain > 1) {
+                            gain = 1;
+                        }
+                        const float* channelBuffer = f.channels[c].data();
+                        benchmark::DoNotOptimize(channelBuffer);
+                        f.out[i * STREAMS + j] += gain * f.level[c] * channelBuffer[i * STREAMS + streamId];
+                    }
+                }
+            }
+        }
+        std::transform(f.out.begin(), f.out.end(), f.out.begin(), [master](float sample) { return sample * master; });
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * BLOCK_SIZE * f.channels.size());
+}
+
+static void BM_MixKernel(benchmark::State& state)
+{
+    MixFixture f(state.range(0));
+    const float master = 0.9f;
+    float gains[STREAMS * STREAMS];
+
+    for (auto _ : state) {
+        std::fill(f.out.begin(), f.out.end(), 0.f);
+        for (size_t c = 0; c < f.channels.size(); ++c) {
+            for (unsigned int s = 0; s < STREAMS; ++s) {
+                for (unsigned int d = 0; d < STREAMS; ++d) {
+                    float gain = std::clamp(0.5f * f.balance[c] * ((d * 2.f) - 1) + 0.5f, 0.f, 1.f);
+                    gains[s * STREAMS + d] = gain * f.level[c] * master;
+                }
+            }
+            mixInterleaved(f.out.data(), STREAMS, f.channels[c].data(), STREAMS, gains, BLOCK_SIZE);
+        }
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * BLOCK_SIZE * f.channels.size());
+}
+
+BENCHMARK(BM_MixLegacy)->RangeMultiplier(2)->Range(1, 64);
+BENCHMARK(BM_MixKernel)->RangeMultiplier(2)->Range(1, 64);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,113 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "internal/worker/mixkernel.h"
+
+using namespace mu::audio;
+
+class MixKernelTests : public ::testing::Test
+{
+public:
+    static std::vector<float> makeSignal(size_t size, float seed)
+    {
+        std::vector<float> data(size);
+        for (size_t i = 0; i < size; ++i) {
+            data[i] = seed * static_cast<float>((i * 7919) % 201) / 100.f - seed;
+        }
+        return data;
+    }
+
+    static void checkAgainstScalar(unsigned int srcStreams, unsigned int destStreams, unsigned int sampleCount)
+    {
+        std::vector<float> src = makeSignal(sampleCount * srcStreams, 0.9f);
+        std::vector<float> gains = makeSignal(srcStreams * destStreams, 0.7f);
+
+        std::vector<float> expected = makeSignal(sampleCount * destStreams, 0.3f);
+        std::vector<float> actual = expected;
+
+        mixInterleavedScalar(expected.data(), destStreams, src.data(), srcStreams, gains.data(), sampleCount);
+        mixInterleaved(actual.data(), destStreams, src.data(), srcStreams, gains.data(), sampleCount);
+
+        for (size_t i = 0; i < expected.size(); ++i) {
+            ASSERT_NEAR(expected[i], actual[i], 1e-5f) << "index " << i;
+        }
+    }
+};
+
+TEST_F(MixKernelTests, MixInterleaved_MonoToStereo)
+{
+    //! CHECK Vector path gives the same result as scalar, including the tail
+    checkAgainstScalar(1, 2, 1024);
+    checkAgainstScalar(1, 2, 1021);
+    checkAgainstScalar(1, 2, 3);
+}
+
+TEST_F(MixKernelTests, MixInterleaved_StereoToStereo)
+{
+    checkAgainstScalar(2, 2, 1024);
+    checkAgainstScalar(2, 2, 1023);
+    checkAgainstScalar(2, 2, 1);
+}
+
+TEST_F(MixKernelTests, MixInterleaved_MonoToMono)
+{
+    checkAgainstScalar(1, 1, 1024);
+    checkAgainstScalar(1, 1, 1019);
+}
+
+TEST_F(MixKernelTests, MixInterleaved_Surround)
+{
+    //! CHECK Layouts without a vector path fall back to scalar
+    checkAgainstScalar(6, 2, 512);
+    checkAgainstScalar(2, 1, 511);
+}
+
+TEST_F(MixKernelTests, ApplyGain)
+{
+    //! GIVEN Buffer with size not a multiple of vector width
+
+    std::vector<float> data = makeSignal(1027, 1.f);
+    std::vector<float> expected = data;
+    for (float& v : expected) {
+        v *= 0.25f;
+    }
+
+    //! DO
+    applyGain(data.data(), 0.25f, data.size());
+
+    //! CHECK
+    EXPECT_EQ(data, expected);
+}
+
+TEST_F(MixKernelTests, MixPlanar)
+{
+    std::vector<float> src = makeSignal(1027, 1.f);
+    std::vector<float> dest = makeSignal(1027, 0.5f);
+    std::vector<float> expected = dest;
+    for (size_t i = 0; i < expected.size(); ++i) {
+        expected[i] += src[i] * 0.5f;
+    }
+
+    mixPlanar(dest.data(), src.data(), 0.5f, dest.size());
+
+    EXPECT_EQ(dest, expected);
+}
@@ -0,0 +1,124 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <vector>
+
+#include "internal/worker/renderpool.h"
+
+using namespace mu::audio;
+
+class RenderPoolTests : public ::testing::Test
+{
+public:
+    struct Job {
+        std::vector<std::atomic<int> > runs;
+
+        explicit Job(size_t taskCount)
+            : runs(taskCount) {}
+
+        static void task(void* context, size_t index)
+        {
+            static_cast<Job*>(context)->runs[index].fetch_add(1);
+        }
+
+        bool eachRunOnce() const
+        {
+            for (const std::atomic<int>& r : runs) {
+                if (r.load() != 1) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+};
+
+TEST_F(RenderPoolTests, Run_EachTaskOnce)
+{
+    RenderPool pool(4);
+
+    //! CHECK Every task of every job runs exactly once and run() returns after all of them,
+    //! also when jobs follow each other without a pause
+    for (size_t taskCount : { 1, 2, 3, 7, 16, 64, 5, 1, 33 }) {
+        for (int repeat = 0; repeat < 200; ++repeat) {
+            Job job(taskCount);
+            pool.run(&Job::task, &job, taskCount);
+            ASSERT_TRUE(job.eachRunOnce()) << "tasks " << taskCount << " repeat " << repeat;
+        }
+    }
+}
+
+TEST_F(RenderPoolTests, Run_WithoutThreads)
+{
+    RenderPool pool(0);
+    EXPECT_EQ(pool.threadCount(), 0);
+
+    //! CHECK The caller does all the work
+    Job job(10);
+    pool.run(&Job::task, &job, 10);
+    EXPECT_TRUE(job.eachRunOnce());
+}
+
+TEST_F(RenderPoolTests, Run_UsesThreads)
+{
+    RenderPool pool(3);
+
+    //! CHECK Slow tasks are spread over the threads, so they finish sooner than one after another
+    static constexpr auto TASK_TIME = std::chrono::milliseconds(20);
+    auto start = std::chrono::steady_clock::now();
+    pool.run([](void*, size_t) {
+        std::this_thread::sleep_for(TASK_TIME);
+    }, nullptr, 4);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_LT(elapsed, TASK_TIME * 4);
+}
+
+TEST_F(RenderPoolTests, Run_WakesParkedThreads)
+{
+    RenderPool pool(3);
+
+    //! CHECK Without spinning the idle threads are parked, the next job wakes them
+    for (int repeat = 0; repeat < 3; ++repeat) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+        static constexpr auto TASK_TIME = std::chrono::milliseconds(20);
+        auto start = std::chrono::steady_clock::now();
+        pool.run([](void*, size_t) {
+            std::this_thread::sleep_for(TASK_TIME);
+        }, nullptr, 4);
+        auto elapsed = std::chrono::steady_clock::now() - start;
+
+        EXPECT_LT(elapsed, TASK_TIME * 4);
+    }
+
+    //! CHECK Jobs are complete whether the threads park or spin between them
+    for (bool spinning : { false, true, false }) {
+        pool.setSpinning(spinning);
+        for (size_t taskCount : { 2, 5, 16 }) {
+            for (int repeat = 0; repeat < 200; ++repeat) {
+                Job job(taskCount);
+                pool.run(&Job::task, &job, taskCount);
+                ASSERT_TRUE(job.eachRunOnce()) << "tasks " << taskCount << " spinning " << spinning;
+            }
+        }
+    }
+}
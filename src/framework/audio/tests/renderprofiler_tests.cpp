@@ -0,0 +1,111 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "internal/worker/renderprofiler.h"
+
+using namespace mu::audio;
+
+class RenderProfilerTests : public ::testing::Test
+{
+public:
+    static constexpr std::chrono::nanoseconds DEADLINE { 1000000 };
+
+    static std::chrono::nanoseconds load(int percent)
+    {
+        return DEADLINE * percent / 100;
+    }
+};
+
+TEST_F(RenderProfilerTests, Stats_Percentiles)
+{
+    RenderProfiler profiler;
+
+    //! CHECK 100 blocks with loads of 1% .. 100%, the last one exactly on the deadline is not a miss
+    for (int percent = 1; percent <= 100; ++percent) {
+        profiler.push(load(percent), DEADLINE);
+    }
+    profiler.collect();
+
+    RenderProfiler::Stats stats = profiler.stats();
+    EXPECT_EQ(stats.blocks, 100);
+    EXPECT_EQ(stats.deadlineMisses, 0);
+    EXPECT_EQ(stats.dropped, 0);
+    EXPECT_NEAR(stats.p50, 50.f, 1.f);
+    EXPECT_NEAR(stats.p99, 99.f, 1.f);
+    EXPECT_FLOAT_EQ(stats.max, 100.f);
+
+    //! CHECK Loads above the histogram end in the last bucket, the max is exact
+    profiler.push(load(150), DEADLINE);
+    profiler.push(load(900), DEADLINE);
+    profiler.collect();
+
+    stats = profiler.stats();
+    EXPECT_EQ(stats.blocks, 102);
+    EXPECT_EQ(stats.deadlineMisses, 2);
+    EXPECT_FLOAT_EQ(stats.max, 900.f);
+
+    profiler.reset();
+    stats = profiler.stats();
+    EXPECT_EQ(stats.blocks, 0);
+    EXPECT_FLOAT_EQ(stats.p99, 0.f);
+    EXPECT_FLOAT_EQ(stats.max, 0.f);
+}
+
+TEST_F(RenderProfilerTests, Push_DropsWhenFull)
+{
+    RenderProfiler profiler;
+
+    //! CHECK A reader that is late loses the newest blocks, it does not block the producer
+    for (size_t i = 0; i < RenderProfiler::RING_SIZE + 10; ++i) {
+        profiler.push(load(10), DEADLINE);
+    }
+    profiler.collect();
+
+    RenderProfiler::Stats stats = profiler.stats();
+    EXPECT_EQ(stats.blocks, RenderProfiler::RING_SIZE);
+    EXPECT_EQ(stats.dropped, 10);
+
+    profiler.reset();
+    EXPECT_EQ(profiler.stats().dropped, 0);
+}
+
+TEST_F(RenderProfilerTests, Collect_WhileProducing)
+{
+    RenderProfiler profiler;
+    static constexpr size_t BLOCKS = 100000;
+
+    //! CHECK Every block is either collected or counted as dropped
+    std::thread producer([&profiler]() {
+        for (size_t i = 0; i < BLOCKS; ++i) {
+            profiler.push(load(static_cast<int>(i % 200)), DEADLINE);
+        }
+    });
+    for (int i = 0; i < 1000; ++i) {
+        profiler.collect();
+    }
+    producer.join();
+    profiler.collect();
+
+    RenderProfiler::Stats stats = profiler.stats();
+    EXPECT_EQ(stats.blocks + stats.dropped, BLOCKS);
+    EXPECT_LE(stats.max, 200.f);
+}
@@ -0,0 +1,196 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <list>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "internal/synthesizers/zerberus/internal/zoneindex.h"
+#include "internal/synthesizers/zerberus/internal/zerberus.h"
+#include "internal/synthesizers/zerberus/internal/sample.h"
+#include "internal/synthesizers/zerberus/internal/voice.h"
+
+using namespace mu::zerberus;
+
+//! NOTE Compares the zone lookup of a note-on through the index with the former
+//! scan of all zones, for a sampled piano with velocity layers, round robins
+//! and release samples, playing a dense passage
+
+static constexpr int PIANO_KEYS = 88;
+static constexpr int PIANO_KEY_LO = 21;
+static constexpr int ROUND_ROBINS = 4;
+
+struct PianoFixture {
+    std::list<Zone*> zones;
+    ZoneIndex index;
+
+    struct NoteEvent {
+        int key = 0;
+        int velo = 0;
+        Trigger trigger = Trigger::ATTACK;
+    };
+    std::vector<NoteEvent> passage;
+
+    PianoFixture(int velocityLayers)
+    {
+        const int layerSize = 128 / velocityLayers;
+        for (int key = PIANO_KEY_LO; key < PIANO_KEY_LO + PIANO_KEYS; ++key) {
+            for (int layer = 0; layer < velocityLayers; ++layer) {
+                for (int rr = 0; rr < ROUND_ROBINS; ++rr) {
+                    addZone(Trigger::ATTACK, key, layer * layerSize, (layer + 1) * layerSize - 1);
+                }
+            }
+            addZone(Trigger::RELEASE, key, 0, 127);
+        }
+        index.build(zones);
+
+        //! NOTE Ten note chords on every sixteenth, with their releases
+        std::mt19937 gen(42);
+        std::uniform_int_distribution<int> key(PIANO_KEY_LO, PIANO_KEY_LO + PIANO_KEYS - 1);
+        std::uniform_int_distribution<int> velo(1, 127);
+        for (int chord = 0; chord < 256; ++chord) {
+            for (int n = 0; n < 10; ++n) {
+                NoteEvent e { key(gen), velo(gen), Trigger::ATTACK };
+                passage.push_back(e);
+                e.trigger = Trigger::RELEASE;
+                passage.push_back(e);
+            }
+        }
+    }
+
+    ~PianoFixture()
+    {
+        for (Zone* z : zones) {
+            delete z;
+        }
+    }
+
+    void addZone(Trigger trigger, int key, int veloLo, int veloHi)
+    {
+        Zone* z = new Zone();
+        z->trigger = trigger;
+        z->keyLo = static_cast<char>(key);
+        z->keyHi = static_cast<char>(key);
+        z->veloLo = static_cast<char>(veloLo);
+        z->veloHi = static_cast<char>(veloHi);
+        zones.push_back(z);
+    }
+};
+
+static void BM_TriggerLinearScan(benchmark::State& state)
+{
+    PianoFixture f(state.range(0));
+
+    for (auto _ : state) {
+        for (const PianoFixture::NoteEvent& e : f.passage) {
+            int matched = 0;
+            for (const Zone* z : f.zones) {
+                if (e.key >= z->keyLo && e.key <= z->keyHi && e.velo >= z->veloLo && e.velo <= z->veloHi
+                    && e.trigger == z->trigger) {
+                    ++matched;
+                }
+            }
+            benchmark::DoNotOptimize(matched);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * f.passage.size());
+    state.counters["zones"] = f.zones.size();
+}
+
+static void BM_TriggerZoneIndex(benchmark::State& state)
+{
+    PianoFixture f(state.range(0));
+
+    for (auto _ : state) {
+        for (const PianoFixture::NoteEvent& e : f.passage) {
+            int matched = 0;
+            for (const Zone* z : f.index.candidates(e.trigger, e.key, e.velo)) {
+                if (e.key >= z->keyLo && e.key <= z->keyHi && e.velo >= z->veloLo && e.velo <= z->veloHi
+                    && e.trigger == z->trigger) {
+                    ++matched;
+                }
+            }
+            benchmark::DoNotOptimize(matched);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * f.passage.size());
+    state.counters["zones"] = f.zones.size();
+}
+
+BENCHMARK(BM_TriggerLinearScan)->RangeMultiplier(2)->Range(1, 32);
+BENCHMARK(BM_TriggerZoneIndex)->RangeMultiplier(2)->Range(1, 32);
+
+//! NOTE Renders held notes of a looping stereo sample through the lowpass filter,
+//! as a sustained chord would, in audio buffers of 512 frames at 48 kHz.
+//! voices_per_core is the number of such voices one core renders in realtime
+
+static constexpr int RENDER_SAMPLE_RATE = 48000;
+static constexpr int RENDER_BUFFER_FRAMES = 512;
+
+static void BM_VoiceRender(benchmark::State& state)
+{
+    const int voiceCount = state.range(0);
+    const int channels = 2;
+    const long long frames = RENDER_SAMPLE_RATE * 4;
+
+    Zerberus zerberus;
+    zerberus.setSampleRate(RENDER_SAMPLE_RATE);
+
+    short* data = new short[(frames + 3) * channels];
+    for (long long i = 0; i < (frames + 3) * channels; ++i) {
+        data[i] = static_cast<short>(16000 * std::sin(i * 0.013));
+    }
+
+    Zone zone;
+    zone.sample = new Sample(channels, data, frames, RENDER_SAMPLE_RATE);
+    zone.isCutoffDefined = true;
+    zone.cutoff = 4000;
+    zone.fil_veltrack = 0;
+    zone.pitchKeytrack = 1.0;
+    zone.loopMode = LoopMode::CONTINUOUS;
+    zone.loopStart = frames / 4;
+    zone.loopEnd = frames / 2;
+
+    std::vector<std::unique_ptr<Voice> > voices;
+    for (int i = 0; i < voiceCount; ++i) {
+        voices.emplace_back(new Voice(&zerberus));
+        voices.back()->start(zerberus.channel(0), 36 + i % 48, 100, &zone, 0);
+    }
+
+    std::vector<float> buffer(RENDER_BUFFER_FRAMES * 2);
+    for (auto _ : state) {
+        std::fill(buffer.begin(), buffer.end(), 0.f);
+        for (auto& voice : voices) {
+            voice->process(RENDER_BUFFER_FRAMES, buffer.data());
+        }
+        benchmark::DoNotOptimize(buffer.data());
+    }
+
+    const double renderedSeconds = double(state.iterations()) * RENDER_BUFFER_FRAMES / RENDER_SAMPLE_RATE;
+    state.counters["voices_per_core"] = benchmark::Counter(renderedSeconds * voiceCount, benchmark::Counter::kIsRate);
+}
+
+BENCHMARK(BM_VoiceRender)->RangeMultiplier(4)->Range(16, 256);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,144 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include <gtest/gtest.h>
+
+#include <list>
+#include <random>
+#include <vector>
+
+#include "internal/synthesizers/zerberus/internal/zoneindex.h"
+
+using namespace mu::zerberus;
+
+class ZoneIndexTests : public ::testing::Test
+{
+public:
+    void TearDown() override
+    {
+        for (Zone* z : m_zones) {
+            delete z;
+        }
+        m_zones.clear();
+    }
+
+    Zone* addZone(Trigger trigger, int keyLo, int keyHi, int veloLo, int veloHi)
+    {
+        Zone* z = new Zone();
+        z->trigger = trigger;
+        z->keyLo = static_cast<char>(keyLo);
+        z->keyHi = static_cast<char>(keyHi);
+        z->veloLo = static_cast<char>(veloLo);
+        z->veloHi = static_cast<char>(veloHi);
+        m_zones.push_back(z);
+        return z;
+    }
+
+    void addRandomZones(int count)
+    {
+        std::mt19937 gen(12345);
+        std::uniform_int_distribution<int> midi(0, 127);
+        std::uniform_int_distribution<int> trigger(int(Trigger::ATTACK), int(Trigger::CC));
+        for (int i = 0; i < count; ++i) {
+            int key1 = midi(gen), key2 = midi(gen);
+            int velo1 = midi(gen), velo2 = midi(gen);
+            addZone(Trigger(trigger(gen)), std::min(key1, key2), std::max(key1, key2),
+                    std::min(velo1, velo2), std::max(velo1, velo2));
+        }
+    }
+
+    //! NOTE What Zone::match() checks before controllers, random and sequence
+    std::vector<Zone*> linearScan(Trigger trigger, int key, int velo) const
+    {
+        std::vector<Zone*> result;
+        for (Zone* z : m_zones) {
+            if (z->trigger == trigger
+                && (trigger == Trigger::CC
+                    || (key >= z->keyLo && key <= z->keyHi && velo >= z->veloLo && velo <= z->veloHi))) {
+                result.push_back(z);
+            }
+        }
+        return result;
+    }
+
+    std::list<Zone*> m_zones;
+};
+
+TEST_F(ZoneIndexTests, Candidates_SameAsLinearScan)
+{
+    //! GIVEN Zones with random ranges and triggers
+    addRandomZones(500);
+
+    ZoneIndex index;
+    index.build(m_zones);
+
+    //! CHECK Every note gets the zones of the linear scan, in the instrument order
+    for (int t = int(Trigger::ATTACK); t < int(Trigger::CC); ++t) {
+        for (int key = 0; key < 128; ++key) {
+            for (int velo = 0; velo < 128; ++velo) {
+                ASSERT_EQ(index.candidates(Trigger(t), key, velo), linearScan(Trigger(t), key, velo))
+                    << "trigger " << t << " key " << key << " velo " << velo;
+            }
+        }
+    }
+}
+
+TEST_F(ZoneIndexTests, Candidates_ControllerTrigger)
+{
+    //! GIVEN Zones triggered by notes and by controllers
+    addZone(Trigger::ATTACK, 0, 127, 0, 127);
+    Zone* cc1 = addZone(Trigger::CC, 10, 20, 0, 127);
+    Zone* cc2 = addZone(Trigger::CC, 0, 127, 0, 127);
+
+    ZoneIndex index;
+    index.build(m_zones);
+
+    //! CHECK Controllers don't depend on key and velocity
+    EXPECT_EQ(index.candidates(Trigger::CC, -1, -1), std::vector<Zone*>({ cc1, cc2 }));
+}
+
+TEST_F(ZoneIndexTests, Candidates_OutOfRange)
+{
+    addZone(Trigger::ATTACK, 0, 127, 0, 127);
+
+    ZoneIndex index;
+
+    //! CHECK Nothing before the index is built
+    EXPECT_TRUE(index.candidates(Trigger::ATTACK, 60, 100).empty());
+
+    index.build(m_zones);
+    EXPECT_EQ(index.candidates(Trigger::ATTACK, 60, 100).size(), 1u);
+    EXPECT_TRUE(index.candidates(Trigger::ATTACK, -1, 100).empty());
+    EXPECT_TRUE(index.candidates(Trigger::ATTACK, 128, 100).empty());
+    EXPECT_TRUE(index.candidates(Trigger::ATTACK, 60, 128).empty());
+    EXPECT_TRUE(index.candidates(Trigger::RELEASE, 60, 100).empty());
+}
+
+TEST_F(ZoneIndexTests, Build_ControllerChecks)
+{
+    //! GIVEN A zone playing only with the sustain pedal down
+    Zone* z = addZone(Trigger::ATTACK, 0, 127, 0, 127);
+    z->useCC = true;
+    z->locc[64] = 64;
+
+    ZoneIndex index;
+    index.build(m_zones);
+
+    //! CHECK Only the restricted controller is checked on match
+    EXPECT_EQ(z->ccChecks, std::vector<int>({ 64 }));
+}
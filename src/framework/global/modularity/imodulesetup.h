@@ -32,6 +32,10 @@ public:
 
     virtual std::string moduleName() const = 0;
 
+    //! NOTE Modules which are not needed to convert files return false,
+    //! they are not set up at all in the converter run mode
+    virtual bool isUsedByConverter() const { return true; }
+
     virtual void registerExports() {}
     virtual void resolveImports() {}
 
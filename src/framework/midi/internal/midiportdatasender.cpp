@@ -44,6 +44,7 @@ bool MidiPortDataSender::sendEvents(tick_t fromTick, tick_t toTick)
     if (m_stream->isStreamingAllowed && !m_isStreamConnected) {
         //! NOTE Requests are made in the sequencer, here we only listen and receive data (in sync with the sequencer)
         m_stream->stream.onReceive(this, [this](const Chunk& chunk) { onChunkReceived(chunk); });
+        m_stream->replace.onReceive(this, [this](const Chunk& chunk) { m_midiData.replaceChunk(chunk); });
         m_isStreamConnected = true;
     }
 
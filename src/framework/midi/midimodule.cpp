@@ -63,6 +63,11 @@ std::string MidiModule::moduleName() const
     return "midi";
 }
 
+bool MidiModule::isUsedByConverter() const
+{
+    return false;
+}
+
 void MidiModule::registerExports()
 {
     framework::ioc()->registerExport<IMidiConfiguration>(moduleName(), new MidiConfiguration());
@@ -27,6 +27,7 @@ class MidiModule : public framework::IModuleSetup
 public:
 
     std::string moduleName() const override;
+    bool isUsedByConverter() const override;
 
     void registerExports() override;
     void registerUiTypes() override;
@@ -27,6 +27,7 @@
 #include <map>
 #include <functional>
 #include <set>
+#include <iterator>
 #include <cassert>
 #include "async/channel.h"
 #include "midievent.h"
@@ -96,6 +97,19 @@ struct MidiData {
         return evts;
     }
 
+    //! NOTE A new render of an edited part of the score, it takes the place of the chunks it overlaps
+    void replaceChunk(const Chunk& chunk)
+    {
+        auto it = chunks.lower_bound(chunk.beginTick);
+        if (it != chunks.begin() && std::prev(it)->second.endTick > chunk.beginTick) {
+            --it;
+        }
+        while (it != chunks.end() && it->first < chunk.endTick) {
+            it = chunks.erase(it);
+        }
+        chunks.insert({ chunk.beginTick, chunk });
+    }
+
     tick_t lastChunksTick() const
     {
         if (chunks.empty()) {
@@ -130,8 +144,9 @@ struct MidiStream {
 
     bool isStreamingAllowed = false;
     tick_t lastTick = 0;
-    async::Channel<Chunk> stream;
+    async::Channel<Chunk> stream;       //! NOTE Answers to the requests
     async::Channel<tick_t> request;
+    async::Channel<Chunk> replace;      //! NOTE New renders of the chunks already streamed
 
     bool isValid() const { return initData.isValid(); }
 };
@@ -28,6 +28,11 @@ std::string NetworkModule::moduleName() const
     return "network";
 }
 
+bool NetworkModule::isUsedByConverter() const
+{
+    return false;
+}
+
 void NetworkModule::registerExports()
 {
     framework::ioc()->registerExport<INetworkManagerCreator>(moduleName(), new NetworkManagerCreator());
@@ -26,6 +26,7 @@ class NetworkModule : public framework::IModuleSetup
 {
 public:
     std::string moduleName() const override;
+    bool isUsedByConverter() const override;
     void registerExports() override;
 };
 }
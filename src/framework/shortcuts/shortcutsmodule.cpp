@@ -46,6 +46,11 @@ std::string ShortcutsModule::moduleName() const
     return "shortcuts";
 }
 
+bool ShortcutsModule::isUsedByConverter() const
+{
+    return false;
+}
+
 void ShortcutsModule::registerExports()
 {
     ioc()->registerExport<IShortcutsRegister>(moduleName(), m_shortcutsRegister);
@@ -53,6 +53,11 @@ std::string TelemetryModule::moduleName() const
     return "telemetry";
 }
 
+bool TelemetryModule::isUsedByConverter() const
+{
+    return false;
+}
+
 void TelemetryModule::registerResources()
 {
     telemetry_init_qrc();
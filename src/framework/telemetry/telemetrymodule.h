@@ -27,6 +27,7 @@ class TelemetryModule : public mu::framework::IModuleSetup
 {
 public:
     std::string moduleName() const override;
+    bool isUsedByConverter() const override;
 
     void registerExports() override;
     void resolveImports() override;
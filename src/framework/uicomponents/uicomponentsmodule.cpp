@@ -24,6 +24,11 @@ std::string UiComponentsModule::moduleName() const
     return "uicomponents";
 }
 
+bool UiComponentsModule::isUsedByConverter() const
+{
+    return false;
+}
+
 void UiComponentsModule::registerResources()
 {
     uicomponents_init_qrc();
@@ -28,6 +28,7 @@ class UiComponentsModule : public framework::IModuleSetup
 public:
 
     std::string moduleName() const override;
+    bool isUsedByConverter() const override;
 
     void registerResources() override;
     void registerUiTypes() override;
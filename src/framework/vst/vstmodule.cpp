@@ -43,6 +43,11 @@ std::string VSTModule::moduleName() const
     return "vst";
 }
 
+bool VSTModule::isUsedByConverter() const
+{
+    return false;
+}
+
 void VSTModule::registerExports()
 {
     framework::ioc()->registerExport<VSTScanner>(moduleName(), s_vstScanner);
@@ -27,14 +27,23 @@
 #include "internal/oggwriter.h"
 #include "internal/flacwriter.h"
 
+#include "internal/audioexportconfiguration.h"
+
 using namespace mu::iex::audioexport;
 using namespace mu::notation;
 
+static std::shared_ptr<AudioExportConfiguration> s_configuration = std::make_shared<AudioExportConfiguration>();
+
 std::string AudioExportModule::moduleName() const
 {
     return "iex_audioexport";
 }
 
+void AudioExportModule::registerExports()
+{
+    framework::ioc()->registerExport<IAudioExportConfiguration>(moduleName(), s_configuration);
+}
+
 void AudioExportModule::resolveImports()
 {
     auto writers = framework::ioc()->resolve<INotationWritersRegister>(moduleName());
@@ -45,3 +54,8 @@ void AudioExportModule::resolveImports()
         writers->reg({ "flac" }, std::make_shared<FlacWriter>());
     }
 }
+
+void AudioExportModule::onInit(const framework::IApplication::RunMode&)
+{
+    s_configuration->init();
+}
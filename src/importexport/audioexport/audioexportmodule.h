@@ -27,7 +27,9 @@ class AudioExportModule : public framework::IModuleSetup
 public:
 
     std::string moduleName() const override;
+    void registerExports() override;
     void resolveImports() override;
+    void onInit(const framework::IApplication::RunMode& mode) override;
 };
 }
 
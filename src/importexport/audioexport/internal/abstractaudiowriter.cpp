@@ -0,0 +1,82 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include "abstractaudiowriter.h"
+
+#include "log.h"
+#include "notation/inotationplayback.h"
+
+using namespace mu::iex::audioexport;
+using namespace mu::notation;
+using namespace mu::audio;
+
+mu::Ret AbstractAudioWriter::write(const INotationPtr notation, system::IODevice& destinationDevice, const Options&)
+{
+    TRACEFUNC;
+
+    IF_ASSERT_FAILED(notation) {
+        return make_ret(Ret::Code::UnknownError);
+    }
+
+    INotationPlaybackPtr playback = notation->playback();
+    IF_ASSERT_FAILED(playback) {
+        return make_ret(Ret::Code::UnknownError);
+    }
+
+    if (!offlineRenderer()) {
+        return make_ret(Ret::Code::NotSupported);
+    }
+
+    IOfflineRenderer::Spec spec;
+    spec.sampleRate = static_cast<unsigned int>(configuration()->exportSampleRate());
+
+    IOfflineRenderer::Source source;
+    source.initData = playback->offlineMidiData();
+    source.lastTick = playback->offlineLastTick();
+    source.chunkRequest = [playback](midi::tick_t fromTick) {
+        return playback->offlineMidiChunk(fromTick);
+    };
+
+    Ret ret = beginEncode(destinationDevice, spec.sampleRate);
+    if (!ret) {
+        return ret;
+    }
+
+    m_aborted = false;
+    offlineRenderer()->progress().onReceive(this, [this](const framework::Progress& progress) {
+        m_progress.send(progress);
+    });
+
+    ret = offlineRenderer()->render(source, [this](const float* data, unsigned int sampleCount) {
+        return !m_aborted && encode(data, sampleCount);
+    }, spec);
+
+    offlineRenderer()->progress().resetOnReceive(this);
+
+    Ret endRet = endEncode();
+    if (!ret) {
+        return m_aborted ? make_ret(Ret::Code::Cancel) : ret;
+    }
+
+    return endRet;
+}
+
+void AbstractAudioWriter::abort()
+{
+    m_aborted = true;
+}
@@ -0,0 +1,55 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_IMPORTEXPORT_ABSTRACTAUDIOWRITER_H
+#define MU_IMPORTEXPORT_ABSTRACTAUDIOWRITER_H
+
+#include <atomic>
+
+#include "notation/abstractnotationwriter.h"
+#include "modularity/ioc.h"
+#include "async/asyncable.h"
+#include "audio/iofflinerenderer.h"
+
+#include "../iaudioexportconfiguration.h"
+
+namespace mu::iex::audioexport {
+//! NOTE Renders the notation with the offline renderer and streams
+//! the encoded blocks to the device, the whole PCM is never kept in memory
+class AbstractAudioWriter : public notation::AbstractNotationWriter, public async::Asyncable
+{
+    INJECT(iex_audioexport, audio::IOfflineRenderer, offlineRenderer)
+    INJECT(iex_audioexport, IAudioExportConfiguration, configuration)
+
+public:
+    Ret write(const notation::INotationPtr notation, system::IODevice& destinationDevice, const Options& options = Options()) override;
+    void abort() override;
+
+protected:
+    static constexpr unsigned int AUDIO_CHANNELS = 2;
+
+    virtual Ret beginEncode(system::IODevice& device, unsigned int sampleRate) = 0;
+    virtual bool encode(const float* data, unsigned int sampleCount) = 0;
+    virtual Ret endEncode() = 0;
+
+private:
+    std::atomic<bool> m_aborted = false;
+};
+}
+
+#endif // MU_IMPORTEXPORT_ABSTRACTAUDIOWRITER_H
@@ -0,0 +1,43 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include "audioexportconfiguration.h"
+
+#include "settings.h"
+
+using namespace mu::framework;
+using namespace mu::iex::audioexport;
+
+static const Settings::Key EXPORT_SAMPLE_RATE_KEY("iex_audioexport", "export/audio/sampleRate");
+static const Settings::Key EXPORT_MP3_BITRATE_KEY("iex_audioexport", "export/mp3/bitRate");
+
+void AudioExportConfiguration::init()
+{
+    settings()->setDefaultValue(EXPORT_SAMPLE_RATE_KEY, Val(44100));
+    settings()->setDefaultValue(EXPORT_MP3_BITRATE_KEY, Val(128));
+}
+
+int AudioExportConfiguration::exportSampleRate() const
+{
+    return settings()->value(EXPORT_SAMPLE_RATE_KEY).toInt();
+}
+
+int AudioExportConfiguration::exportMp3Bitrate() const
+{
+    return settings()->value(EXPORT_MP3_BITRATE_KEY).toInt();
+}
@@ -19,18 +19,29 @@
 
 #include "mp3writer.h"
 
+#include <algorithm>
+
 #include "log.h"
 
 using namespace mu::iex::audioexport;
-using namespace mu::framework;
+using namespace mu::system;
 
-mu::Ret Mp3Writer::write(const notation::INotationPtr notation, system::IODevice& destinationDevice, const Options& options)
+mu::Ret Mp3Writer::beginEncode(IODevice& device, unsigned int sampleRate)
 {
-    UNUSED(notation)
-    UNUSED(destinationDevice)
-    UNUSED(options)
+    //! NOTE libsndfile has no bitrate setting, map the configured bitrate
+    //! range 32..320 kbps onto its compression level
+    int bitrate = std::clamp(configuration()->exportMp3Bitrate(), 32, 320);
+    m_encoder.setCompressionLevel(1.0 - (bitrate - 32) / double(320 - 32));
+
+    return m_encoder.open(device, sampleRate, AUDIO_CHANNELS);
+}
 
-    NOT_IMPLEMENTED;
+bool Mp3Writer::encode(const float* data, unsigned int sampleCount)
+{
+    return m_encoder.write(data, sampleCount);
+}
 
-    return make_ret(Ret::Code::NotImplemented);
+mu::Ret Mp3Writer::endEncode()
+{
+    return m_encoder.close();
 }
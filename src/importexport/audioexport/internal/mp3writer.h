@@ -20,13 +20,19 @@
 #ifndef MU_IMPORTEXPORT_MP3WRITER_H
 #define MU_IMPORTEXPORT_MP3WRITER_H
 
-#include "notation/abstractnotationwriter.h"
+#include "abstractaudiowriter.h"
+#include "sndfileencoder.h"
 
 namespace mu::iex::audioexport {
-class Mp3Writer : public notation::AbstractNotationWriter
+class Mp3Writer : public AbstractAudioWriter
 {
-public:
-    Ret write(const notation::INotationPtr notation, system::IODevice& destinationDevice, const Options& options = Options()) override;
+protected:
+    Ret beginEncode(system::IODevice& device, unsigned int sampleRate) override;
+    bool encode(const float* data, unsigned int sampleCount) override;
+    Ret endEncode() override;
+
+private:
+    SndFileEncoder m_encoder { SndFileEncoder::Format::Mp3 };
 };
 }
 
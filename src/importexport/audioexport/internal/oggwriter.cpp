@@ -24,13 +24,17 @@
 using namespace mu::iex::audioexport;
 using namespace mu::system;
 
-mu::Ret OggWriter::write(const notation::INotationPtr notation, IODevice& destinationDevice, const Options& options)
+mu::Ret OggWriter::beginEncode(IODevice& device, unsigned int sampleRate)
 {
-    UNUSED(notation)
-    UNUSED(destinationDevice)
-    UNUSED(options)
+    return m_encoder.open(device, sampleRate, AUDIO_CHANNELS);
+}
 
-    NOT_IMPLEMENTED;
+bool OggWriter::encode(const float* data, unsigned int sampleCount)
+{
+    return m_encoder.write(data, sampleCount);
+}
 
-    return make_ret(Ret::Code::NotImplemented);
+mu::Ret OggWriter::endEncode()
+{
+    return m_encoder.close();
 }
@@ -0,0 +1,186 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include "sndfileencoder.h"
+
+#include <cstring>
+
+#include <sndfile.h>
+
+#include "log.h"
+
+using namespace mu::iex::audioexport;
+using namespace mu::system;
+
+//! NOTE MPEG encoding exists since libsndfile 1.1.0, the values are declared
+//! here to build with older headers, sf_format_check fails at runtime there
+static constexpr int MU_SF_FORMAT_MPEG = 0x230000;
+static constexpr int MU_SF_FORMAT_MPEG_LAYER_III = 0x0082;
+
+struct mu::iex::audioexport::SndFileHandle {
+    SNDFILE* sf = nullptr;
+    IODevice* device = nullptr;
+    qint64 startPos = 0;
+};
+
+static sf_count_t deviceLength(void* userData)
+{
+    auto h = static_cast<SndFileHandle*>(userData);
+    return h->device->size() - h->startPos;
+}
+
+static sf_count_t deviceSeek(sf_count_t offset, int whence, void* userData)
+{
+    auto h = static_cast<SndFileHandle*>(userData);
+    qint64 pos = 0;
+    switch (whence) {
+    case SEEK_SET: pos = h->startPos + offset;
+        break;
+    case SEEK_CUR: pos = h->device->pos() + offset;
+        break;
+    case SEEK_END: pos = h->device->size() + offset;
+        break;
+    }
+
+    if (!h->device->seek(pos)) {
+        return -1;
+    }
+    return h->device->pos() - h->startPos;
+}
+
+static sf_count_t deviceRead(void* ptr, sf_count_t count, void* userData)
+{
+    auto h = static_cast<SndFileHandle*>(userData);
+    return h->device->read(static_cast<char*>(ptr), count);
+}
+
+static sf_count_t deviceWrite(const void* ptr, sf_count_t count, void* userData)
+{
+    auto h = static_cast<SndFileHandle*>(userData);
+    return h->device->write(static_cast<const char*>(ptr), count);
+}
+
+static sf_count_t deviceTell(void* userData)
+{
+    auto h = static_cast<SndFileHandle*>(userData);
+    return h->device->pos() - h->startPos;
+}
+
+static SF_VIRTUAL_IO s_deviceIO = {
+    deviceLength,
+    deviceSeek,
+    deviceRead,
+    deviceWrite,
+    deviceTell
+};
+
+static int sndFileFormat(SndFileEncoder::Format format)
+{
+    switch (format) {
+    case SndFileEncoder::Format::Flac: return SF_FORMAT_FLAC | SF_FORMAT_PCM_16;
+    case SndFileEncoder::Format::OggVorbis: return SF_FORMAT_OGG | SF_FORMAT_VORBIS;
+    case SndFileEncoder::Format::Mp3: return MU_SF_FORMAT_MPEG | MU_SF_FORMAT_MPEG_LAYER_III;
+    }
+    return 0;
+}
+
+SndFileEncoder::SndFileEncoder(Format format)
+    : m_format(format)
+{
+}
+
+SndFileEncoder::~SndFileEncoder()
+{
+    close();
+}
+
+void SndFileEncoder::setCompressionLevel(double level)
+{
+    m_compressionLevel = level;
+}
+
+mu::Ret SndFileEncoder::open(IODevice& device, unsigned int sampleRate, unsigned int channels)
+{
+    IF_ASSERT_FAILED(!m_handle) {
+        close();
+    }
+
+    SF_INFO info;
+    memset(&info, 0, sizeof(info));
+    info.samplerate = static_cast<int>(sampleRate);
+    info.channels = static_cast<int>(channels);
+    info.format = sndFileFormat(m_format);
+
+    if (!sf_format_check(&info)) {
+        LOGE() << "format not supported by libsndfile: " << info.format;
+        return make_ret(Ret::Code::NotSupported);
+    }
+
+    m_handle = new SndFileHandle();
+    m_handle->device = &device;
+    m_handle->startPos = device.pos();
+    m_handle->sf = sf_open_virtual(&s_deviceIO, SFM_WRITE, &info, m_handle);
+
+    if (!m_handle->sf) {
+        std::string err = sf_strerror(nullptr);
+        LOGE() << "failed open encoder: " << err;
+        delete m_handle;
+        m_handle = nullptr;
+        return make_ret(Ret::Code::InternalError, err);
+    }
+
+    if (m_compressionLevel >= 0.0) {
+        sf_command(m_handle->sf, SFC_SET_COMPRESSION_LEVEL, &m_compressionLevel, sizeof(double));
+    }
+
+    sf_command(m_handle->sf, SFC_SET_CLIPPING, nullptr, SF_TRUE);
+
+    return make_ret(Ret::Code::Ok);
+}
+
+bool SndFileEncoder::write(const float* data, unsigned int frames)
+{
+    IF_ASSERT_FAILED(m_handle) {
+        return false;
+    }
+
+    sf_count_t written = sf_writef_float(m_handle->sf, data, frames);
+    if (written != static_cast<sf_count_t>(frames)) {
+        LOGE() << "failed write: " << sf_strerror(m_handle->sf);
+        return false;
+    }
+
+    return true;
+}
+
+mu::Ret SndFileEncoder::close()
+{
+    if (!m_handle) {
+        return make_ret(Ret::Code::Ok);
+    }
+
+    int err = sf_close(m_handle->sf);
+    delete m_handle;
+    m_handle = nullptr;
+
+    if (err != 0) {
+        return make_ret(Ret::Code::InternalError, sf_error_number(err));
+    }
+
+    return make_ret(Ret::Code::Ok);
+}
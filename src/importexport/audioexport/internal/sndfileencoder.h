@@ -0,0 +1,55 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_IMPORTEXPORT_SNDFILEENCODER_H
+#define MU_IMPORTEXPORT_SNDFILEENCODER_H
+
+#include "ret.h"
+#include "system/iodevice.h"
+
+namespace mu::iex::audioexport {
+struct SndFileHandle;
+
+//! NOTE Streams float samples to a device through libsndfile virtual io
+class SndFileEncoder
+{
+public:
+    enum class Format {
+        Flac,
+        OggVorbis,
+        Mp3
+    };
+
+    SndFileEncoder(Format format);
+    ~SndFileEncoder();
+
+    //! 0.0 - best quality (highest bitrate), 1.0 - smallest size
+    void setCompressionLevel(double level);
+
+    Ret open(system::IODevice& device, unsigned int sampleRate, unsigned int channels);
+    bool write(const float* data, unsigned int frames);
+    Ret close();
+
+private:
+    Format m_format = Format::Flac;
+    double m_compressionLevel = -1.0;
+    SndFileHandle* m_handle = nullptr;
+};
+}
+
+#endif // MU_IMPORTEXPORT_SNDFILEENCODER_H
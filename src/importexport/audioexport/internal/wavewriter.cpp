@@ -19,18 +19,109 @@
 
 #include "wavewriter.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <QtEndian>
+
 #include "log.h"
 
 using namespace mu::iex::audioexport;
-using namespace mu::framework;
+using namespace mu::system;
+
+static constexpr uint16_t BITS_PER_SAMPLE = 16;
+static constexpr uint32_t HEADER_SIZE = 44;
+
+//! NOTE Size for the streams that can't be rewound, readers treat it as "up to the end of file"
+static constexpr uint32_t UNKNOWN_SIZE = std::numeric_limits<uint32_t>::max();
+
+template<typename T>
+static void appendLE(QByteArray& ba, T value)
+{
+    T le = qToLittleEndian(value);
+    ba.append(reinterpret_cast<const char*>(&le), sizeof(T));
+}
+
+bool WaveWriter::writeHeader(uint32_t dataSize)
+{
+    const uint16_t blockAlign = AUDIO_CHANNELS * BITS_PER_SAMPLE / 8;
+    const uint32_t riffSize = dataSize == UNKNOWN_SIZE ? UNKNOWN_SIZE : dataSize + HEADER_SIZE - 8;
+
+    QByteArray header;
+    header.reserve(HEADER_SIZE);
+    header.append("RIFF", 4);
+    appendLE<uint32_t>(header, riffSize);
+    header.append("WAVE", 4);
+
+    header.append("fmt ", 4);
+    appendLE<uint32_t>(header, 16);                         // chunk size
+    appendLE<uint16_t>(header, 1);                          // PCM
+    appendLE<uint16_t>(header, AUDIO_CHANNELS);
+    appendLE<uint32_t>(header, m_sampleRate);
+    appendLE<uint32_t>(header, m_sampleRate * blockAlign);  // byte rate
+    appendLE<uint16_t>(header, blockAlign);
+    appendLE<uint16_t>(header, BITS_PER_SAMPLE);
+
+    header.append("data", 4);
+    appendLE<uint32_t>(header, dataSize);
+
+    return m_device->write(header) == header.size();
+}
 
-mu::Ret WaveWriter::write(const notation::INotationPtr notation, system::IODevice& destinationDevice, const Options& options)
+mu::Ret WaveWriter::beginEncode(IODevice& device, unsigned int sampleRate)
 {
-    UNUSED(notation)
-    UNUSED(destinationDevice)
-    UNUSED(options)
+    m_device = &device;
+    m_headerPos = device.pos();
+    m_sampleRate = sampleRate;
+    m_dataSize = 0;
+
+    if (!writeHeader(device.isSequential() ? UNKNOWN_SIZE : 0)) {
+        return make_ret(Ret::Code::InternalError, device.errorString().toStdString());
+    }
+
+    return make_ret(Ret::Code::Ok);
+}
+
+bool WaveWriter::encode(const float* data, unsigned int sampleCount)
+{
+    size_t count = static_cast<size_t>(sampleCount) * AUDIO_CHANNELS;
+    m_pcm.resize(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        float v = std::clamp(data[i], -1.f, 1.f);
+        m_pcm[i] = qToLittleEndian(static_cast<int16_t>(std::lrint(v * std::numeric_limits<int16_t>::max())));
+    }
+
+    qint64 bytes = static_cast<qint64>(count * sizeof(int16_t));
+    if (m_device->write(reinterpret_cast<const char*>(m_pcm.data()), bytes) != bytes) {
+        LOGE() << "failed write: " << m_device->errorString();
+        return false;
+    }
+
+    m_dataSize += bytes;
+    return true;
+}
+
+mu::Ret WaveWriter::endEncode()
+{
+    IF_ASSERT_FAILED(m_device) {
+        return make_ret(Ret::Code::InternalError);
+    }
+
+    Ret ret = make_ret(Ret::Code::Ok);
+
+    //! NOTE Now the sizes are known, rewrite the header if possible
+    if (!m_device->isSequential()) {
+        qint64 endPos = m_device->pos();
+        uint32_t dataSize = m_dataSize + HEADER_SIZE > UNKNOWN_SIZE ? UNKNOWN_SIZE : static_cast<uint32_t>(m_dataSize);
+        if (!m_device->seek(m_headerPos) || !writeHeader(dataSize) || !m_device->seek(endPos)) {
+            ret = make_ret(Ret::Code::InternalError, m_device->errorString().toStdString());
+        }
+    }
 
-    NOT_IMPLEMENTED;
+    m_device = nullptr;
+    m_pcm.clear();
 
-    return make_ret(Ret::Code::NotImplemented);
+    return ret;
 }
@@ -20,13 +20,27 @@
 #ifndef MU_IMPORTEXPORT_WAVEWRITER_H
 #define MU_IMPORTEXPORT_WAVEWRITER_H
 
-#include "notation/abstractnotationwriter.h"
+#include <vector>
+
+#include "abstractaudiowriter.h"
 
 namespace mu::iex::audioexport {
-class WaveWriter : public notation::AbstractNotationWriter
+//! NOTE 16 bit PCM stereo RIFF/WAVE
+class WaveWriter : public AbstractAudioWriter
 {
-public:
-    Ret write(const notation::INotationPtr notation, system::IODevice& destinationDevice, const Options& options = Options()) override;
+protected:
+    Ret beginEncode(system::IODevice& device, unsigned int sampleRate) override;
+    bool encode(const float* data, unsigned int sampleCount) override;
+    Ret endEncode() override;
+
+private:
+    bool writeHeader(uint32_t dataSize);
+
+    system::IODevice* m_device = nullptr;
+    qint64 m_headerPos = 0;
+    unsigned int m_sampleRate = 0;
+    uint64_t m_dataSize = 0;
+    std::vector<int16_t> m_pcm;
 };
 }
 
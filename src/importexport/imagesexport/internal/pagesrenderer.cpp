@@ -0,0 +1,87 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+#include "pagesrenderer.h"
+
+#include <atomic>
+
+#ifndef Q_OS_WASM
+#include <QThread>
+#include <QtConcurrent>
+#endif
+
+#include "libmscore/mscore.h"
+#include "libmscore/score.h"
+#include "libmscore/sym.h"
+
+using namespace mu::iex::imagesexport;
+
+PrintingScope::PrintingScope(Ms::Score* score, double pixelRatio, bool pdfPrinting, bool svgPrinting)
+    : m_score(score)
+{
+    m_printingBackup = m_score->printing();
+    m_pixelRatioBackup = Ms::MScore::pixelRatio;
+    m_pdfPrintingBackup = Ms::MScore::pdfPrinting;
+    m_svgPrintingBackup = Ms::MScore::svgPrinting;
+
+    m_score->setPrinting(true); // don’t print page break symbols etc.
+    Ms::MScore::pixelRatio = pixelRatio;
+    Ms::MScore::pdfPrinting = pdfPrinting;
+    Ms::MScore::svgPrinting = svgPrinting;
+
+    Ms::ScoreFont::fontFactory(m_score->styleSt(Ms::Sid::MusicalSymbolFont));
+    Ms::ScoreFont::fallbackFont();
+}
+
+PrintingScope::~PrintingScope()
+{
+    m_score->setPrinting(m_printingBackup);
+    Ms::MScore::pixelRatio = m_pixelRatioBackup;
+    Ms::MScore::pdfPrinting = m_pdfPrintingBackup;
+    Ms::MScore::svgPrinting = m_svgPrintingBackup;
+}
+
+std::vector<QByteArray> mu::iex::imagesexport::renderPages(int firstPage, int count, const PageRenderFunc& render)
+{
+    std::vector<QByteArray> result(std::max(count, 0));
+
+    //! NOTE Rendering only reads the laid out score, every page gets its own painter
+    std::atomic<int> next { 0 };
+    auto renderNext = [&]() {
+        for (int i = next++; i < count; i = next++) {
+            result[i] = render(firstPage + i);
+        }
+    };
+
+#ifndef Q_OS_WASM
+    QList<QFuture<void> > futures;
+    const int threads = std::min(count, QThread::idealThreadCount());
+    for (int i = 1; i < threads; ++i) {
+        futures.append(QtConcurrent::run(renderNext));
+    }
+    renderNext();
+    for (QFuture<void>& future : futures) {
+        future.waitForFinished();
+    }
+#else
+    renderNext();
+#endif
+
+    return result;
+}
@@ -0,0 +1,58 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+#ifndef MU_IMPORTEXPORT_PAGESRENDERER_H
+#define MU_IMPORTEXPORT_PAGESRENDERER_H
+
+#include <functional>
+#include <vector>
+
+#include <QByteArray>
+
+namespace Ms {
+class Score;
+}
+
+namespace mu::iex::imagesexport {
+//! Switches libmscore into printing mode for the lifetime of the object.
+//! The printing state is global, so it is set once on the exporting thread
+//! and stays constant while the pages are rendered. The score fonts pages
+//! may fall back to are loaded here as well, not by the page threads.
+class PrintingScope
+{
+public:
+    PrintingScope(Ms::Score* score, double pixelRatio, bool pdfPrinting = false, bool svgPrinting = false);
+    ~PrintingScope();
+
+private:
+    Ms::Score* m_score = nullptr;
+    bool m_printingBackup = false;
+    double m_pixelRatioBackup = 1.0;
+    bool m_pdfPrintingBackup = false;
+    bool m_svgPrintingBackup = false;
+};
+
+using PageRenderFunc = std::function<QByteArray (int pageNumber)>;
+
+//! Renders the pages [firstPage, firstPage + count) with render(), spread over
+//! the global thread pool and the calling thread. The result is in page order.
+std::vector<QByteArray> renderPages(int firstPage, int count, const PageRenderFunc& render);
+}
+
+#endif // MU_IMPORTEXPORT_PAGESRENDERER_H
@@ -21,6 +21,8 @@
 
 #include "log.h"
 
+#include "pagesrenderer.h"
+
 #include "libmscore/score.h"
 
 #include <QPdfWriter>
@@ -40,15 +42,15 @@ mu::Ret PdfWriter::write(const notation::INotationPtr notation, IODevice& destin
         return make_ret(Ret::Code::UnknownError);
     }
 
-    score->setPrinting(true);
-    MScore::pdfPrinting = true;
-
     QPdfWriter pdfWriter(&destinationDevice);
     pdfWriter.setResolution(configuration()->exportPdfDpiResolution());
     pdfWriter.setCreator("MuseScore Version: " VERSION);
     pdfWriter.setTitle(documentTitle(*score));
     pdfWriter.setPageMargins(QMarginsF());
 
+    //! NOTE The pages share one QPdfWriter and are written in page order, so they are printed on this thread
+    PrintingScope printing(score, DPI / pdfWriter.logicalDpiX(), true);
+
     QPainter painter;
     if (!painter.begin(&pdfWriter)) {
         return false;
@@ -61,9 +63,6 @@ mu::Ret PdfWriter::write(const notation::INotationPtr notation, IODevice& destin
                               size.height() * pdfWriter.logicalDpiY()));
     painter.setWindow(QRect(0.0, 0.0, size.width() * DPI, size.height() * DPI));
 
-    double pixelRationBackup = MScore::pixelRatio;
-    MScore::pixelRatio = DPI / pdfWriter.logicalDpiX();
-
     for (int pageNumber = 0; pageNumber < score->npages(); ++pageNumber) {
         if (pageNumber > 0) {
             pdfWriter.newPage();
@@ -73,9 +72,6 @@ mu::Ret PdfWriter::write(const notation::INotationPtr notation, IODevice& destin
     }
 
     painter.end();
-    score->setPrinting(false);
-    MScore::pixelRatio = pixelRationBackup;
-    MScore::pdfPrinting = false;
 
     return true;
 }
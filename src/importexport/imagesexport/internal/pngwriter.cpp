@@ -23,9 +23,13 @@
 
 #include "log.h"
 
+#include "pagesrenderer.h"
+
+#include "libmscore/glyphcache.h"
 #include "libmscore/score.h"
 #include "libmscore/page.h"
 
+#include <QBuffer>
 #include <QImage>
 #include <QPainter>
 
@@ -33,6 +37,13 @@ using namespace mu::iex::imagesexport;
 using namespace mu::system;
 
 mu::Ret PngWriter::write(const notation::INotationPtr notation, IODevice& destinationDevice, const Options& options)
+{
+    const int PAGE_NUMBER = options.value(OptionKey::PAGE_NUMBER, Val(0)).toInt();
+    return writePages(notation, { &destinationDevice }, PAGE_NUMBER, options);
+}
+
+mu::Ret PngWriter::writePages(const notation::INotationPtr notation, const std::vector<IODevice*>& destinationDevices, int firstPage,
+                              const Options& options)
 {
     IF_ASSERT_FAILED(notation) {
         return make_ret(Ret::Code::UnknownError);
@@ -42,19 +53,40 @@ mu::Ret PngWriter::write(const notation::INotationPtr notation, IODevice& destin
         return make_ret(Ret::Code::UnknownError);
     }
 
-    score->setPrinting(true); // don’t print page break symbols etc.
-
-    double pixelRatioBackup = Ms::MScore::pixelRatio;
-
-    const int PAGE_NUMBER = options.value(OptionKey::PAGE_NUMBER, Val(0)).toInt();
     const QList<Ms::Page*>& pages = score->pages();
+    const int pagesCount = static_cast<int>(destinationDevices.size());
 
-    if (PAGE_NUMBER < 0 || PAGE_NUMBER >= pages.size()) {
+    if (firstPage < 0 || pagesCount == 0 || firstPage + pagesCount > pages.size()) {
         return false;
     }
 
-    Ms::Page* page = pages[PAGE_NUMBER];
+    const float CANVAS_DPI = configuration()->exportPngDpiResolution();
+    const double scaling = CANVAS_DPI / Ms::DPI;
 
+    PrintingScope printing(score, 1.0 / scaling);
+
+    //! NOTE Render the glyphs once here, so that the page threads find them in the shared cache
+    QList<Ms::Element*> elements;
+    for (int i = firstPage; i < firstPage + pagesCount; ++i) {
+        elements += pages[i]->elements();
+    }
+    Ms::GlyphCache::prewarm(elements, scaling);
+
+    std::vector<QByteArray> images = renderPages(firstPage, pagesCount, [&](int pageNumber) {
+        return renderPage(pages[pageNumber], CANVAS_DPI, options);
+    });
+
+    for (int i = 0; i < pagesCount; ++i) {
+        if (images[i].isEmpty() || destinationDevices[i]->write(images[i]) != images[i].size()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+QByteArray PngWriter::renderPage(Ms::Page* page, float canvasDpi, const Options& options) const
+{
     const int TRIM_MARGIN_SIZE = options.value(OptionKey::TRIM_MARGINS_SIZE, Val(0)).toInt();
     QRectF pageRect = page->abbox();
 
@@ -63,19 +95,17 @@ mu::Ret PngWriter::write(const notation::INotationPtr notation, IODevice& destin
         pageRect = page->tbbox() + margins;
     }
 
-    const float CANVAS_DPI = configuration()->exportPngDpiResolution();
-    int width = std::lrint(pageRect.width() * CANVAS_DPI / Ms::DPI);
-    int height = std::lrint(pageRect.height() * CANVAS_DPI / Ms::DPI);
+    int width = std::lrint(pageRect.width() * canvasDpi / Ms::DPI);
+    int height = std::lrint(pageRect.height() * canvasDpi / Ms::DPI);
 
     QImage image(width, height, QImage::Format_ARGB32_Premultiplied);
-    image.setDotsPerMeterX(std::lrint((CANVAS_DPI * 1000) / Ms::INCH));
-    image.setDotsPerMeterY(std::lrint((CANVAS_DPI * 1000) / Ms::INCH));
+    image.setDotsPerMeterX(std::lrint((canvasDpi * 1000) / Ms::INCH));
+    image.setDotsPerMeterY(std::lrint((canvasDpi * 1000) / Ms::INCH));
 
     const bool TRANSPARENT_BACKGROUND = options.value(OptionKey::TRANSPARENT_BACKGROUND, Val(false)).toBool();
     image.fill(TRANSPARENT_BACKGROUND ? 0 : Qt::white);
 
-    double scaling = CANVAS_DPI / Ms::DPI;
-    Ms::MScore::pixelRatio = 1.0 / scaling;
+    double scaling = canvasDpi / Ms::DPI;
 
     QPainter painter(&image);
     painter.setRenderHint(QPainter::Antialiasing, true);
@@ -89,10 +119,12 @@ mu::Ret PngWriter::write(const notation::INotationPtr notation, IODevice& destin
     std::stable_sort(elements.begin(), elements.end(), Ms::elementLessThan);
 
     Ms::paintElements(painter, elements);
-    image.save(&destinationDevice, "png");
+    painter.end();
 
-    score->setPrinting(false);
-    Ms::MScore::pixelRatio = pixelRatioBackup;
+    QByteArray data;
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::WriteOnly);
+    image.save(&buffer, "png");
 
-    return true;
+    return data;
 }
@@ -25,6 +25,10 @@
 #include "../iimagesexportconfiguration.h"
 #include "modularity/ioc.h"
 
+namespace Ms {
+class Page;
+}
+
 namespace mu::iex::imagesexport {
 class PngWriter : public notation::AbstractNotationWriter
 {
@@ -32,6 +36,11 @@ class PngWriter : public notation::AbstractNotationWriter
 
 public:
     Ret write(const notation::INotationPtr notation, system::IODevice& destinationDevice, const Options& options = Options()) override;
+    Ret writePages(const notation::INotationPtr notation, const std::vector<system::IODevice*>& destinationDevices, int firstPage,
+                   const Options& options = Options()) override;
+
+private:
+    QByteArray renderPage(Ms::Page* page, float canvasDpi, const Options& options) const;
 };
 }
 
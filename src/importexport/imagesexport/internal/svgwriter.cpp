@@ -22,6 +22,7 @@
 #include "log.h"
 
 #include "svggenerator.h"
+#include "pagesrenderer.h"
 
 #include "libmscore/score.h"
 #include "libmscore/page.h"
@@ -30,12 +31,20 @@
 #include "libmscore/measure.h"
 #include "libmscore/stafflines.h"
 
+#include <QBuffer>
 #include <QPainter>
 
 using namespace mu::iex::imagesexport;
 using namespace mu::system;
 
 mu::Ret SvgWriter::write(const notation::INotationPtr notation, IODevice& destinationDevice, const Options& options)
+{
+    const int PAGE_NUMBER = options.value(OptionKey::PAGE_NUMBER, Val(0)).toInt();
+    return writePages(notation, { &destinationDevice }, PAGE_NUMBER, options);
+}
+
+mu::Ret SvgWriter::writePages(const notation::INotationPtr notation, const std::vector<IODevice*>& destinationDevices, int firstPage,
+                              const Options& options)
 {
     IF_ASSERT_FAILED(notation) {
         return make_ret(Ret::Code::UnknownError);
@@ -45,25 +54,61 @@ mu::Ret SvgWriter::write(const notation::INotationPtr notation, IODevice& destin
         return make_ret(Ret::Code::UnknownError);
     }
 
-    score->setPrinting(true); // don’t print page break symbols etc.
-
-    Ms::MScore::pdfPrinting = true;
-    Ms::MScore::svgPrinting = true;
-
     const QList<Ms::Page*>& pages = score->pages();
-    double pixelRationBackup = Ms::MScore::pixelRatio;
+    const int pagesCount = static_cast<int>(destinationDevices.size());
 
-    const int PAGE_NUMBER = options.value(OptionKey::PAGE_NUMBER, Val(0)).toInt();
-    if (PAGE_NUMBER < 0 || PAGE_NUMBER >= pages.size()) {
+    if (firstPage < 0 || pagesCount == 0 || firstPage + pagesCount > pages.size()) {
         return false;
     }
 
-    Ms::Page* page = pages.at(PAGE_NUMBER);
+    NotesColors notesColors = parseNotesColors(options.value(OptionKey::NOTES_COLORS, Val()).toQVariant());
+
+    // the notes are numbered over all pages, so each page needs the number of notes before it
+    std::vector<int> lastNoteIndexes(pagesCount);
+    int lastNoteIndex = -1;
+    for (int i = 0; i < firstPage + pagesCount; ++i) {
+        if (i >= firstPage) {
+            lastNoteIndexes[i - firstPage] = lastNoteIndex;
+        }
+        if (notesColors.isEmpty()) {
+            continue;
+        }
+        for (const Ms::Element* element: pages[i]->elements()) {
+            if (element->type() == Ms::ElementType::NOTE) {
+                lastNoteIndex++;
+            }
+        }
+    }
+
+    PrintingScope printing(score, Ms::DPI / SvgGenerator().logicalDpiX(), true, true);
+
+    std::vector<QByteArray> svgs = renderPages(firstPage, pagesCount, [&](int pageNumber) {
+        return renderPage(score, pageNumber, lastNoteIndexes[pageNumber - firstPage], notesColors, options);
+    });
+
+    for (int i = 0; i < pagesCount; ++i) {
+        if (svgs[i].isEmpty() || destinationDevices[i]->write(svgs[i]) != svgs[i].size()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+QByteArray SvgWriter::renderPage(Ms::Score* score, int pageNumber, int lastNoteIndex, const NotesColors& notesColors,
+                                 const Options& options) const
+{
+    const QList<Ms::Page*>& pages = score->pages();
+    Ms::Page* page = pages.at(pageNumber);
+
+    QByteArray data;
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::WriteOnly);
 
     SvgGenerator printer;
     QString title(score->title());
-    printer.setTitle(pages.size() > 1 ? QString("%1 (%2)").arg(title).arg(PAGE_NUMBER + 1) : title);
-    printer.setOutputDevice(&destinationDevice);
+    printer.setTitle(pages.size() > 1 ? QString("%1 (%2)").arg(title).arg(pageNumber + 1) : title);
+    printer.setOutputDevice(&buffer);
 
     const int TRIM_MARGINS_SIZE = options.value(OptionKey::TRIM_MARGINS_SIZE, Val(0)).toInt();
 
@@ -85,8 +130,6 @@ mu::Ret SvgWriter::write(const notation::INotationPtr notation, IODevice& destin
         painter.translate(-pageRect.topLeft());
     }
 
-    Ms::MScore::pixelRatio = Ms::DPI / printer.logicalDpiX();
-
     if (!options[OptionKey::TRANSPARENT_BACKGROUND].toBool()) {
         painter.fillRect(pageRect, Qt::white);
     }
@@ -159,17 +202,6 @@ mu::Ret SvgWriter::write(const notation::INotationPtr notation, IODevice& destin
     QList<Ms::Element*> elements = page->elements();
     std::stable_sort(elements.begin(), elements.end(), Ms::elementLessThan);
 
-    int lastNoteIndex = -1;
-    for (int i = 0; i < PAGE_NUMBER; ++i) {
-        for (const Ms::Element* element: pages[i]->elements()) {
-            if (element->type() == Ms::ElementType::NOTE) {
-                lastNoteIndex++;
-            }
-        }
-    }
-
-    NotesColors notesColors = parseNotesColors(options.value(OptionKey::NOTES_COLORS, Val()).toQVariant());
-
     for (const Ms::Element* element : elements) {
         // Always exclude invisible elements
         if (!element->visible()) {
@@ -206,15 +238,9 @@ mu::Ret SvgWriter::write(const notation::INotationPtr notation, IODevice& destin
         }
     }
 
-    painter.end(); // Writes MuseScore SVG file to disk, finally
+    painter.end(); // Writes MuseScore SVG file to the buffer, finally
 
-    // Clean up and return
-    Ms::MScore::pixelRatio = pixelRationBackup;
-    score->setPrinting(false);
-    Ms::MScore::pdfPrinting = false;
-    Ms::MScore::svgPrinting = false;
-
-    return true;
+    return data;
 }
 
 SvgWriter::NotesColors SvgWriter::parseNotesColors(const QVariant& obj) const
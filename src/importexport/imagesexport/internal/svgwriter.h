@@ -22,16 +22,23 @@
 
 #include "notation/abstractnotationwriter.h"
 
+namespace Ms {
+class Score;
+}
+
 namespace mu::iex::imagesexport {
 class SvgWriter : public notation::AbstractNotationWriter
 {
 public:
     Ret write(const notation::INotationPtr notation, system::IODevice& destinationDevice, const Options& options = Options()) override;
+    Ret writePages(const notation::INotationPtr notation, const std::vector<system::IODevice*>& destinationDevices, int firstPage,
+                   const Options& options = Options()) override;
 
 private:
     using NotesColors = QHash<int /* noteIndex */, QColor>;
 
     NotesColors parseNotesColors(const QVariant& obj) const;
+    QByteArray renderPage(Ms::Score* score, int pageNumber, int lastNoteIndex, const NotesColors& notesColors, const Options& options) const;
 };
 }
 
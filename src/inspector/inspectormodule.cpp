@@ -66,6 +66,11 @@ std::string InspectorModule::moduleName() const
     return "inspector";
 }
 
+bool InspectorModule::isUsedByConverter() const
+{
+    return false;
+}
+
 void InspectorModule::registerExports()
 {
     static std::shared_ptr<MU4InspectorAdapter> adapter = std::make_shared<MU4InspectorAdapter>();
@@ -43,6 +43,11 @@ std::string LanguagesModule::moduleName() const
     return "languages";
 }
 
+bool LanguagesModule::isUsedByConverter() const
+{
+    return false;
+}
+
 void LanguagesModule::registerExports()
 {
     framework::ioc()->registerExport<ILanguagesConfiguration>(moduleName(), m_languagesConfiguration);
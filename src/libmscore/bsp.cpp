@@ -14,6 +14,7 @@
 //=============================================================================
 
 #include <cmath>
+#include <QSet>
 
 #include "bsp.h"
 #include "element.h"
@@ -87,11 +88,17 @@ static inline int intmaxlog(int n)
 //   initialize
 //---------------------------------------------------------
 
+int BspTree::depthForItemCount(int n)
+{
+    return intmaxlog(n);
+}
+
 void BspTree::initialize(const QRectF& rec, int n)
 {
     depth      = intmaxlog(n);
     this->rect = rec;
     leafCnt    = 0;
+    itemRects.clear();
 
     nodes.resize((1 << (depth + 1)) - 1);
     leaves.resize(1 << depth);
@@ -108,6 +115,7 @@ void BspTree::clear()
     leafCnt = 0;
     nodes.clear();
     leaves.clear();
+    itemRects.clear();
 }
 
 //---------------------------------------------------------
@@ -118,7 +126,9 @@ void BspTree::insert(Element* element)
 {
     InsertItemBspTreeVisitor insertVisitor;
     insertVisitor.item = element;
-    climbTree(&insertVisitor, element->pageBoundingRect());
+    QRectF r = element->pageBoundingRect();
+    itemRects.insert(element, r);
+    climbTree(&insertVisitor, r);
 }
 
 //---------------------------------------------------------
@@ -127,9 +137,16 @@ void BspTree::insert(Element* element)
 
 void BspTree::remove(Element* element)
 {
+    // the element may be deleted already, use the rectangle
+    // it was inserted with and don't dereference it
+    auto i = itemRects.find(element);
+    if (i == itemRects.end()) {
+        return;
+    }
     RemoveItemBspTreeVisitor removeVisitor;
     removeVisitor.item = element;
-    climbTree(&removeVisitor, element->pageBoundingRect());
+    climbTree(&removeVisitor, i.value());
+    itemRects.erase(i);
 }
 
 //---------------------------------------------------------
@@ -199,6 +216,26 @@ QString BspTree::debug(int index) const
     return tmp;
 }
 
+//---------------------------------------------------------
+//   hasSameItems
+//    check that both trees have the same layout and every
+//    leaf contains the same items
+//---------------------------------------------------------
+
+bool BspTree::hasSameItems(const BspTree& other) const
+{
+    if (depth != other.depth || rect != other.rect || leaves.size() != other.leaves.size()) {
+        return false;
+    }
+    for (int i = 0; i < leaves.size(); ++i) {
+        if (QSet<Element*>(leaves[i].begin(), leaves[i].end())
+            != QSet<Element*>(other.leaves[i].begin(), other.leaves[i].end())) {
+            return false;
+        }
+    }
+    return true;
+}
+
 #endif
 
 //---------------------------------------------------------
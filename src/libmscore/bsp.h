@@ -19,6 +19,7 @@
 #include <QRectF>
 #include <QVector>
 #include <QList>
+#include <QHash>
 
 namespace Ms {
 class BspTreeVisitor;
@@ -60,16 +61,24 @@ private:
     QVector<QList<Element*> > leaves;
     int leafCnt;
     QRectF rect;
+    QHash<Element*, QRectF> itemRects;        // rectangle each item was inserted with
 
 public:
     BspTree();
 
+    static int depthForItemCount(int n);
+
     void initialize(const QRectF& rect, int depth);
     void clear();
 
     void insert(Element* item);
     void remove(Element* item);
 
+    bool isEmpty() const { return nodes.empty(); }
+    uint treeDepth() const { return depth; }
+    const QRectF& boundingRect() const { return rect; }
+    int itemCount() const { return itemRects.size(); }
+
     QList<Element*> items(const QRectF& rect);
     QList<Element*> items(const QPointF& pos);
 
@@ -83,6 +92,7 @@ public:
 
 #ifndef NDEBUG
     QString debug(int index) const;
+    bool hasSameItems(const BspTree& other) const;
 #endif
 };
 
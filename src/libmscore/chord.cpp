@@ -51,6 +51,7 @@
 #include "beam.h"
 #include "slur.h"
 #include "fingering.h"
+#include "taghash.h"
 
 namespace Ms {
 //---------------------------------------------------------
@@ -1117,73 +1118,98 @@ void Chord::read(XmlReader& e)
 
 bool Chord::readProperties(XmlReader& e)
 {
+    static const TagIndex tags {
+        "Note", "Stem", "Hook", "appoggiatura", "acciaccatura", "grace4", "grace16", "grace32", "grace8after",
+        "grace16after", "grace32after", "StemSlash", "noStem", "Arpeggio", "Tremolo", "tickOffset", "ChordLine"
+    };
     const QStringRef& tag(e.name());
 
-    if (tag == "Note") {
+    switch (tags.hash(tag)) {
+    case tagHash("Note"): {
         Note* note = new Note(score());
         // the note needs to know the properties of the track it belongs to
         note->setTrack(track());
         note->setChord(this);
         note->read(e);
         add(note);
-    } else if (ChordRest::readProperties(e)) {
-    } else if (tag == "Stem") {
+    }
+    break;
+    case tagHash("Stem"): {
         Stem* s = new Stem(score());
         s->read(e);
         add(s);
-    } else if (tag == "Hook") {
+    }
+    break;
+    case tagHash("Hook"):
         _hook = new Hook(score());
         _hook->read(e);
         add(_hook);
-    } else if (tag == "appoggiatura") {
+        break;
+    case tagHash("appoggiatura"):
         _noteType = NoteType::APPOGGIATURA;
         e.readNext();
-    } else if (tag == "acciaccatura") {
+        break;
+    case tagHash("acciaccatura"):
         _noteType = NoteType::ACCIACCATURA;
         e.readNext();
-    } else if (tag == "grace4") {
+        break;
+    case tagHash("grace4"):
         _noteType = NoteType::GRACE4;
         e.readNext();
-    } else if (tag == "grace16") {
+        break;
+    case tagHash("grace16"):
         _noteType = NoteType::GRACE16;
         e.readNext();
-    } else if (tag == "grace32") {
+        break;
+    case tagHash("grace32"):
         _noteType = NoteType::GRACE32;
         e.readNext();
-    } else if (tag == "grace8after") {
+        break;
+    case tagHash("grace8after"):
         _noteType = NoteType::GRACE8_AFTER;
         e.readNext();
-    } else if (tag == "grace16after") {
+        break;
+    case tagHash("grace16after"):
         _noteType = NoteType::GRACE16_AFTER;
         e.readNext();
-    } else if (tag == "grace32after") {
+        break;
+    case tagHash("grace32after"):
         _noteType = NoteType::GRACE32_AFTER;
         e.readNext();
-    } else if (tag == "StemSlash") {
+        break;
+    case tagHash("StemSlash"): {
         StemSlash* ss = new StemSlash(score());
         ss->read(e);
         add(ss);
-    } else if (readProperty(tag, e, Pid::STEM_DIRECTION)) {
-    } else if (tag == "noStem") {
+    }
+    break;
+    case tagHash("noStem"):
         _noStem = e.readInt();
-    } else if (tag == "Arpeggio") {
+        break;
+    case tagHash("Arpeggio"):
         _arpeggio = new Arpeggio(score());
         _arpeggio->setTrack(track());
         _arpeggio->read(e);
         _arpeggio->setParent(this);
-    } else if (tag == "Tremolo") {
+        break;
+    case tagHash("Tremolo"):
         _tremolo = new Tremolo(score());
         _tremolo->setTrack(track());
         _tremolo->read(e);
         _tremolo->setParent(this);
         _tremolo->setDurationType(durationType());
-    } else if (tag == "tickOffset") {     // obsolete
-    } else if (tag == "ChordLine") {
+        break;
+    case tagHash("tickOffset"):           // obsolete
+        break;
+    case tagHash("ChordLine"): {
         ChordLine* cl = new ChordLine(score());
         cl->read(e);
         add(cl);
-    } else {
-        return false;
+    }
+    break;
+    default:
+        // none of the tags above is read by ChordRest
+        return ChordRest::readProperties(e) || readProperty(tag, e, Pid::STEM_DIRECTION);
     }
     return true;
 }
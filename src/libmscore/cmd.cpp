@@ -280,6 +280,11 @@ void Score::endCmd(const bool isCmdFromInspector, bool rollback)
 
     if (MScore::debugMode) {
         qDebug("===endCmd() %d", undoStack()->current()->childCount());
+        if (cmdState().layoutRange()) {
+            const LayoutStatistics& ls = layoutStatistics();
+            qDebug("   layout: measures %d laid out, %d reused; systems %d collected, %d reused; pages %d",
+                   ls.measuresLaidOut, ls.measuresReused, ls.systemsCollected, ls.systemsReused, ls.pagesCollected);
+        }
     }
     const bool noUndo = undoStack()->current()->empty();         // nothing to undo?
     undoStack()->endMacro(noUndo);
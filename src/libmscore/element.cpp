@@ -103,6 +103,7 @@
 #include "palmmute.h"
 #include "fermata.h"
 #include "shape.h"
+#include "taghash.h"
 //#include "musescoreCore.h"
 
 namespace Ms {
@@ -689,21 +690,39 @@ void Element::writeProperties(XmlWriter& xml) const
 
 bool Element::readProperties(XmlReader& e)
 {
+    static const TagIndex tags {
+        "sizeIsSpatiumDependent", "offset", "minDistance", "autoplace", "track", "color", "visible", "selected",
+        "linked", "linkedMain", "lid", "tick", "pos", "voice", "tag", "placement", "z"
+    };
     const QStringRef& tag(e.name());
 
-    if (readProperty(tag, e, Pid::SIZE_SPATIUM_DEPENDENT)) {
-    } else if (readProperty(tag, e, Pid::OFFSET)) {
-    } else if (readProperty(tag, e, Pid::MIN_DISTANCE)) {
-    } else if (readProperty(tag, e, Pid::AUTOPLACE)) {
-    } else if (tag == "track") {
+    switch (tags.hash(tag)) {
+    case tagHash("sizeIsSpatiumDependent"):
+        readProperty(e, Pid::SIZE_SPATIUM_DEPENDENT);
+        break;
+    case tagHash("offset"):
+        readProperty(e, Pid::OFFSET);
+        break;
+    case tagHash("minDistance"):
+        readProperty(e, Pid::MIN_DISTANCE);
+        break;
+    case tagHash("autoplace"):
+        readProperty(e, Pid::AUTOPLACE);
+        break;
+    case tagHash("track"):
         setTrack(e.readInt() + e.trackOffset());
-    } else if (tag == "color") {
+        break;
+    case tagHash("color"):
         setColor(e.readColor());
-    } else if (tag == "visible") {
+        break;
+    case tagHash("visible"):
         setVisible(e.readInt());
-    } else if (tag == "selected") { // obsolete
+        break;
+    case tagHash("selected"):             // obsolete
         e.readInt();
-    } else if ((tag == "linked") || (tag == "linkedMain")) {
+        break;
+    case tagHash("linked"):
+    case tagHash("linkedMain"): {
         Staff* s = staff();
         if (!s) {
             s = score()->staff(e.track() / VOICES);
@@ -763,7 +782,9 @@ bool Element::readProperties(XmlReader& e)
                 qWarning("Element::readProperties: could not link %s at staff %d", name(), mainLoc.staff() + 1);
             }
         }
-    } else if (tag == "lid") {
+    }
+    break;
+    case tagHash("lid"): {
         if (score()->mscVersion() >= 301) {
             e.skipCurrentElement();
             return true;
@@ -790,16 +811,22 @@ bool Element::readProperties(XmlReader& e)
 #endif
         Q_ASSERT(!_links->contains(this));
         _links->append(this);
-    } else if (tag == "tick") {
+    }
+    break;
+    case tagHash("tick"): {
         int val = e.readInt();
         if (val >= 0) {
             e.setTick(Fraction::fromTicks(score()->fileDivision(val)));             // obsolete
         }
-    } else if (tag == "pos") {           // obsolete
+    }
+    break;
+    case tagHash("pos"):                  // obsolete
         readProperty(e, Pid::OFFSET);
-    } else if (tag == "voice") {
+        break;
+    case tagHash("voice"):
         setVoice(e.readInt());
-    } else if (tag == "tag") {
+        break;
+    case tagHash("tag"): {
         QString val(e.readElementText());
         for (int i = 1; i < MAX_TAGS; i++) {
             if (score()->layerTags()[i] == val) {
@@ -807,10 +834,15 @@ bool Element::readProperties(XmlReader& e)
                 break;
             }
         }
-    } else if (readProperty(tag, e, Pid::PLACEMENT)) {
-    } else if (tag == "z") {
+    }
+    break;
+    case tagHash("placement"):
+        readProperty(e, Pid::PLACEMENT);
+        break;
+    case tagHash("z"):
         setZ(e.readInt());
-    } else {
+        break;
+    default:
         return false;
     }
     return true;
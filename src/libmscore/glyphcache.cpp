@@ -0,0 +1,252 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+#include <atomic>
+#include <list>
+
+#include <QMutex>
+
+#include "glyphcache.h"
+#include "accidental.h"
+#include "articulation.h"
+#include "hook.h"
+#include "note.h"
+#include "rest.h"
+#include "score.h"
+
+namespace Ms {
+//---------------------------------------------------------
+//   LruGlyphs
+//    most recently used glyph first
+//---------------------------------------------------------
+
+class LruGlyphs
+{
+    typedef std::list<std::pair<GlyphKey, GlyphPixmap> > List;
+
+    List _glyphs;
+    QHash<GlyphKey, List::iterator> _index;
+    qint64 _bytes = 0;
+
+    static qint64 cost(const GlyphPixmap& glyph) { return glyph.image.sizeInBytes() + qint64(sizeof(List::value_type)) + 32; }
+
+public:
+    const GlyphPixmap* find(const GlyphKey& key)
+    {
+        auto i = _index.find(key);
+        if (i == _index.end()) {
+            return nullptr;
+        }
+        _glyphs.splice(_glyphs.begin(), _glyphs, i.value());
+        return &_glyphs.front().second;
+    }
+
+    const GlyphPixmap* insert(const GlyphKey& key, const GlyphPixmap& glyph, qint64 budget)
+    {
+        auto i = _index.find(key);
+        if (i != _index.end()) {
+            _bytes -= cost(i.value()->second);
+            _glyphs.erase(i.value());
+            _index.erase(i);
+        }
+        _glyphs.emplace_front(key, glyph);
+        _index.insert(key, _glyphs.begin());
+        _bytes += cost(glyph);
+        // never evict the glyph just inserted
+        while (_bytes > budget && _glyphs.size() > 1) {
+            _bytes -= cost(_glyphs.back().second);
+            _index.remove(_glyphs.back().first);
+            _glyphs.pop_back();
+        }
+        return &_glyphs.front().second;
+    }
+
+    void clear()
+    {
+        _glyphs.clear();
+        _index.clear();
+        _bytes = 0;
+    }
+
+    qint64 bytes() const { return _bytes; }
+    int size() const { return _index.size(); }
+};
+
+static std::atomic<qint64> budgetBytes { 32 * 1024 * 1024 };
+static std::atomic<int> generation { 0 };      // a thread's glyphs are dropped when this changes
+static std::atomic<quint64> hits { 0 };
+static std::atomic<quint64> misses { 0 };
+
+static QMutex sharedMutex;
+static LruGlyphs sharedGlyphs;
+
+//---------------------------------------------------------
+//   localGlyphs
+//---------------------------------------------------------
+
+static LruGlyphs& localGlyphs()
+{
+    struct Local {
+        LruGlyphs glyphs;
+        int generation = 0;
+    };
+    static thread_local Local local;
+
+    int g = generation.load(std::memory_order_relaxed);
+    if (local.generation != g) {
+        local.glyphs.clear();
+        local.generation = g;
+    }
+    return local.glyphs;
+}
+
+//---------------------------------------------------------
+//   find
+//---------------------------------------------------------
+
+const GlyphPixmap* GlyphCache::find(const GlyphKey& key)
+{
+    LruGlyphs& local = localGlyphs();
+    if (const GlyphPixmap* glyph = local.find(key)) {
+        hits.fetch_add(1, std::memory_order_relaxed);
+        return glyph;
+    }
+
+    GlyphPixmap shared;
+    {
+        QMutexLocker locker(&sharedMutex);
+        const GlyphPixmap* glyph = sharedGlyphs.find(key);
+        if (!glyph) {
+            misses.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        shared = *glyph;
+    }
+    hits.fetch_add(1, std::memory_order_relaxed);
+    return local.insert(key, shared, budget());
+}
+
+//---------------------------------------------------------
+//   insert
+//---------------------------------------------------------
+
+const GlyphPixmap* GlyphCache::insert(const GlyphKey& key, const GlyphPixmap& glyph)
+{
+    {
+        QMutexLocker locker(&sharedMutex);
+        sharedGlyphs.insert(key, glyph, budget());
+    }
+    return localGlyphs().insert(key, glyph, budget());
+}
+
+//---------------------------------------------------------
+//   budget
+//    bytes each cache may use; as the thread caches share
+//    the images of the shared one, this is about the
+//    memory used by all of them
+//---------------------------------------------------------
+
+qint64 GlyphCache::budget()
+{
+    return budgetBytes.load(std::memory_order_relaxed);
+}
+
+void GlyphCache::setBudget(qint64 bytes)
+{
+    budgetBytes = bytes;
+    clear();
+}
+
+//---------------------------------------------------------
+//   clear
+//---------------------------------------------------------
+
+void GlyphCache::clear()
+{
+    QMutexLocker locker(&sharedMutex);
+    sharedGlyphs.clear();
+    ++generation;
+}
+
+//---------------------------------------------------------
+//   statistics
+//---------------------------------------------------------
+
+GlyphCache::Statistics GlyphCache::statistics()
+{
+    Statistics s;
+    s.hits   = hits.load();
+    s.misses = misses.load();
+    QMutexLocker locker(&sharedMutex);
+    s.sharedBytes  = sharedGlyphs.bytes();
+    s.sharedGlyphs = sharedGlyphs.size();
+    return s;
+}
+
+void GlyphCache::resetStatistics()
+{
+    hits   = 0;
+    misses = 0;
+}
+
+//---------------------------------------------------------
+//   prewarm
+//    render the noteheads, flags, rests, dots, accidentals
+//    and articulations of elements at the given scale, so
+//    that drawing them only copies cached images
+//---------------------------------------------------------
+
+void GlyphCache::prewarm(const QList<Element*>& elements, qreal worldScale)
+{
+    for (const Element* e : elements) {
+        SymId id = SymId::noSym;
+        switch (e->type()) {
+        case ElementType::NOTE:
+            id = toNote(e)->noteHead();
+            break;
+        case ElementType::ACCIDENTAL:
+            id = toAccidental(e)->symbol();
+            break;
+        case ElementType::HOOK:
+            id = toHook(e)->sym();
+            break;
+        case ElementType::REST:
+            id = toRest(e)->sym();
+            break;
+        case ElementType::NOTEDOT:
+            id = SymId::augmentationDot;
+            break;
+        case ElementType::ARTICULATION:
+            id = toArticulation(e)->symId();
+            break;
+        default:
+            break;
+        }
+        if (id == SymId::noSym || !e->visible()) {
+            continue;
+        }
+        const ScoreFont* font = e->score()->scoreFont();
+        if (!font->isValid(id) || !font->sym(id).symList().empty()) {
+            continue;
+        }
+        const qreal mag = e->magS();
+        font->glyph(id, QSizeF(mag, mag), worldScale, e->curColor());
+    }
+}
+}
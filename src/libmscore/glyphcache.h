@@ -0,0 +1,61 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+#ifndef __GLYPHCACHE_H__
+#define __GLYPHCACHE_H__
+
+#include "sym.h"
+
+namespace Ms {
+class Element;
+
+//---------------------------------------------------------
+//   GlyphCache
+//    rendered score font glyphs, limited by the memory
+//    they take. Each thread looks glyphs up in its own LRU
+//    cache without locking. Glyphs it doesn't have are
+//    taken from a shared LRU cache, which holds every
+//    rendered glyph; both share the image data.
+//---------------------------------------------------------
+
+class GlyphCache
+{
+public:
+    struct Statistics {
+        quint64 hits = 0;
+        quint64 misses = 0;
+        qint64 sharedBytes = 0;
+        int sharedGlyphs = 0;
+    };
+
+    //! The returned glyph is valid until the next insert() on the same thread
+    static const GlyphPixmap* find(const GlyphKey& key);
+    static const GlyphPixmap* insert(const GlyphKey& key, const GlyphPixmap& glyph);
+
+    static qint64 budget();
+    static void setBudget(qint64 bytes);
+    static void clear();
+
+    static Statistics statistics();
+    static void resetStatistics();
+
+    static void prewarm(const QList<Element*>& elements, qreal worldScale);
+};
+}     // namespace Ms
+#endif
@@ -107,17 +107,41 @@ void Image::setImageType(ImageType t)
 QSizeF Image::imageSize() const
 {
     if (!isValid()) {
-        return QSizeF();
+        return _storeItem ? _storeItem->imageSize() : QSizeF();
     }
     return imageType == ImageType::RASTER ? rasterDoc->size() : svgDoc->defaultSize();
 }
 
+//---------------------------------------------------------
+//   loadDoc
+//    the image data is only inflated and decoded once the
+//    image is drawn
+//---------------------------------------------------------
+
+void Image::loadDoc() const
+{
+    QMutexLocker lock(&docMutex);
+    if (isValid() || !_storeItem) {
+        return;
+    }
+    if (imageType == ImageType::SVG) {
+        svgDoc = new QSvgRenderer(_storeItem->buffer());
+    } else if (imageType == ImageType::RASTER) {
+        rasterDoc = new QImage;
+        rasterDoc->loadFromData(_storeItem->buffer());
+        if (!rasterDoc->isNull()) {
+            _dirty = true;
+        }
+    }
+}
+
 //---------------------------------------------------------
 //   draw
 //---------------------------------------------------------
 
 void Image::draw(QPainter* painter) const
 {
+    loadDoc();
     bool emptyImage = false;
     if (imageType == ImageType::SVG) {
         if (!svgDoc) {
@@ -136,23 +160,33 @@ void Image::draw(QPainter* painter) const
             } else {
                 s = _size * DPMM;
             }
-            if (score() && score()->printing() && !MScore::svgPrinting) {
+            const bool printing = score() && score()->printing();
+            if (printing && !MScore::svgPrinting) {
                 // use original image size for printing, but not for svg for reasonable file size.
+                // Pages may be printed from worker threads, so stay with QImage there
                 painter->scale(s.width() / rasterDoc->width(), s.height() / rasterDoc->height());
-                painter->drawPixmap(QPointF(0, 0), QPixmap::fromImage(*rasterDoc));
+                painter->drawImage(QPointF(0, 0), *rasterDoc);
             } else {
                 QTransform t = painter->transform();
                 QSize ss = QSizeF(s.width() * t.m11(), s.height() * t.m22()).toSize();
                 t.setMatrix(1.0, t.m12(), t.m13(), t.m21(), 1.0, t.m23(), t.m31(), t.m32(), t.m33());
                 painter->setWorldTransform(t);
-                if ((buffer.size() != ss || _dirty) && rasterDoc && !rasterDoc->isNull()) {
-                    buffer = QPixmap::fromImage(rasterDoc->scaled(ss, Qt::IgnoreAspectRatio, Qt::SmoothTransformation));
-                    _dirty = false;
-                }
-                if (buffer.isNull()) {
-                    emptyImage = true;
+                if (printing) {
+                    if (rasterDoc->isNull()) {
+                        emptyImage = true;
+                    } else {
+                        painter->drawImage(QPointF(0.0, 0.0), rasterDoc->scaled(ss, Qt::IgnoreAspectRatio, Qt::SmoothTransformation));
+                    }
                 } else {
-                    painter->drawPixmap(QPointF(0.0, 0.0), buffer);
+                    if ((buffer.size() != ss || _dirty) && rasterDoc && !rasterDoc->isNull()) {
+                        buffer = QPixmap::fromImage(rasterDoc->scaled(ss, Qt::IgnoreAspectRatio, Qt::SmoothTransformation));
+                        _dirty = false;
+                    }
+                    if (buffer.isNull()) {
+                        emptyImage = true;
+                    } else {
+                        painter->drawPixmap(QPointF(0.0, 0.0), buffer);
+                    }
                 }
             }
             painter->restore();
@@ -519,19 +553,6 @@ QSizeF Image::size2pixel(const QSizeF& s) const
 void Image::layout()
 {
     setPos(0.0, 0.0);
-    if (imageType == ImageType::SVG && !svgDoc) {
-        if (_storeItem) {
-            svgDoc = new QSvgRenderer(_storeItem->buffer());
-        }
-    } else if (imageType == ImageType::RASTER && !rasterDoc) {
-        if (_storeItem) {
-            rasterDoc = new QImage;
-            rasterDoc->loadFromData(_storeItem->buffer());
-            if (!rasterDoc->isNull()) {
-                _dirty = true;
-            }
-        }
-    }
     if (_size.isNull()) {
         _size = pixel2size(imageSize());
     }
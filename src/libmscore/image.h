@@ -13,6 +13,7 @@
 #ifndef __IMAGE_H__
 #define __IMAGE_H__
 
+#include <QMutex>
 #include <QSvgRenderer>
 
 #include "bsymbol.h"
@@ -30,12 +31,15 @@ enum class ImageType : char {
 
 class Image final : public BSymbol
 {
-    union {
-        QImage* rasterDoc;
-        QSvgRenderer* svgDoc;
+    union {                         // created from the store item on first draw
+        mutable QImage* rasterDoc;
+        mutable QSvgRenderer* svgDoc;
     };
+    mutable QMutex docMutex;        // pages may be drawn from several threads
     ImageType imageType;
 
+    void loadDoc() const;
+
     QSizeF pixel2size(const QSizeF& s) const;
     QSizeF size2pixel(const QSizeF& s) const;
 
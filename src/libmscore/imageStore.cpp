@@ -11,13 +11,34 @@
 //=============================================================================
 
 #include <QtCore/QCryptographicHash>
+#include <QBuffer>
+#include <QImageReader>
+#include <QMutex>
+#include <QSvgRenderer>
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
 #include "imageStore.h"
+#include "thirdparty/qzip/qzipreader_p.h"
 #include "score.h"
 #include "image.h"
 
 namespace Ms {
 ImageStore imageStore;  // the global image store
 
+//---------------------------------------------------------
+//   ImageArchive
+//    a .mscz file lazily added images are read from; the
+//    zip directory is read once for all of them
+//---------------------------------------------------------
+
+struct ImageArchive {
+    MQZipReader reader;
+    QMutex mutex;
+
+    ImageArchive(const QString& path)
+        : reader(path) {}
+};
+
 //---------------------------------------------------------
 //   ImageStoreItem
 //---------------------------------------------------------
@@ -68,6 +89,7 @@ bool ImageStoreItem::isUsed(Score* score) const
 
 void ImageStoreItem::load()
 {
+    inflate();
     if (!_buffer.isEmpty()) {
         return;
     }
@@ -83,6 +105,120 @@ void ImageStoreItem::load()
     _hash = h.result();
 }
 
+//---------------------------------------------------------
+//   inflate
+//    read an image added by ImageStore::addLazy() from its
+//    .mscz file, once
+//---------------------------------------------------------
+
+void ImageStoreItem::inflate() const
+{
+    if (!_pending) {
+        return;
+    }
+    std::call_once(_inflateOnce, [this]() {
+        {
+            QMutexLocker lock(&_archive->mutex);
+            if (_archive->reader.exists()) {
+                _buffer = _archive->reader.fileData(_path);
+            }
+        }
+        if (_buffer.isEmpty()) {
+            qDebug("ImageStoreItem: cannot read <%s>", qPrintable(_path));
+        } else {
+            // the hash was taken from the name, the data of a corrupt or renamed entry does not match it
+            QCryptographicHash h(QCryptographicHash::Md4);
+            h.addData(_buffer);
+            if (h.result() != _hash) {
+                qDebug("ImageStoreItem: <%s> does not match its name", qPrintable(_path));
+                _hash = h.result();
+            }
+        }
+        _pending = false;
+    });
+}
+
+//---------------------------------------------------------
+//   setArchive
+//---------------------------------------------------------
+
+void ImageStoreItem::setArchive(std::shared_ptr<ImageArchive> archive)
+{
+    _archive = archive;
+    _pending = bool(_archive);
+}
+
+//---------------------------------------------------------
+//   releaseArchive
+//    after the image is inflated
+//---------------------------------------------------------
+
+void ImageStoreItem::releaseArchive()
+{
+    if (!_pending) {
+        _archive.reset();
+    }
+}
+
+//---------------------------------------------------------
+//   readImageSize
+//    size in pixels from the image header, or for svg from
+//    the attributes of the root element
+//---------------------------------------------------------
+
+static QSizeF readImageSize(QIODevice* dev, bool svg)
+{
+    if (!svg) {
+        QImageReader reader(dev);
+        QSize size = reader.size();
+        if (!size.isValid()) {        // the format has no size in its header
+            size = reader.read().size();
+        }
+        return size;
+    }
+    QXmlStreamReader xml(dev);
+    if (!xml.readNextStartElement() || xml.name() != "svg") {
+        return QSizeF();
+    }
+    // let QSvgRenderer interpret the units of an empty document
+    QByteArray root;
+    QXmlStreamWriter writer(&root);
+    writer.writeDefaultNamespace("http://www.w3.org/2000/svg");
+    writer.writeEmptyElement("svg");
+    for (const char* attr : { "width", "height", "viewBox" }) {
+        if (xml.attributes().hasAttribute(attr)) {
+            writer.writeAttribute(attr, xml.attributes().value(attr).toString());
+        }
+    }
+    writer.writeEndDocument();
+    return QSvgRenderer(root).defaultSize();
+}
+
+//---------------------------------------------------------
+//   imageSize
+//    layout needs the size only, so an image which is not
+//    inflated yet is not inflated for it
+//---------------------------------------------------------
+
+QSizeF ImageStoreItem::imageSize() const
+{
+    std::call_once(_sizeOnce, [this]() {
+        const bool svg = _type == "svg";
+        if (!_pending) {
+            QBuffer buffer(&_buffer);
+            buffer.open(QIODevice::ReadOnly);
+            _imageSize = readImageSize(&buffer, svg);
+            return;
+        }
+        QMutexLocker lock(&_archive->mutex);
+        std::unique_ptr<QIODevice> dev(_archive->reader.fileDevice(_path));
+        if (dev) {
+            _imageSize = readImageSize(dev.get(), svg);
+        }
+    });
+    return _imageSize;
+}
+
 //---------------------------------------------------------
 //   hashName
 //---------------------------------------------------------
@@ -154,6 +290,29 @@ ImageStore::~ImageStore()
 //   getImage
 //---------------------------------------------------------
 
+//---------------------------------------------------------
+//   hashFromName
+//    images in .mscz files are named by the md4 hash of
+//    their data
+//---------------------------------------------------------
+
+static bool hashFromName(const QString& s, QByteArray* hash)
+{
+    if (s.size() != 32) {
+        return false;
+    }
+    for (const QChar& c : s) {
+        if (!((c >= '0' && c <= '9') || (c >= 'a' && c <= 'f'))) {
+            return false;
+        }
+    }
+    hash->resize(16);
+    for (int i = 0; i < 16; ++i) {
+        (*hash)[i] = toInt(s[i * 2].toLatin1()) * 16 + toInt(s[i * 2 + 1].toLatin1());
+    }
+    return true;
+}
+
 ImageStoreItem* ImageStore::getImage(const QString& path) const
 {
     QString s = QFileInfo(path).completeBaseName();
@@ -197,9 +356,17 @@ ImageStoreItem* ImageStore::add(const QString& path, const QByteArray& ba)
     h.addData(ba);
     QByteArray hash = h.result();
     for (ImageStoreItem* item : _items) {
-        if (item->hash() == hash) {
-            return item;
+        if (item->hash() != hash) {
+            continue;
         }
+        if (item->pending()) {
+            // only the name of a lazily added image is known, check its data before sharing it
+            item->buffer();
+            if (item->hash() != hash) {
+                continue;
+            }
+        }
+        return item;
     }
     ImageStoreItem* item = new ImageStoreItem(path);
     item->set(ba, hash);
@@ -207,6 +374,55 @@ ImageStoreItem* ImageStore::add(const QString& path, const QByteArray& ba)
     return item;
 }
 
+//---------------------------------------------------------
+//   addLazy
+//    add the image file path of the .mscz file archive
+//    without reading it; its data is inflated on first use.
+//    Returns nullptr if the name is not a hash name or an
+//    image of that name is in the store already, the caller
+//    has to read the data then. The name alone is not
+//    trusted for sharing an image.
+//---------------------------------------------------------
+
+ImageStoreItem* ImageStore::addLazy(const QString& path, const QString& archive)
+{
+    QByteArray hash;
+    if (!hashFromName(QFileInfo(path).completeBaseName(), &hash)) {
+        return nullptr;
+    }
+    for (ImageStoreItem* item : _items) {
+        if (item->hash() == hash) {
+            return nullptr;
+        }
+    }
+    std::shared_ptr<ImageArchive>& a = _archives[archive];
+    if (!a) {
+        a = std::make_shared<ImageArchive>(archive);
+    }
+    ImageStoreItem* item = new ImageStoreItem(path);
+    item->set(QByteArray(), hash);
+    item->setArchive(a);
+    _items.push_back(item);
+    return item;
+}
+
+//---------------------------------------------------------
+//   loadPending
+//    inflate all lazily added images, e.g. before their
+//    archive is overwritten
+//---------------------------------------------------------
+
+void ImageStore::loadPending()
+{
+    for (ImageStoreItem* item : _items) {
+        if (item->pending()) {
+            item->load();
+        }
+        item->releaseArchive();
+    }
+    _archives.clear();
+}
+
 //---------------------------------------------------------
 //   clearUnused
 //---------------------------------------------------------
@@ -223,5 +439,12 @@ void ImageStore::clearUnused()
     }),
         _items.end()
         );
+    for (auto i = _archives.begin(); i != _archives.end();) {
+        if (i->second.use_count() == 1) {
+            i = _archives.erase(i);
+        } else {
+            ++i;
+        }
+    }
 }
 }
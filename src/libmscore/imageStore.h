@@ -13,13 +13,19 @@
 #ifndef __IMAGE_CACHE_H__
 #define __IMAGE_CACHE_H__
 
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <QList>
 #include <QString>
 #include <QByteArray>
+#include <QSizeF>
 
 namespace Ms {
 class Image;
 class Score;
+struct ImageArchive;
 
 //---------------------------------------------------------
 //   ImageStoreItem
@@ -30,8 +36,15 @@ class ImageStoreItem
     QList<Image*> _references;
     QString _path;                  // original location of image
     QString _type;                  // image type (file extension)
-    QByteArray _buffer;
-    QByteArray _hash;               // 16 byte md4 hash of _buffer
+    mutable QByteArray _buffer;
+    mutable QByteArray _hash;       // 16 byte md4 hash of _buffer, taken from the name until inflated
+    std::shared_ptr<ImageArchive> _archive;     // .mscz file to inflate _path from on first use
+    mutable std::atomic<bool> _pending { false };
+    mutable std::once_flag _inflateOnce;
+    mutable std::once_flag _sizeOnce;
+    mutable QSizeF _imageSize;      // in pixels, read from the image header
+
+    void inflate() const;
 
 public:
     ImageStoreItem(const QString& p);
@@ -39,13 +52,17 @@ public:
     void reference(Image*);
 
     const QString& path() const { return _path; }
-    QByteArray& buffer() { return _buffer; }
-    const QByteArray& buffer() const { return _buffer; }
+    QByteArray& buffer() { inflate(); return _buffer; }
+    const QByteArray& buffer() const { inflate(); return _buffer; }
     bool loaded() const { return !_buffer.isEmpty(); }
+    bool pending() const { return _pending; }
+    void setArchive(std::shared_ptr<ImageArchive> archive);
+    void releaseArchive();
     void setPath(const QString& val);
     bool isUsed(Score*) const;
     bool isUsed() const { return !_references.empty(); }
     void load();
+    QSizeF imageSize() const;
     QString hashName() const;
     const QByteArray& hash() const { return _hash; }
     void set(const QByteArray& b, const QByteArray& h) { _buffer = b; _hash = h; }
@@ -59,6 +76,7 @@ class ImageStore
 {
     typedef std::vector<ImageStoreItem*> ItemList;
     ItemList _items;
+    std::map<QString, std::shared_ptr<ImageArchive> > _archives;     // opened once for all lazy items
 
 public:
     ImageStore() = default;
@@ -68,6 +86,8 @@ public:
 
     ImageStoreItem* getImage(const QString& path) const;
     ImageStoreItem* add(const QString& path, const QByteArray&);
+    ImageStoreItem* addLazy(const QString& path, const QString& archive);
+    void loadPending();
     void clearUnused();
 
     typedef ItemList::iterator iterator;
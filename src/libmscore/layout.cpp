@@ -12,6 +12,10 @@
 
 #include <cmath>
 #include <QtMath>
+#ifndef Q_OS_WASM
+#include <QtConcurrent>
+#include <QThreadPool>
+#endif
 
 #include "accidental.h"
 #include "barline.h"
@@ -27,6 +31,7 @@
 #include "keysig.h"
 #include "layoutbreak.h"
 #include "layout.h"
+#include "layoutcache.h"
 #include "lyrics.h"
 #include "marker.h"
 #include "measure.h"
@@ -3025,84 +3030,12 @@ std::pair<qreal, qreal> extendedStemLenWithTwoNoteTremolo(Tremolo* tremolo, qrea
 }
 
 //---------------------------------------------------------
-//   getNextMeasure
+//   layoutMeasureNotes
+//    accidentals, note lines, stems and beams of one measure
 //---------------------------------------------------------
 
-void Score::getNextMeasure(LayoutContext& lc)
+void Score::layoutMeasureNotes(LayoutContext& lc, Measure* measure)
 {
-    lc.prevMeasure = lc.curMeasure;
-    lc.curMeasure  = lc.nextMeasure;
-    if (!lc.curMeasure) {
-        lc.nextMeasure = _showVBox ? first() : firstMeasure();
-    } else {
-        lc.nextMeasure = _showVBox ? lc.curMeasure->next() : lc.curMeasure->nextMeasure();
-    }
-    if (!lc.curMeasure) {
-        return;
-    }
-
-    int mno = lc.adjustMeasureNo(lc.curMeasure);
-
-    if (lc.curMeasure->isMeasure()) {
-        if (score()->styleB(Sid::createMultiMeasureRests)) {
-            Measure* m = toMeasure(lc.curMeasure);
-            Measure* nm = m;
-            Measure* lm = nm;
-            int n       = 0;
-            Fraction len;
-
-            while (validMMRestMeasure(nm)) {
-                MeasureBase* mb = _showVBox ? nm->next() : nm->nextMeasure();
-                if (breakMultiMeasureRest(nm) && n) {
-                    break;
-                }
-                if (nm != m) {
-                    lc.adjustMeasureNo(nm);
-                }
-                ++n;
-                len += nm->ticks();
-                lm = nm;
-                if (!(mb && mb->isMeasure())) {
-                    break;
-                }
-                nm = toMeasure(mb);
-            }
-            if (n >= styleI(Sid::minEmptyMeasures)) {
-                createMMRest(m, lm, len);
-                lc.curMeasure  = m->mmRest();
-                lc.nextMeasure = _showVBox ? lm->next() : lm->nextMeasure();
-            } else {
-                if (m->mmRest()) {
-                    undo(new ChangeMMRest(m, 0));
-                }
-                m->setMMRestCount(0);
-                lc.measureNo = mno;
-            }
-        } else if (toMeasure(lc.curMeasure)->isMMRest()) {
-            qDebug("mmrest: no %d += %d", lc.measureNo, toMeasure(lc.curMeasure)->mmRestCount());
-            lc.measureNo += toMeasure(lc.curMeasure)->mmRestCount() - 1;
-        }
-    }
-    if (!lc.curMeasure->isMeasure()) {
-        lc.curMeasure->setTick(lc.tick);
-        return;
-    }
-
-    //-----------------------------------------
-    //    process one measure
-    //-----------------------------------------
-
-    Measure* measure = toMeasure(lc.curMeasure);
-    measure->moveTicks(lc.tick - measure->tick());
-
-    if (lineMode() && (measure->tick() < lc.startTick || measure->tick() > lc.endTick)) {
-        // needed to reset segment widths if they can change after measure width is computed
-        //for (Segment& s : measure->segments())
-        //      s.createShapes();
-        lc.tick += measure->ticks();
-        return;
-    }
-
     measure->connectTremolo();
 
     //
@@ -3201,27 +3134,15 @@ void Score::getNextMeasure(LayoutContext& lc)
     }
 
     createBeams(lc, measure);
+}
 
-    for (int staffIdx = 0; staffIdx < score()->nstaves(); ++staffIdx) {
-        for (Segment& segment : measure->segments()) {
-            if (segment.isChordRestType()) {
-                layoutChords1(&segment, staffIdx);
-                for (int voice = 0; voice < VOICES; ++voice) {
-                    ChordRest* cr = segment.cr(staffIdx * VOICES + voice);
-                    if (cr) {
-                        for (Lyrics* l : cr->lyrics()) {
-                            if (l) {
-                                l->layout();
-                            }
-                        }
-                    }
-                }
-            }
-        }
-    }
-
-    measure->computeTicks();
+//---------------------------------------------------------
+//   layoutMeasureElements
+//    breaths and symbols
+//---------------------------------------------------------
 
+static void layoutMeasureElements(Measure* measure)
+{
     for (Segment& segment : measure->segments()) {
         if (segment.isBreathType()) {
             for (Element* e : segment.elist()) {
@@ -3237,9 +3158,14 @@ void Score::getNextMeasure(LayoutContext& lc)
             }
         }
     }
+}
 
-    rebuildTempoAndTimeSigMaps(measure);
+//---------------------------------------------------------
+//   layoutStartRepeatBarLine
+//---------------------------------------------------------
 
+void Score::layoutStartRepeatBarLine(Measure* measure)
+{
     Segment* seg = measure->findSegmentR(SegmentType::StartRepeatBarLine, Fraction(0,1));
     if (measure->repeatStart()) {
         if (!seg) {
@@ -3256,7 +3182,15 @@ void Score::getNextMeasure(LayoutContext& lc)
     } else if (seg) {
         score()->undoRemoveElement(seg);
     }
+}
 
+//---------------------------------------------------------
+//   layoutMeasureChords
+//    lay out chords and create segment shapes
+//---------------------------------------------------------
+
+static void layoutMeasureChords(Measure* measure)
+{
     for (Segment& s : measure->segments()) {
         // TODO? maybe we do need to process it here to make it possible to enable later
         //if (!s.enabled())
@@ -3276,10 +3210,361 @@ void Score::getNextMeasure(LayoutContext& lc)
         }
         s.createShapes();
     }
+}
 
+//---------------------------------------------------------
+//   finishMeasureLayout
+//---------------------------------------------------------
+
+static void finishMeasureLayout(LayoutContext& lc, Measure* measure)
+{
+    measure->setLayoutValid(true);
+    ++lc.stats.measuresLaidOut;
     lc.tick += measure->ticks();
 }
 
+//---------------------------------------------------------
+//   continuesBeam
+//    true if a beam of the previous measure may continue
+//    into this one; createBeams() then modifies chords
+//    of the previous measure
+//---------------------------------------------------------
+
+static bool continuesBeam(const Measure* m)
+{
+    const Segment* s = m->first(SegmentType::ChordRest);
+    if (!s) {
+        return false;
+    }
+    for (const Element* e : s->elist()) {
+        if (e && e->isChordRest()) {
+            Beam::Mode mode = toChordRest(e)->beamMode();
+            if (mode == Beam::Mode::MID || mode == Beam::Mode::END) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+//---------------------------------------------------------
+//   layoutInParallel
+//    Parallel layout is used for measures which are laid
+//    out anyway. Tablature staves and cross-measure values
+//    change stems and beams while chords are laid out, and
+//    multimeasure rests are created on the fly, so those
+//    keep the sequential path.
+//---------------------------------------------------------
+
+bool Score::layoutInParallel(const Measure* m, const LayoutContext& lc) const
+{
+    if (MScore::layoutThreads < 2 || m->tick() < lc.startTick || m->tick() > lc.endTick) {
+        return false;
+    }
+    if (styleB(Sid::createMultiMeasureRests) || styleB(Sid::crossMeasureValues)) {
+        return false;
+    }
+    for (const Staff* staff : _staves) {
+        if (staff->isTabStaff(m->tick())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//---------------------------------------------------------
+//   removeBeamedHooks
+//    Chord::layout() removes the hook of a beamed chord
+//    through the undo stack; do it up front
+//---------------------------------------------------------
+
+static void removeBeamedHooks(Chord* chord)
+{
+    for (Chord* grace : chord->graceNotes()) {
+        removeBeamedHooks(grace);
+    }
+    if (chord->hook() && chord->beam()) {
+        chord->score()->undoRemoveElement(chord->hook());
+    }
+}
+
+static void removeBeamedHooks(Measure* measure)
+{
+    for (Segment* s = measure->first(SegmentType::ChordRest); s; s = s->next(SegmentType::ChordRest)) {
+        for (Element* e : s->elist()) {
+            if (e && e->isChord()) {
+                removeBeamedHooks(toChord(e));
+            }
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   layoutPool
+//    threads of the score laying out measures besides
+//    the calling thread
+//---------------------------------------------------------
+
+QThreadPool* Score::layoutPool()
+{
+    if (!_layoutPool) {
+        _layoutPool.reset(new QThreadPool);
+    }
+    _layoutPool->setMaxThreadCount(qMax(MScore::layoutThreads - 1, 1));
+    return _layoutPool.get();
+}
+
+//---------------------------------------------------------
+//   forEachMeasure
+//    run f for all measures of batch on up to
+//    MScore::layoutThreads threads, the calling thread
+//    included. Elements destroyed by the workers are
+//    processed on the calling thread after the join.
+//---------------------------------------------------------
+
+template<typename F>
+static void forEachMeasure(QThreadPool* pool, const std::vector<Measure*>& batch, F f)
+{
+#ifndef Q_OS_WASM
+    const int threads = qMin(MScore::layoutThreads, int(batch.size()));
+    std::vector<Score::DestroyedElements> destroyed(size_t(qMax(threads, 1)));
+    QVector<QFuture<void> > futures;
+    for (int t = 1; t < threads; ++t) {
+        futures.append(QtConcurrent::run(pool, [&batch, &f, &destroyed, t, threads]() {
+            Score::collectDestroyedElements(&destroyed[size_t(t)]);
+            for (size_t i = size_t(t); i < batch.size(); i += size_t(threads)) {
+                f(batch[i]);
+            }
+            Score::collectDestroyedElements(nullptr);
+        }));
+    }
+    for (size_t i = 0; i < batch.size(); i += size_t(qMax(threads, 1))) {
+        f(batch[i]);
+    }
+    for (QFuture<void>& future : futures) {
+        future.waitForFinished();
+    }
+    for (const Score::DestroyedElements& list : destroyed) {
+        Score::processDestroyedElements(list);
+    }
+#else
+    Q_UNUSED(pool);
+    for (Measure* m : batch) {
+        f(m);
+    }
+#endif
+}
+
+//---------------------------------------------------------
+//   layoutMeasuresParallel
+//    Lay out measure together with the following measures
+//    of the range. Work which reaches into other measures
+//    or into score wide state (beams, accidentals through
+//    the undo stack, tempo map, lyrics) runs in order, then
+//    the per measure chord layout and shapes are computed
+//    on the worker threads. The following measures are
+//    remembered in lc.laidOutAhead and taken as is by
+//    getNextMeasure().
+//---------------------------------------------------------
+
+void Score::layoutMeasuresParallel(LayoutContext& lc, Measure* measure)
+{
+    const size_t maxBatch = 4 * size_t(MScore::layoutThreads);
+    std::vector<Measure*> batch { measure };
+    Fraction tick = measure->endTick();
+    for (MeasureBase* mb = measure->next(); mb && mb->isMeasure() && batch.size() < maxBatch; mb = mb->next()) {
+        Measure* m = toMeasure(mb);
+        if (tick > lc.endTick || continuesBeam(m)) {
+            break;
+        }
+        m->moveTicks(tick - m->tick());
+        tick += m->ticks();
+        batch.push_back(m);
+    }
+
+    MeasureBase* prevMeasure = lc.prevMeasure;
+    for (size_t i = 0; i < batch.size(); ++i) {
+        Measure* m = batch[i];
+        if (i > 0) {
+            lc.prevMeasure = batch[i - 1];
+        }
+        layoutMeasureNotes(lc, m);
+        m->computeTicks();
+        rebuildTempoAndTimeSigMaps(m);
+        layoutStartRepeatBarLine(m);
+        removeBeamedHooks(m);
+    }
+    lc.prevMeasure = prevMeasure;
+
+    //! NOTE The workers look up measures, the ticks were moved above
+    updateMeasureIndex();
+
+    forEachMeasure(layoutPool(), batch, [this](Measure* m) {
+        for (int staffIdx = 0; staffIdx < nstaves(); ++staffIdx) {
+            for (Segment* s = m->first(SegmentType::ChordRest); s; s = s->next(SegmentType::ChordRest)) {
+                layoutChords1(s, staffIdx);
+            }
+        }
+    });
+
+    for (Measure* m : batch) {
+        for (Segment* s = m->first(SegmentType::ChordRest); s; s = s->next(SegmentType::ChordRest)) {
+            for (Element* e : s->elist()) {
+                if (e && e->isChordRest()) {
+                    for (Lyrics* l : toChordRest(e)->lyrics()) {
+                        if (l) {
+                            l->layout();
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    forEachMeasure(layoutPool(), batch, [](Measure* m) {
+        layoutMeasureElements(m);
+        layoutMeasureChords(m);
+    });
+
+    lc.laidOutAhead.insert(batch.begin() + 1, batch.end());
+}
+
+//---------------------------------------------------------
+//   getNextMeasure
+//---------------------------------------------------------
+
+void Score::getNextMeasure(LayoutContext& lc)
+{
+    lc.prevMeasure = lc.curMeasure;
+    lc.curMeasure  = lc.nextMeasure;
+    if (!lc.curMeasure) {
+        lc.nextMeasure = _showVBox ? first() : firstMeasure();
+    } else {
+        lc.nextMeasure = _showVBox ? lc.curMeasure->next() : lc.curMeasure->nextMeasure();
+    }
+    if (!lc.curMeasure) {
+        return;
+    }
+
+    int mno = lc.adjustMeasureNo(lc.curMeasure);
+
+    if (lc.curMeasure->isMeasure()) {
+        if (score()->styleB(Sid::createMultiMeasureRests)) {
+            Measure* m = toMeasure(lc.curMeasure);
+            Measure* nm = m;
+            Measure* lm = nm;
+            int n       = 0;
+            Fraction len;
+
+            while (validMMRestMeasure(nm)) {
+                MeasureBase* mb = _showVBox ? nm->next() : nm->nextMeasure();
+                if (breakMultiMeasureRest(nm) && n) {
+                    break;
+                }
+                if (nm != m) {
+                    lc.adjustMeasureNo(nm);
+                }
+                ++n;
+                len += nm->ticks();
+                lm = nm;
+                if (!(mb && mb->isMeasure())) {
+                    break;
+                }
+                nm = toMeasure(mb);
+            }
+            if (n >= styleI(Sid::minEmptyMeasures)) {
+                createMMRest(m, lm, len);
+                lc.curMeasure  = m->mmRest();
+                lc.nextMeasure = _showVBox ? lm->next() : lm->nextMeasure();
+            } else {
+                if (m->mmRest()) {
+                    undo(new ChangeMMRest(m, 0));
+                }
+                m->setMMRestCount(0);
+                lc.measureNo = mno;
+            }
+        } else if (toMeasure(lc.curMeasure)->isMMRest()) {
+            qDebug("mmrest: no %d += %d", lc.measureNo, toMeasure(lc.curMeasure)->mmRestCount());
+            lc.measureNo += toMeasure(lc.curMeasure)->mmRestCount() - 1;
+        }
+    }
+    if (!lc.curMeasure->isMeasure()) {
+        lc.curMeasure->setTick(lc.tick);
+        return;
+    }
+
+    //-----------------------------------------
+    //    process one measure
+    //-----------------------------------------
+
+    Measure* measure = toMeasure(lc.curMeasure);
+    measure->moveTicks(lc.tick - measure->tick());
+
+    if (lineMode() && (measure->tick() < lc.startTick || measure->tick() > lc.endTick)) {
+        // needed to reset segment widths if they can change after measure width is computed
+        //for (Segment& s : measure->segments())
+        //      s.createShapes();
+        lc.tick += measure->ticks();
+        ++lc.stats.measuresReused;
+        return;
+    }
+
+    if (lc.laidOutAhead.erase(measure)) {
+        finishMeasureLayout(lc, measure);
+        return;
+    }
+
+    //
+    // Every change of the layout inputs of a measure extends the
+    // CmdState range over it (a new clef or key signature up to the
+    // next one, a spanner over its ticks; style and staff type changes
+    // set layoutAll), so a measure past the range which was laid out
+    // before is taken as is, like measures outside the range in line
+    // mode; beams are laid out again when the system is collected.
+    // The first measure after the range is always recomputed,
+    // as beams and ties may continue into it.
+    //
+    if (MScore::reuseMeasureLayout && measure->layoutValid() && measure->tick() > lc.endTick
+        && measure->prevMeasure() && measure->prevMeasure()->tick() > lc.endTick) {
+        lc.tick += measure->ticks();
+        ++lc.stats.measuresReused;
+        return;
+    }
+
+    if (layoutInParallel(measure, lc)) {
+        layoutMeasuresParallel(lc, measure);
+        finishMeasureLayout(lc, measure);
+        return;
+    }
+
+    layoutMeasureNotes(lc, measure);
+
+    for (int staffIdx = 0; staffIdx < score()->nstaves(); ++staffIdx) {
+        for (Segment& segment : measure->segments()) {
+            if (segment.isChordRestType()) {
+                layoutChords1(&segment, staffIdx);
+                for (int voice = 0; voice < VOICES; ++voice) {
+                    ChordRest* cr = segment.cr(staffIdx * VOICES + voice);
+                    if (cr) {
+                        for (Lyrics* l : cr->lyrics()) {
+                            if (l) {
+                                l->layout();
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    measure->computeTicks();
+    layoutMeasureElements(measure);
+    rebuildTempoAndTimeSigMaps(measure);
+    layoutStartRepeatBarLine(measure);
+    layoutMeasureChords(measure);
+    finishMeasureLayout(lc, measure);
+}
+
 //---------------------------------------------------------
 //   isTopBeam
 //    returns true for the first CR of a beam that is not cross-staff
@@ -3981,6 +4266,7 @@ System* Score::collectSystem(LayoutContext& lc)
     if (!lc.curMeasure) {
         return 0;
     }
+    ++lc.stats.systemsCollected;
     const MeasureBase* measure  = _systems.empty() ? 0 : _systems.back()->measures().back();
     if (measure) {
         measure = measure->findPotentialSectionBreak();
@@ -3995,6 +4281,20 @@ System* Score::collectSystem(LayoutContext& lc)
     Fraction lcmTick = lc.curMeasure->tick();
     system->setInstrumentNames(lc.startWithLongNames, lcmTick);
 
+    // measures in this system according to the layout cache
+    std::vector<LayoutCache::MeasureEntry> cachedLayout;
+    int cachedMeasures = 0;
+    if (lc.layoutCache) {
+        const std::vector<LayoutCache::SystemEntry>& cs = lc.layoutCache->systems();
+        if (lc.cachedSystem < cs.size() && cs[lc.cachedSystem].tick == lcmTick) {
+            cachedLayout   = cs[lc.cachedSystem++].measures;
+            cachedMeasures = int(cachedLayout.size());
+        } else {
+            delete lc.layoutCache;
+            lc.layoutCache = nullptr;
+        }
+    }
+
     qreal minWidth    = 0;
     qreal layoutSystemMinWidth = 0;
     bool firstMeasure = true;
@@ -4039,8 +4339,9 @@ System* Score::collectSystem(LayoutContext& lc)
 
             m->createEndBarLines(true);
             // measures with nobreak cannot end a system
-            // thus they will not contain a trailer
-            if (m->noBreak()) {
+            // thus they will not contain a trailer,
+            // neither do measures the cached layout did not end a system with
+            if (m->noBreak() || int(system->measures().size()) < cachedMeasures) {
                 m->removeSystemTrailer();
             } else {
                 m->addSystemTrailer(m->nextMeasure());
@@ -4055,6 +4356,7 @@ System* Score::collectSystem(LayoutContext& lc)
             // vbox:
             getNextMeasure(lc);
             system->layout2();         // compute staff distances
+            lc.collectedSystems.insert(system);
             return system;
         }
         // check if lc.curMeasure fits, remove if not
@@ -4062,6 +4364,12 @@ System* Score::collectSystem(LayoutContext& lc)
 
         bool doBreak = (system->measures().size() > 1) && ((minWidth + ww) > systemWidth);
         if (doBreak) {
+            if (cachedMeasures) {
+                // the cached break does not fit anymore
+                delete lc.layoutCache;
+                lc.layoutCache = nullptr;
+                cachedMeasures = 0;
+            }
             breakMeasure = lc.curMeasure;
             system->removeLastMeasure();
             lc.curMeasure->setSystem(oldSystem);
@@ -4167,6 +4475,11 @@ System* Score::collectSystem(LayoutContext& lc)
         if (lineBreak || !mb || mb->isVBox() || mb->isTBox() || mb->isFBox() || tooWide) {
             break;
         }
+        // break where the cached layout did, without trying the next measure
+        if (cachedMeasures && int(system->measures().size()) >= cachedMeasures) {
+            ++lc.stats.systemsFromCache;
+            break;
+        }
     }
 
     if (lc.endTick < lc.prevMeasure->tick()) {
@@ -4248,11 +4561,16 @@ System* Score::collectSystem(LayoutContext& lc)
         }
     }
 
+    // the cached positions and widths apply if the system got the cached measures
+    const bool fromCache = cachedMeasures && int(system->measures().size()) == cachedMeasures;
+
     //
     // stretch incomplete row
     //
     qreal rest;
-    if (MScore::noHorizontalStretch) {
+    if (fromCache) {
+        rest = 0;
+    } else if (MScore::noHorizontalStretch) {
         rest = 0;
     } else {
         qreal mw          = system->leftMargin();          // DEBUG
@@ -4291,8 +4609,27 @@ System* Score::collectSystem(LayoutContext& lc)
     QPointF pos;
     firstMeasure = true;
     bool createBrackets = false;
+    int measureIdx = 0;
     for (MeasureBase* mb : system->measures()) {
         qreal ww = mb->width();
+        if (fromCache) {
+            const LayoutCache::MeasureEntry& me = cachedLayout[measureIdx++];
+            mb->setPos(me.x, 0.0);
+            if (mb->isMeasure()) {
+                Measure* m = toMeasure(mb);
+                m->stretchMeasure(me.width);
+                m->layoutStaffLines();
+                if (createBrackets) {
+                    system->addBrackets(m);
+                    createBrackets = false;
+                }
+            } else if (mb->isHBox()) {
+                mb->layout();
+                createBrackets = toHBox(mb)->createSystemHeader();
+            }
+            pos.rx() = me.x + me.width;
+            continue;
+        }
         if (mb->isMeasure()) {
             if (firstMeasure) {
                 pos.rx() += system->leftMargin();
@@ -4337,6 +4674,7 @@ System* Score::collectSystem(LayoutContext& lc)
         lc.startWithLongNames = lc.firstSystem && measure->sectionBreakElement()->startWithLongNames();
     }
 #endif
+    lc.collectedSystems.insert(system);
     return system;
 }
 
@@ -4933,6 +5271,8 @@ void LayoutContext::collectPage()
     qreal ey        = page->height() - page->bm();
     qreal y         = 0.0;
 
+    ++stats.pagesCollected;
+
     System* nextSystem = 0;
     int systemIdx = -1;
 
@@ -5024,6 +5364,9 @@ void LayoutContext::collectPage()
                     }
                 }
             }
+            if (nextSystem) {
+                ++stats.systemsReused;
+            }
         } else {
             nextSystem = score->collectSystem(*this);
             if (nextSystem) {
@@ -5161,7 +5504,34 @@ void LayoutContext::collectPage()
         page->bbox().setRect(0.0, 0.0, score->loWidth(), height + page->bm());
     }
 
-    page->rebuildBspTree();
+    invalidateBspTree(page);
+}
+
+//---------------------------------------------------------
+//   invalidateBspTree
+//    mark the systems of the page whose elements may have
+//    changed in this layout pass. The page notices itself
+//    the systems which moved or left the page.
+//---------------------------------------------------------
+
+void LayoutContext::invalidateBspTree(Page* p) const
+{
+    for (System* s : p->systems()) {
+        bool dirty = collectedSystems.count(s);
+        // collectPage() lays out again the spanners of all systems of the page,
+        // a spanner changes if another of its systems was laid out
+        for (int i = 0; !dirty && i < s->spannerSegments().size(); ++i) {
+            for (SpannerSegment* ss : s->spannerSegments()[i]->spanner()->spannerSegments()) {
+                if (ss->system() != s && collectedSystems.count(ss->system())) {
+                    dirty = true;
+                    break;
+                }
+            }
+        }
+        if (dirty) {
+            p->invalidateBspTree(s);
+        }
+    }
 }
 
 //---------------------------------------------------------
@@ -5219,6 +5589,16 @@ void Score::doLayoutRange(const Fraction& st, const Fraction& et)
         etick = last()->endTick();
     }
 
+    // system breaks read with the file only apply to the first full page layout
+    if (isMaster()) {
+        LayoutCache* layoutCache = masterScore()->takeLayoutCache();
+        if (layoutAll && !lineMode()) {
+            lc.layoutCache = layoutCache;
+        } else {
+            delete layoutCache;
+        }
+    }
+
     lc.endTick     = etick;
     _scoreFont     = ScoreFont::fontFactory(style().value(Sid::MusicalSymbolFont).toString());
     _noteHeadWidth = _scoreFont->width(SymId::noteheadBlack, spatium() / SPATIUM20);
@@ -5394,9 +5774,10 @@ void LayoutContext::layout()
     } else {
         Page* p = curSystem->page();
         if (p && (p != page)) {
-            p->rebuildBspTree();
+            invalidateBspTree(p);
         }
     }
+    stats.systemsReused += systemList.size();
     score->systems().append(systemList);       // TODO
 }
 
@@ -5416,10 +5797,16 @@ LayoutContext::LayoutContext(Score* s)
 
 LayoutContext::~LayoutContext()
 {
+    delete layoutCache;
+    score->setLayoutStatistics(stats);
+
     for (Spanner* s : processedSpanners) {
         s->layoutSystemsDone();
     }
 
+    //! NOTE The pages may be painted on several threads
+    score->updateMeasureIndex();
+
     for (MuseScoreView* v : score->getViewer()) {
         v->layoutChanged();
     }
@@ -16,11 +16,13 @@
 #include <set>
 #include <QList>
 
+#include "score.h"
 #include "system.h"
 
 namespace Ms {
 class Segment;
 class Page;
+class LayoutCache;
 
 //---------------------------------------------------------
 //   VerticalStretchData
@@ -105,6 +107,12 @@ struct LayoutContext {
     int measureNo            { 0 };
     Fraction startTick;
     Fraction endTick;
+    std::set<Measure*> laidOutAhead;      // measures already processed by layoutMeasuresParallel()
+    LayoutCache* layoutCache { 0 };       // system layout read with the file, dropped on first mismatch
+    size_t cachedSystem      { 0 };       // index of the next system in layoutCache
+    std::set<System*> collectedSystems;   // systems laid out in this pass
+
+    LayoutStatistics stats;
 
     LayoutContext(Score* s);
     LayoutContext(const LayoutContext&) = delete;
@@ -117,6 +125,7 @@ struct LayoutContext {
     int adjustMeasureNo(MeasureBase*);
     void getNextPage();
     void collectPage();
+    void invalidateBspTree(Page* p) const;
 };
 
 //---------------------------------------------------------
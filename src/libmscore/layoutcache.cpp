@@ -0,0 +1,176 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+#include <QBuffer>
+#include <QCryptographicHash>
+#include <QFontInfo>
+#include <QFontMetricsF>
+#include <QSysInfo>
+
+#include "config.h"
+#include "layoutcache.h"
+#include "measurebase.h"
+#include "mscore.h"
+#include "score.h"
+#include "style.h"
+#include "sym.h"
+#include "system.h"
+#include "xml.h"
+
+namespace Ms {
+const char* LayoutCache::fileName = "Layout/layout.xml";
+
+//---------------------------------------------------------
+//   addFontMetrics
+//    metrics of the text fonts named by the style and of
+//    the musical symbol font, as resolved on this machine
+//---------------------------------------------------------
+
+static void addFontMetrics(QCryptographicHash& hash, const Score* score)
+{
+    static const QString sample("AaBbGgJjQq0123456789");
+    auto addValue = [&hash](qreal v) { hash.addData(QByteArray::number(v, 'f', 3)); };
+
+    for (int i = 0; i < int(Sid::STYLES); ++i) {
+        const Sid sid = Sid(i);
+        if (sid != Sid::MusicalTextFont && !QByteArray(MStyle::valueName(sid)).endsWith("FontFace")) {
+            continue;
+        }
+        QFont font(score->styleSt(sid));
+        font.setPointSizeF(20.0);
+        QFontMetricsF fm(font, MScore::paintDevice());
+        hash.addData(QFontInfo(font).family().toUtf8());
+        addValue(fm.ascent());
+        addValue(fm.descent());
+        addValue(fm.width(sample));
+    }
+
+    ScoreFont* sf = ScoreFont::fontFactory(score->styleSt(Sid::MusicalSymbolFont));
+    hash.addData(sf->name().toUtf8());
+    for (SymId id : { SymId::noteheadBlack, SymId::gClef, SymId::accidentalSharp, SymId::flag8thUp }) {
+        const QRectF r = sf->bbox(id, 1.0);
+        addValue(r.x());
+        addValue(r.y());
+        addValue(r.width());
+        addValue(r.height());
+    }
+}
+
+//---------------------------------------------------------
+//   computeKey
+//    The layout depends on the score, its style and on
+//    the font metrics of the machine and program version
+//    which laid it out.
+//---------------------------------------------------------
+
+QByteArray LayoutCache::computeKey(const QByteArray& mscxDigest, const Score* score)
+{
+    QBuffer style;
+    style.open(QIODevice::WriteOnly);
+    XmlWriter xml(nullptr, &style);
+    const_cast<Score*>(score)->style().save(xml, false);
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(mscxDigest);
+    hash.addData(style.data());
+    addFontMetrics(hash, score);
+    hash.addData(VERSION);
+    hash.addData(QByteArray::number(MSCVERSION));
+    hash.addData(QSysInfo::buildAbi().toUtf8());
+    return hash.result().toHex();
+}
+
+//---------------------------------------------------------
+//   collect
+//---------------------------------------------------------
+
+void LayoutCache::collect(const Score* score)
+{
+    _systems.clear();
+    for (const System* system : score->systems()) {
+        if (system->measures().empty()) {
+            continue;
+        }
+        SystemEntry se;
+        se.tick = system->measures().front()->tick();
+        for (const MeasureBase* mb : system->measures()) {
+            se.measures.push_back({ mb->x(), mb->width() });
+        }
+        _systems.push_back(se);
+    }
+}
+
+//---------------------------------------------------------
+//   write
+//---------------------------------------------------------
+
+void LayoutCache::write(XmlWriter& xml) const
+{
+    xml << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+    xml.stag("LayoutCache");
+    xml.tag("key", QString::fromLatin1(_key));
+    // positions are written with full precision so the restored layout is identical
+    for (const SystemEntry& se : _systems) {
+        xml.stag(QString("System tick=\"%1\"").arg(se.tick.toString()));
+        for (const MeasureEntry& me : se.measures) {
+            xml.tagE(QString("Measure x=\"%1\" width=\"%2\"")
+                     .arg(QString::number(me.x, 'g', 17)).arg(QString::number(me.width, 'g', 17)));
+        }
+        xml.etag();
+    }
+    xml.etag();
+}
+
+//---------------------------------------------------------
+//   read
+//    return false if the data is not a layout cache
+//---------------------------------------------------------
+
+bool LayoutCache::read(XmlReader& e)
+{
+    _key.clear();
+    _systems.clear();
+    if (!e.readNextStartElement() || e.name() != "LayoutCache") {
+        return false;
+    }
+    while (e.readNextStartElement()) {
+        const QStringRef& tag(e.name());
+        if (tag == "key") {
+            _key = e.readElementText().toLatin1();
+        } else if (tag == "System") {
+            SystemEntry se;
+            se.tick = Fraction::fromString(e.attribute("tick"));
+            while (e.readNextStartElement()) {
+                if (e.name() == "Measure") {
+                    se.measures.push_back({ e.doubleAttribute("x"), e.doubleAttribute("width") });
+                }
+                e.skipCurrentElement();
+            }
+            if (se.measures.empty()) {
+                _systems.clear();
+                return false;
+            }
+            _systems.push_back(se);
+        } else {
+            e.skipCurrentElement();
+        }
+    }
+    return !_key.isEmpty() && !e.hasError();
+}
+}
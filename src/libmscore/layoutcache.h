@@ -0,0 +1,74 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+#ifndef __LAYOUTCACHE_H__
+#define __LAYOUTCACHE_H__
+
+#include <vector>
+#include <QByteArray>
+
+#include "fraction.h"
+
+namespace Ms {
+class Score;
+class XmlReader;
+class XmlWriter;
+
+//---------------------------------------------------------
+//   LayoutCache
+//    System breaks, measure positions and measure widths
+//    of a laid out score, saved next to the .mscx in a
+//    .mscz file. The key covers the .mscx digest,
+//    the active style, the font metrics and the program
+//    version; the cache is only used by the first full
+//    layout after loading a file whose key matches.
+//---------------------------------------------------------
+
+class LayoutCache
+{
+public:
+    struct MeasureEntry {
+        qreal x { 0.0 };        // position in the system
+        qreal width { 0.0 };    // stretched width
+    };
+
+    struct SystemEntry {
+        Fraction tick;                        // tick of the first measure
+        std::vector<MeasureEntry> measures;   // measures and frames in the system
+    };
+
+    static const char* fileName;
+
+    static QByteArray computeKey(const QByteArray& mscxDigest, const Score* score);
+
+    void collect(const Score* score);
+    void write(XmlWriter& xml) const;
+    bool read(XmlReader& e);
+
+    const QByteArray& key() const { return _key; }
+    void setKey(const QByteArray& key) { _key = key; }
+    const std::vector<SystemEntry>& systems() const { return _systems; }
+    bool empty() const { return _systems.empty(); }
+
+private:
+    QByteArray _key;
+    std::vector<SystemEntry> _systems;
+};
+}     // namespace Ms
+#endif
@@ -3386,6 +3386,18 @@ QVariant Measure::propertyDefault(Pid propertyId) const
     return MeasureBase::propertyDefault(propertyId);
 }
 
+//---------------------------------------------------------
+//   setMMRest
+//---------------------------------------------------------
+
+void Measure::setMMRest(Measure* m)
+{
+    if (m_mmRest != m) {
+        m_mmRest = m;
+        score()->invalidateMeasureIndex();
+    }
+}
+
 //-------------------------------------------------------------------
 //   mmRestFirst
 //    this is a multi measure rest
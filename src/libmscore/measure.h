@@ -290,9 +290,11 @@ public:
     bool isMMRest() const { return m_mmRestCount > 0; }
     Measure* mmRest() const { return m_mmRest; }
     const Measure* mmRest1() const;
-    void setMMRest(Measure* m) { m_mmRest = m; }
+    void setMMRest(Measure* m);
     int mmRestCount() const { return m_mmRestCount; }            // number of measures m_mmRest spans
     void setMMRestCount(int n) { m_mmRestCount = n; }
+    bool layoutValid() const { return m_layoutValid; }
+    void setLayoutValid(bool v) { m_layoutValid = v; }
     Measure* mmRestFirst() const;
     Measure* mmRestLast() const;
 
@@ -353,6 +355,8 @@ private:
                                // 0 if this is the start of am mmrest (m_mmRest != 0)
                                // < 0 if this measure is covered by an mmrest
 
+    bool m_layoutValid { false };  // processed by getNextMeasure() since it was created
+
     int m_playbackCount { 0 };  // temp. value used in RepeatList
                                 // counts how many times this measure was already played
 
@@ -183,6 +183,32 @@ Measure* MeasureBase::nextMeasure() const
     return toMeasure(m);
 }
 
+//---------------------------------------------------------
+//   setNext
+//    the score keeps an index of its measures by tick,
+//    anything that moves a measure invalidates it
+//---------------------------------------------------------
+
+void MeasureBase::setNext(MeasureBase* e)
+{
+    if (_next != e) {
+        _next = e;
+        score()->invalidateMeasureIndex();
+    }
+}
+
+//---------------------------------------------------------
+//   setPrev
+//---------------------------------------------------------
+
+void MeasureBase::setPrev(MeasureBase* e)
+{
+    if (_prev != e) {
+        _prev = e;
+        score()->invalidateMeasureIndex();
+    }
+}
+
 //---------------------------------------------------------
 //   nextMeasureMM
 //---------------------------------------------------------
@@ -323,6 +349,18 @@ Fraction MeasureBase::tick() const
     return mb ? mb->_tick : Fraction(-1, 1);
 }
 
+//---------------------------------------------------------
+//   setTick
+//---------------------------------------------------------
+
+void MeasureBase::setTick(const Fraction& f)
+{
+    if (_tick != f) {
+        _tick = f;
+        score()->invalidateMeasureIndex();
+    }
+}
+
 //---------------------------------------------------------
 //   triggerLayout
 //---------------------------------------------------------
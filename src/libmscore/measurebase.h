@@ -90,10 +90,10 @@ public:
 
     MeasureBase* next() const { return _next; }
     MeasureBase* nextMM() const;
-    void setNext(MeasureBase* e) { _next = e; }
+    void setNext(MeasureBase* e);
     MeasureBase* prev() const { return _prev; }
     MeasureBase* prevMM() const;
-    void setPrev(MeasureBase* e) { _prev = e; }
+    void setPrev(MeasureBase* e);
     MeasureBase* top() const;
 
     Ms::Measure* nextMeasure() const;
@@ -128,7 +128,7 @@ public:
     virtual bool readProperties(XmlReader&) override;
 
     Fraction tick() const override;
-    void setTick(const Fraction& f) { _tick = f; }
+    void setTick(const Fraction& f);
 
     Fraction ticks() const { return _len; }
     void setTicks(const Fraction& f) { _len = f; }
@@ -12,6 +12,7 @@
 
 #include <QDir>
 #include <QSettings>
+#include <QStandardPaths>
 #include <QFontDatabase>
 
 #include "config.h"
@@ -116,6 +117,10 @@ int MScore::mtcType;
 
 bool MScore::noExcerpts = false;
 bool MScore::noImages = false;
+int MScore::layoutThreads = 1;
+bool MScore::saveLayoutCache = true;
+bool MScore::reuseMeasureLayout = true;
+QString MScore::fontMetricsCache;
 bool MScore::pdfPrinting = false;
 bool MScore::svgPrinting = false;
 
@@ -251,6 +256,30 @@ static Spatium doubleToSpatium(double d)
     return Spatium(d);
 }
 
+//---------------------------------------------------------
+//   registerConverters
+//    property values are converted through QVariant also
+//    without a UI, e.g. by the converter
+//---------------------------------------------------------
+
+static void registerConverters()
+{
+    if (!QMetaType::registerConverter<Spatium, double>(&Spatium::toDouble)) {
+        qFatal("registerConverter Spatium::toDouble failed");
+    }
+    if (!QMetaType::registerConverter<double, Spatium>(&doubleToSpatium)) {
+        qFatal("registerConverter doubleToSpatium failed");
+    }
+//      if (!QMetaType::registerComparators<Spatium>())
+//            qFatal("registerComparators for Spatium failed");
+
+    qRegisterMetaType<Fraction>("Fraction");
+
+    if (!QMetaType::registerConverter<Fraction, QString>(&Fraction::toString)) {
+        qFatal("registerConverter Fraction::toString failed");
+    }
+}
+
 //---------------------------------------------------------
 //   init
 //---------------------------------------------------------
@@ -342,6 +371,13 @@ void MScore::init()
         }
     }
 
+#ifndef Q_OS_WASM
+    if (fontMetricsCache.isNull()) {
+        QString cacheDir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+        fontMetricsCache = cacheDir.isEmpty() ? QString("") : cacheDir + "/fontmetrics/";
+    }
+#endif
+    registerConverters();
     initScoreFonts();
     StaffType::initStaffTypes();
     initDrumset();
@@ -356,15 +392,6 @@ void MScore::init()
 
 void MScore::registerUiTypes()
 {
-    if (!QMetaType::registerConverter<Spatium, double>(&Spatium::toDouble)) {
-        qFatal("registerConverter Spatium::toDouble failed");
-    }
-    if (!QMetaType::registerConverter<double, Spatium>(&doubleToSpatium)) {
-        qFatal("registerConverter doubleToSpatium failed");
-    }
-//      if (!QMetaType::registerComparators<Spatium>())
-//            qFatal("registerComparators for Spatium failed");
-
 #ifdef SCRIPT_INTERFACE
     qRegisterMetaType<Note::ValueType>("ValueType");
 
@@ -391,11 +418,6 @@ void MScore::registerUiTypes()
 //      qRegisterMetaType<MSQE_StyledPropertyListIdx::E>("StyledPropertyListIdx");
 //      qRegisterMetaType<MSQE_BarLineType::E>("BarLineType");
 #endif
-    qRegisterMetaType<Fraction>("Fraction");
-
-    if (!QMetaType::registerConverter<Fraction, QString>(&Fraction::toString)) {
-        qFatal("registerConverter Fraction::toString failed");
-    }
 }
 
 //---------------------------------------------------------
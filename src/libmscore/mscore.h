@@ -389,6 +389,10 @@ public:
 
     static bool noExcerpts;
     static bool noImages;
+    static int layoutThreads;       // threads laying out measures; 1 is sequential
+    static bool saveLayoutCache;    // save and reuse system breaks, measure positions and widths in .mscz files
+    static bool reuseMeasureLayout; // keep the layout of the measures past the edited range
+    static QString fontMetricsCache;    // directory of the score font metrics caches, empty: no cache
 
     static bool pdfPrinting;
     static bool svgPrinting;
@@ -57,6 +57,7 @@
 #include "bagpembell.h"
 #include "hairpin.h"
 #include "textline.h"
+#include "taghash.h"
 #include <QPointF>
 #include <QtMath>
 #include <QVector2D>
@@ -1554,67 +1555,100 @@ void Note::read(XmlReader& e)
 
 bool Note::readProperties(XmlReader& e)
 {
+    static const TagIndex tags {
+        "pitch", "tpc", "track", "Accidental", "Spanner", "tpc2", "small", "mirror", "dotPosition", "fixed",
+        "fixedLine", "headScheme", "head", "velocity", "play", "tuning", "fret", "string", "ghost", "headType",
+        "veloType", "line", "Fingering", "Symbol", "Image", "Bend", "NoteDot", "Events", "offset"
+    };
     const QStringRef& tag(e.name());
 
-    if (tag == "pitch") {
+    switch (tags.hash(tag)) {
+    case tagHash("pitch"):
         _pitch = e.readInt();
-    } else if (tag == "tpc") {
+        break;
+    case tagHash("tpc"):
         _tpc[0] = e.readInt();
         _tpc[1] = _tpc[0];
-    } else if (tag == "track") {          // for performance
+        break;
+    case tagHash("track"):                // for performance
         setTrack(e.readInt());
-    } else if (tag == "Accidental") {
+        break;
+    case tagHash("Accidental"): {
         Accidental* a = new Accidental(score());
         a->setTrack(track());
         a->read(e);
         add(a);
-    } else if (tag == "Spanner") {
+    }
+    break;
+    case tagHash("Spanner"):
         Spanner::readSpanner(e, this, track());
-    } else if (tag == "tpc2") {
+        break;
+    case tagHash("tpc2"):
         _tpc[1] = e.readInt();
-    } else if (tag == "small") {
+        break;
+    case tagHash("small"):
         setSmall(e.readInt());
-    } else if (tag == "mirror") {
+        break;
+    case tagHash("mirror"):
         readProperty(e, Pid::MIRROR_HEAD);
-    } else if (tag == "dotPosition") {
+        break;
+    case tagHash("dotPosition"):
         readProperty(e, Pid::DOT_POSITION);
-    } else if (tag == "fixed") {
+        break;
+    case tagHash("fixed"):
         setFixed(e.readBool());
-    } else if (tag == "fixedLine") {
+        break;
+    case tagHash("fixedLine"):
         setFixedLine(e.readInt());
-    } else if (tag == "headScheme") {
+        break;
+    case tagHash("headScheme"):
         readProperty(e, Pid::HEAD_SCHEME);
-    } else if (tag == "head") {
+        break;
+    case tagHash("head"):
         readProperty(e, Pid::HEAD_GROUP);
-    } else if (tag == "velocity") {
+        break;
+    case tagHash("velocity"):
         setVeloOffset(e.readInt());
-    } else if (tag == "play") {
+        break;
+    case tagHash("play"):
         setPlay(e.readInt());
-    } else if (tag == "tuning") {
+        break;
+    case tagHash("tuning"):
         setTuning(e.readDouble());
-    } else if (tag == "fret") {
+        break;
+    case tagHash("fret"):
         setFret(e.readInt());
-    } else if (tag == "string") {
+        break;
+    case tagHash("string"):
         setString(e.readInt());
-    } else if (tag == "ghost") {
+        break;
+    case tagHash("ghost"):
         setGhost(e.readInt());
-    } else if (tag == "headType") {
+        break;
+    case tagHash("headType"):
         readProperty(e, Pid::HEAD_TYPE);
-    } else if (tag == "veloType") {
+        break;
+    case tagHash("veloType"):
         readProperty(e, Pid::VELO_TYPE);
-    } else if (tag == "line") {
+        break;
+    case tagHash("line"):
         setLine(e.readInt());
-    } else if (tag == "Fingering") {
+        break;
+    case tagHash("Fingering"): {
         Fingering* f = new Fingering(score());
         f->setTrack(track());
         f->read(e);
         add(f);
-    } else if (tag == "Symbol") {
+    }
+    break;
+    case tagHash("Symbol"): {
         Symbol* s = new Symbol(score());
         s->setTrack(track());
         s->read(e);
         add(s);
-    } else if (tag == "Image") {
+    }
+    break;
+    case tagHash("Image"):
         if (MScore::noImages) {
             e.skipCurrentElement();
         } else {
@@ -1623,16 +1657,21 @@ bool Note::readProperties(XmlReader& e)
             image->read(e);
             add(image);
         }
-    } else if (tag == "Bend") {
+        break;
+    case tagHash("Bend"): {
         Bend* b = new Bend(score());
         b->setTrack(track());
         b->read(e);
         add(b);
-    } else if (tag == "NoteDot") {
+    }
+    break;
+    case tagHash("NoteDot"): {
         NoteDot* dot = new NoteDot(score());
         dot->read(e);
         add(dot);
-    } else if (tag == "Events") {
+    }
+    break;
+    case tagHash("Events"):
         _playEvents.clear();        // remove default event
         while (e.readNextStartElement()) {
             const QStringRef& t(e.name());
@@ -1647,11 +1686,12 @@ bool Note::readProperties(XmlReader& e)
         if (chord()) {
             chord()->setPlayEventType(PlayEventType::User);
         }
-    } else if (tag == "offset") {
+        break;
+    case tagHash("offset"):
         Element::readProperties(e);
-    } else if (Element::readProperties(e)) {
-    } else {
-        return false;
+        break;
+    default:
+        return Element::readProperties(e);
     }
     return true;
 }
@@ -60,7 +60,7 @@ QList<Element*> Page::items(const QRectF& r)
 {
 #ifdef USE_BSP
     if (!bspTreeValid) {
-        doRebuildBspTree();
+        updateBspTree();
     }
     QList<Element*> el = bspTree.items(r);
     return el;
@@ -74,7 +74,7 @@ QList<Element*> Page::items(const QPointF& p)
 {
 #ifdef USE_BSP
     if (!bspTreeValid) {
-        doRebuildBspTree();
+        updateBspTree();
     }
     return bspTree.items(p);
 #else
@@ -234,31 +234,70 @@ void Page::scanElements(void* data, void (* func)(void*, Element*), bool all)
     }
 }
 
+//---------------------------------------------------------
+//   rebuildBspTree
+//    all elements may have changed
+//---------------------------------------------------------
+
+void Page::rebuildBspTree()
+{
 #ifdef USE_BSP
+    bspTreeFull = true;
+#endif
+    bspTreeValid = false;
+}
+
 //---------------------------------------------------------
-//   bspInsert
+//   invalidateBspTree
+//    the elements of system may have changed, the other
+//    systems of the page are kept in the tree
 //---------------------------------------------------------
 
-static void bspInsert(void* bspTree, Element* e)
+void Page::invalidateBspTree(System* system)
 {
-    ((BspTree*)bspTree)->insert(e);
+#ifdef USE_BSP
+    bspDirtySystems.insert(system);
+#else
+    Q_UNUSED(system);
+#endif
+    bspTreeValid = false;
 }
 
-static void countElements(void* data, Element* /*e*/)
+#ifdef USE_BSP
+//---------------------------------------------------------
+//   collectElements
+//---------------------------------------------------------
+
+static void collectElements(void* data, Element* e)
 {
-    ++(*(int*)data);
+    static_cast<std::vector<Element*>*>(data)->push_back(e);
 }
 
 //---------------------------------------------------------
-//   doRebuildBspTree
+//   systemGeometry
+//    the positions the page rectangles of the elements of
+//    a system depend on, besides the layout of the system
 //---------------------------------------------------------
 
-void Page::doRebuildBspTree()
+static std::vector<qreal> systemGeometry(System* system)
 {
-    int n = 0;
-    scanElements(&n, countElements, false);
+    std::vector<qreal> g;
+    g.reserve(2 + system->staves()->size());
+    QPointF p = system->pagePos();
+    g.push_back(p.x());
+    g.push_back(p.y());
+    for (const SysStaff* ss : *system->staves()) {
+        g.push_back(ss->show() ? ss->y() : -1.0);
+    }
+    return g;
+}
 
-    QRectF r;
+//---------------------------------------------------------
+//   bspTreeRect
+//---------------------------------------------------------
+
+QRectF Page::bspTreeRect() const
+{
     if (score()->layoutMode() == LayoutMode::LINE) {
         qreal w = 0.0;
         qreal h = 0.0;
@@ -269,16 +308,144 @@ void Page::doRebuildBspTree()
                 w = mb->x() + mb->width();
             }
         }
-        r = QRectF(0.0, 0.0, w, h);
-    } else {
-        r = abbox();
+        return QRectF(0.0, 0.0, w, h);
+    }
+    return abbox();
+}
+
+//---------------------------------------------------------
+//   doRebuildBspTree
+//---------------------------------------------------------
+
+void Page::doRebuildBspTree(const QRectF& r)
+{
+    bspSystems.clear();
+    size_t n = 0;
+    for (System* s : qAsConst(_systems)) {
+        BspSystem& bs = bspSystems[s];
+        s->scanElements(&bs.items, collectElements, false);
+        bs.geometry = systemGeometry(s);
+        n += bs.items.size();
     }
+    bool page = visible() || score()->showInvisible();
 
-    bspTree.initialize(r, n);
-    scanElements(&bspTree, &bspInsert, false);
+    bspTree.initialize(r, int(n) + (page ? 1 : 0));
+    for (System* s : qAsConst(_systems)) {
+        for (Element* e : bspSystems[s].items) {
+            bspTree.insert(e);
+        }
+    }
+    if (page) {
+        bspTree.insert(this);
+    }
+
+    bspDirtySystems.clear();
+    bspTreeFull = false;
     bspTreeValid = true;
 }
 
+//---------------------------------------------------------
+//   updateBspTree
+//    Layout marks the systems it has laid out with
+//    invalidateBspTree(). Only the elements of those
+//    systems, of the systems which moved and of the ones
+//    which left or joined the page are removed and
+//    reinserted, the other systems are not visited.
+//    The tree is built from scratch after rebuildBspTree()
+//    or if the page size or the number of elements needs a
+//    different tree.
+//---------------------------------------------------------
+
+void Page::updateBspTree()
+{
+    QRectF r = bspTreeRect();
+    if (bspTreeFull || bspTree.isEmpty() || bspTree.boundingRect() != r) {
+        doRebuildBspTree(r);
+        return;
+    }
+
+    std::unordered_set<System*> onPage(_systems.begin(), _systems.end());
+    std::vector<System*> gone;
+    for (const auto& i : bspSystems) {
+        if (!onPage.count(i.first)) {
+            gone.push_back(i.first);
+        }
+    }
+
+    std::vector<std::pair<System*, BspSystem> > changed;
+    for (System* s : qAsConst(_systems)) {
+        auto i = bspSystems.find(s);
+        std::vector<qreal> geometry = systemGeometry(s);
+        if (i != bspSystems.end() && !bspDirtySystems.count(s) && i->second.geometry == geometry) {
+            continue;
+        }
+        BspSystem bs;
+        s->scanElements(&bs.items, collectElements, false);
+        bs.geometry = std::move(geometry);
+        changed.push_back({ s, std::move(bs) });
+    }
+    if (changed.size() == size_t(_systems.size())) {
+        doRebuildBspTree(r);
+        return;
+    }
+
+    int n = (visible() || score()->showInvisible()) ? 1 : 0;
+    for (System* s : qAsConst(_systems)) {
+        n += int(bspSystems[s].items.size());
+    }
+    for (const auto& c : changed) {
+        n += int(c.second.items.size()) - int(bspSystems[c.first].items.size());
+    }
+    if (int(bspTree.treeDepth()) != BspTree::depthForItemCount(n)) {
+        doRebuildBspTree(r);
+        return;
+    }
+
+    // removing uses the rectangles the items were inserted with,
+    // the old elements may be deleted already. Everything is removed
+    // before anything is inserted, a new element may have the address
+    // of a deleted one
+    for (System* s : gone) {
+        for (Element* e : bspSystems[s].items) {
+            bspTree.remove(e);
+        }
+        bspSystems.erase(s);
+    }
+    for (const auto& c : changed) {
+        auto i = bspSystems.find(c.first);
+        if (i != bspSystems.end()) {
+            for (Element* e : i->second.items) {
+                bspTree.remove(e);
+            }
+        }
+    }
+    for (auto& c : changed) {
+        for (Element* e : c.second.items) {
+            bspTree.insert(e);
+        }
+        bspSystems[c.first] = std::move(c.second);
+    }
+
+    bspDirtySystems.clear();
+    bspTreeValid = true;
+
+#ifndef NDEBUG
+    if (MScore::debugMode) {
+        std::vector<Element*> elements;
+        scanElements(&elements, collectElements, false);
+        BspTree full;
+        full.initialize(r, int(elements.size()));
+        for (Element* e : elements) {
+            full.insert(e);
+        }
+        if (!bspTree.hasSameItems(full)) {
+            qWarning("Page %d: incremental bsp tree update differs from full rebuild", _no);
+            doRebuildBspTree(r);
+        }
+    }
+#endif
+}
+
 #endif
 
 //---------------------------------------------------------
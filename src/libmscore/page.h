@@ -13,6 +13,10 @@
 #ifndef __PAGE_H__
 #define __PAGE_H__
 
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
 #include "config.h"
 #include "element.h"
 #include "bsp.h"
@@ -35,8 +39,17 @@ class Page final : public Element
     QList<System*> _systems;
     int _no;                        // page number
 #ifdef USE_BSP
+    struct BspSystem {
+        std::vector<Element*> items;        // elements of the system in the tree
+        std::vector<qreal> geometry;        // system and staff positions the items were inserted with
+    };
     BspTree bspTree;
-    void doRebuildBspTree();
+    std::unordered_map<System*, BspSystem> bspSystems;
+    std::unordered_set<System*> bspDirtySystems;
+    bool bspTreeFull { true };              // next update has to rebuild the whole tree
+    QRectF bspTreeRect() const;
+    void doRebuildBspTree(const QRectF& r);
+    void updateBspTree();
 #endif
     bool bspTreeValid;
 
@@ -76,7 +89,8 @@ public:
 
     QList<Element*> items(const QRectF& r);
     QList<Element*> items(const QPointF& p);
-    void rebuildBspTree() { bspTreeValid = false; }
+    void rebuildBspTree();
+    void invalidateBspTree(System* system);
     QPointF pagePos() const override { return QPointF(); }       ///< position in page coordinates
     QList<Element*> elements() const;           ///< list of visible elements
     QRectF tbbox();                             // tight bounding box, excluding white space
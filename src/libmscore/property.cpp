@@ -29,6 +29,7 @@
 #include "sym.h"
 #include "changeMap.h"
 #include "fret.h"
+#include "taghash.h"
 
 namespace Ms {
 //---------------------------------------------------------
@@ -379,12 +380,10 @@ static constexpr PropertyMetaData propertyList[] = {
 
 Pid propertyId(const QStringRef& s)
 {
-    for (const PropertyMetaData& pd : propertyList) {
-        if (pd.name == s) {
-            return pd.id;
-        }
-    }
-    return Pid::END;
+    static const TagIndex index(propertyList, int(sizeof(propertyList) / sizeof(*propertyList)),
+                                [](const PropertyMetaData& pd) { return pd.name; });
+    int idx = index.find(s);
+    return idx >= 0 ? propertyList[idx].id : Pid::END;
 }
 
 //---------------------------------------------------------
@@ -15,6 +15,7 @@
  render score into event list
 */
 
+#include <limits>
 #include <set>
 #include <cmath>
 
@@ -2559,11 +2560,154 @@ void MidiRenderer::updateState()
         score->updateCapo();
 
         updateChunksPartition();
+        updateChangedChunks();
 
         needUpdate = false;
     }
 }
 
+//---------------------------------------------------------
+//   MidiRenderer::setScoreChanged
+///   Marks the score ticks [tick1, tick2] as edited.
+///   The chunks containing them are reported by the next
+///   takeChangedChunks() call.
+//---------------------------------------------------------
+
+void MidiRenderer::setScoreChanged(const Fraction& tick1, const Fraction& tick2)
+{
+    changedTicks.setOccupied(tick1.ticks(), tick2.ticks() + 1);
+    needUpdate = true;
+}
+
+//---------------------------------------------------------
+//   MidiRenderer::takeChangedChunks
+///   Returns the chunks which render differently since the
+///   previous call and forgets about them.
+//---------------------------------------------------------
+
+std::vector<MidiRenderer::Chunk> MidiRenderer::takeChangedChunks()
+{
+    updateState();
+
+    std::vector<Chunk> changed;
+    for (const Chunk& ch : chunks) {
+        if (changedUticks.isOccupied(ch.utick1(), ch.utick2())) {
+            changed.push_back(ch);
+        }
+    }
+    changedUticks.clear();
+    return changed;
+}
+
+//---------------------------------------------------------
+//   firstDifference
+///   Helper functions for updateStaffStates
+///   Returns the first tick at which two tick maps differ.
+//---------------------------------------------------------
+
+static int tickValue(int tick) { return tick; }
+static int tickValue(const Fraction& tick) { return tick.ticks(); }
+
+template<class Map>
+static int firstDifference(const Map& m1, const Map& m2)
+{
+    auto i1 = m1.cbegin();
+    auto i2 = m2.cbegin();
+    for (; i1 != m1.cend() && i2 != m2.cend(); ++i1, ++i2) {
+        if (i1.key() != i2.key() || !(i1.value() == i2.value())) {
+            return std::min(tickValue(i1.key()), tickValue(i2.key()));
+        }
+    }
+    if (i1 != m1.cend()) {
+        return tickValue(i1.key());
+    }
+    if (i2 != m2.cend()) {
+        return tickValue(i2.key());
+    }
+    return std::numeric_limits<int>::max();
+}
+
+//---------------------------------------------------------
+//   MidiRenderer::updateStaffStates
+///   Stores the per staff data which affects the playback
+///   beyond the place where it is set (dynamics, swing,
+///   capo, channel switches) and returns the first tick at
+///   which it differs from the previously stored one.
+//---------------------------------------------------------
+
+int MidiRenderer::updateStaffStates()
+{
+    score->updateChannel();
+    score->updateVelo();
+
+    const bool sameStaves = (int(staffStates.size()) == score->nstaves());
+    staffStates.resize(score->nstaves());
+
+    int changeTick = sameStaves ? std::numeric_limits<int>::max() : 0;
+    for (int staffIdx = 0; staffIdx < score->nstaves(); ++staffIdx) {
+        Staff* st = score->staff(staffIdx);
+        StaffPlaybackState& state = staffStates[staffIdx];
+
+        if (sameStaves) {
+            changeTick = std::min(changeTick, firstDifference(state.velocities, st->velocities()));
+            changeTick = std::min(changeTick, firstDifference(state.velocityMultiplications, st->velocityMultiplications()));
+            changeTick = std::min(changeTick, firstDifference(state.swing, st->swingList()));
+            changeTick = std::min(changeTick, firstDifference(state.capo, st->capoList()));
+            for (int voice = 0; voice < VOICES; ++voice) {
+                changeTick = std::min(changeTick, firstDifference(state.channels[voice], st->channelList(voice)));
+            }
+        }
+
+        state.velocities = st->velocities();
+        state.velocityMultiplications = st->velocityMultiplications();
+        state.swing = st->swingList();
+        state.capo = st->capoList();
+        for (int voice = 0; voice < VOICES; ++voice) {
+            state.channels[voice] = st->channelList(voice);
+        }
+    }
+    return changeTick;
+}
+
+//---------------------------------------------------------
+//   MidiRenderer::updateChangedChunks
+///   Compares the new chunks partition with the previous
+///   one. A chunk needs to be rendered again if it is new,
+///   contains edited ticks or follows a change of state
+///   carried over from the preceding chunks.
+//---------------------------------------------------------
+
+void MidiRenderer::updateChangedChunks()
+{
+    const int stateChangeTick = updateStaffStates();
+
+    std::vector<ChunkTicks> newPartition;
+    newPartition.reserve(chunks.size());
+    for (const Chunk& ch : chunks) {
+        newPartition.push_back({ ch.tickOffset(), ch.tick1(), ch.tick2() });
+    }
+
+    for (const ChunkTicks& ct : newPartition) {
+        bool changed = allChanged
+                       || ct.tick2 > stateChangeTick
+                       || changedTicks.isOccupied(ct.tick1, ct.tick2);
+        if (!changed) {
+            // partition is sorted by uticks
+            const auto it = std::lower_bound(partitionTicks.begin(), partitionTicks.end(), ct, [](const ChunkTicks& a, const ChunkTicks& b) {
+                return a.tick1 + a.tickOffset < b.tick1 + b.tickOffset;
+            });
+            changed = (it == partitionTicks.end() || !(*it == ct));
+        }
+        if (changed) {
+            changedUticks.setOccupied(ct.tick1 + ct.tickOffset, ct.tick2 + ct.tickOffset);
+        }
+    }
+
+    partitionTicks = std::move(newPartition);
+    changedTicks.clear();
+    allChanged = false;
+}
+
 //---------------------------------------------------------
 //   MidiRenderer::canBreakChunk
 ///   Helper function for updateChunksPartition
@@ -2734,4 +2878,18 @@ int RangeMap::occupiedRangeEnd(int tick) const
     }
     return tick;
 }
+
+//---------------------------------------------------------
+//   RangeMap::isOccupied
+///   Returns whether any part of [tick1, tick2) is occupied.
+//---------------------------------------------------------
+
+bool RangeMap::isOccupied(int tick1, int tick2) const
+{
+    const auto it = status.upper_bound(tick1);
+    if (it != status.begin() && std::prev(it)->second == Range::BEGIN) {
+        return true;
+    }
+    return it != status.end() && it->first < tick2;
+}
 }
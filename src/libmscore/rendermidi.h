@@ -20,8 +20,10 @@
 #ifndef __RENDERMIDI_H__
 #define __RENDERMIDI_H__
 
+#include "changeMap.h"
 #include "fraction.h"
 #include "measure.h"
+#include "staff.h"
 
 namespace Ms {
 class EventMap;
@@ -53,6 +55,7 @@ public:
     void setOccupied(std::pair<int, int> range) { setOccupied(range.first, range.second); }
 
     int occupiedRangeEnd(int tick) const;
+    bool isOccupied(int tick1, int tick2) const;
 
     void clear() { status.clear(); }
 };
@@ -66,6 +69,7 @@ class MidiRenderer
 {
     Score* score{ nullptr };
     bool needUpdate = true;
+    bool allChanged = true;
     int minChunkSize = 0;
 
 public:
@@ -98,6 +102,31 @@ public:
 private:
     std::vector<Chunk> chunks;
 
+    // The chunks are kept by ticks to compare them with the next
+    // partition, their measures may be gone by then.
+    struct ChunkTicks
+    {
+        int tickOffset;
+        int tick1;
+        int tick2;
+        bool operator==(const ChunkTicks& c) const { return tickOffset == c.tickOffset && tick1 == c.tick1 && tick2 == c.tick2; }
+    };
+    std::vector<ChunkTicks> partitionTicks;
+
+    // What a staff carries over from one chunk to the next ones
+    struct StaffPlaybackState
+    {
+        ChangeMap velocities;
+        ChangeMap velocityMultiplications;
+        QMap<int, SwingParameters> swing;
+        QMap<int, int> capo;
+        QMap<int, int> channels[VOICES];
+    };
+    std::vector<StaffPlaybackState> staffStates;
+
+    RangeMap changedTicks;        // score ticks changed since the last update
+    RangeMap changedUticks;       // chunks to be rendered again
+
     struct StaffContext
     {
         Staff* staff{ nullptr };
@@ -109,6 +138,8 @@ private:
     void updateChunksPartition();
     static bool canBreakChunk(const Measure* last);
     void updateState();
+    void updateChangedChunks();
+    int updateStaffStates();
 
     void renderStaffChunk(const Chunk&, EventMap* events, const StaffContext& sctx);
     void renderSpanners(const Chunk&, EventMap* events);
@@ -135,9 +166,12 @@ public:
     void renderScore(EventMap* events, const Context& ctx);
     void renderChunk(const Chunk&, EventMap* events, const Context& ctx);
 
-    void setScoreChanged() { needUpdate = true; }
+    void setScoreChanged() { needUpdate = true; allChanged = true; }
+    void setScoreChanged(const Fraction& tick1, const Fraction& tick2);
     void setMinChunkSize(int sizeMeasures) { minChunkSize = sizeMeasures; needUpdate = true; }
 
+    std::vector<Chunk> takeChangedChunks();
+
     Chunk getChunkAt(int utick);
 
     static const int ARTICULATION_CONV_FACTOR { 100000 };
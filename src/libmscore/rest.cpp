@@ -30,6 +30,8 @@
 #include "staff.h"
 #include "harmony.h"
 #include "segment.h"
+#include "page.h"
+#include "system.h"
 #include "stafftype.h"
 #include "icon.h"
 #include "image.h"
@@ -131,7 +133,11 @@ QRectF Rest::drag(EditData& ed)
     }
     setOffset(QPointF(s.x(), s.y()));
     layout();
-    score()->rebuildBspTree();
+    // only the system of the rest has changed
+    System* system = measure() ? measure()->system() : nullptr;
+    if (system && system->page()) {
+        system->page()->invalidateBspTree(system);
+    }
     return abbox() | r;
 }
 
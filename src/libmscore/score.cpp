@@ -18,6 +18,7 @@
 #include <assert.h>
 #include <cmath>
 #include <QBuffer>
+#include <QThreadPool>
 
 #include "score.h"
 #include "fermata.h"
@@ -63,6 +64,7 @@
 #include "tie.h"
 #include "tiemap.h"
 #include "layoutbreak.h"
+#include "layoutcache.h"
 #include "harmony.h"
 #include "mscore.h"
 #include "scoreOrder.h"
@@ -79,6 +81,7 @@
 namespace Ms {
 MasterScore* gscore;                 ///< system score, used for palettes etc.
 std::set<Score*> Score::validScores;
+thread_local Score::DestroyedElements* Score::destroyedElements = nullptr;
 
 bool noSeq           = false;
 bool noMidi          = false;
@@ -102,6 +105,7 @@ MeasureBaseList::MeasureBaseList()
 
 void MeasureBaseList::push_back(MeasureBase* e)
 {
+    ++_revision;
     ++_size;
     if (_last) {
         _last->setNext(e);
@@ -122,6 +126,7 @@ void MeasureBaseList::push_back(MeasureBase* e)
 
 void MeasureBaseList::push_front(MeasureBase* e)
 {
+    ++_revision;
     ++_size;
     if (_first) {
         _first->setPrev(e);
@@ -153,6 +158,7 @@ void MeasureBaseList::add(MeasureBase* e)
         return;
     }
     ++_size;
+    ++_revision;
     e->setPrev(el->prev());
     el->prev()->setNext(e);
     el->setPrev(e);
@@ -165,6 +171,7 @@ void MeasureBaseList::add(MeasureBase* e)
 
 void MeasureBaseList::remove(MeasureBase* el)
 {
+    ++_revision;
     --_size;
     if (el->prev()) {
         el->prev()->setNext(el->next());
@@ -184,6 +191,7 @@ void MeasureBaseList::remove(MeasureBase* el)
 
 void MeasureBaseList::insert(MeasureBase* fm, MeasureBase* lm)
 {
+    ++_revision;
     ++_size;
     for (MeasureBase* m = fm; m != lm; m = m->next()) {
         ++_size;
@@ -209,6 +217,7 @@ void MeasureBaseList::insert(MeasureBase* fm, MeasureBase* lm)
 
 void MeasureBaseList::remove(MeasureBase* fm, MeasureBase* lm)
 {
+    ++_revision;
     --_size;
     for (MeasureBase* m = fm; m != lm; m = m->next()) {
         --_size;
@@ -233,6 +242,7 @@ void MeasureBaseList::remove(MeasureBase* fm, MeasureBase* lm)
 
 void MeasureBaseList::change(MeasureBase* ob, MeasureBase* nb)
 {
+    ++_revision;
     nb->setPrev(ob->prev());
     nb->setNext(ob->next());
     if (ob->prev()) {
@@ -416,6 +426,9 @@ Score* Score::clone()
 //   Score::onElementDestruction
 //    Ensure correct state of the score after destruction
 //    of the element (e.g. remove invalid pointers etc.).
+//    Elements destroyed on layout worker threads are only
+//    collected; the layout thread processes them after the
+//    workers are joined.
 //---------------------------------------------------------
 
 void Score::onElementDestruction(Element* e)
@@ -425,6 +438,10 @@ void Score::onElementDestruction(Element* e)
         // No score or the score is already deleted
         return;
     }
+    if (destroyedElements) {
+        destroyedElements->push_back({ score, e });
+        return;
+    }
     score->selection().remove(e);
     score->cmdState().unsetElement(e);
     for (MuseScoreView* v : qAsConst(score->viewer)) {
@@ -432,6 +449,27 @@ void Score::onElementDestruction(Element* e)
     }
 }
 
+//---------------------------------------------------------
+//   Score::processDestroyedElements
+//    the elements are already deleted, only their
+//    pointers are removed
+//---------------------------------------------------------
+
+void Score::processDestroyedElements(const DestroyedElements& list)
+{
+    for (const auto& d : list) {
+        Score* score = d.first;
+        if (Score::validScores.find(score) == Score::validScores.end()) {
+            continue;
+        }
+        score->selection().remove(d.second);
+        score->cmdState().unsetElement(d.second);
+        for (MuseScoreView* v : qAsConst(score->viewer)) {
+            v->onElementDestruction(d.second);
+        }
+    }
+}
+
 //---------------------------------------------------------
 //   addMeasure
 //---------------------------------------------------------
@@ -5180,9 +5218,20 @@ MasterScore::~MasterScore()
     delete _repeatList2;
     delete _sigmap;
     delete _tempomap;
+    delete _layoutCache;
     qDeleteAll(_excerpts);
 }
 
+//---------------------------------------------------------
+//   setLayoutCache
+//---------------------------------------------------------
+
+void MasterScore::setLayoutCache(LayoutCache* c)
+{
+    delete _layoutCache;
+    _layoutCache = c;
+}
+
 //---------------------------------------------------------
 //   setMovements
 //---------------------------------------------------------
@@ -18,7 +18,11 @@
  Definition of Score class.
 */
 
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <set>
+#include <vector>
 #include <QFileInfo>
 #include <QQueue>
 #include <QSet>
@@ -34,6 +38,8 @@
 #include "property.h"
 #include "sym.h"
 
+class QThreadPool;
+
 namespace mu {
 namespace notation {
 class NotationNoteInput;
@@ -66,6 +72,7 @@ class Instrument;
 class KeyList;
 class KeySig;
 class KeySigEvent;
+class LayoutCache;
 class LinkedElements;
 class Lyrics;
 class MasterSynthesizer;
@@ -161,6 +168,7 @@ class MeasureBaseList
     int _size;
     MeasureBase* _first;
     MeasureBase* _last;
+    int _revision { 0 };          // incremented on every change of the list
 
     void push_back(MeasureBase* e);
     void push_front(MeasureBase* e);
@@ -169,7 +177,7 @@ public:
     MeasureBaseList();
     MeasureBase* first() const { return _first; }
     MeasureBase* last()  const { return _last; }
-    void clear() { _first = _last = 0; _size = 0; }
+    void clear() { _first = _last = 0; _size = 0; ++_revision; }
     void add(MeasureBase*);
     void remove(MeasureBase*);
     void insert(MeasureBase*, MeasureBase*);
@@ -177,6 +185,7 @@ public:
     void change(MeasureBase* o, MeasureBase* n);
     int size() const { return _size; }
     bool empty() const { return _size == 0; }
+    int revision() const { return _revision; }
     void fixupSystems();
 };
 
@@ -340,6 +349,20 @@ public:
     QList<ScoreElement*> _deleteList;
 };
 
+//---------------------------------------------------------
+//   LayoutStatistics
+//    what the last doLayoutRange() actually recomputed
+//---------------------------------------------------------
+
+struct LayoutStatistics {
+    int measuresLaidOut  { 0 };     ///< measures fully processed by getNextMeasure()
+    int measuresReused   { 0 };     ///< clean measures taken from the previous layout
+    int systemsCollected { 0 };     ///< systems built by collectSystem()
+    int systemsReused    { 0 };     ///< systems taken unchanged after the range was done
+    int systemsFromCache { 0 };     ///< systems laid out as recorded in the file's layout cache
+    int pagesCollected   { 0 };
+};
+
 //---------------------------------------------------------
 //   ScoreContentState
 //---------------------------------------------------------
@@ -437,8 +460,12 @@ public:
         FILE_IGNORE_ERROR
     };
 
+public:
+    using DestroyedElements = std::vector<std::pair<Score*, Element*> >;
+
 private:
     static std::set<Score*> validScores;
+    static thread_local DestroyedElements* destroyedElements;   // set on layout worker threads
     int _linkId { 0 };
     MasterScore* _masterScore { 0 };
     QList<MuseScoreView*> viewer;
@@ -459,8 +486,31 @@ private:
     int _pageNumberOffset { 0 };          ///< Offset for page numbers.
 
     UpdateState _updateState;
+    LayoutStatistics _layoutStatistics;
+    std::unique_ptr<QThreadPool> _layoutPool;   // workers for MScore::layoutThreads
 
     MeasureBaseList _measures;            // here are the notes
+
+    //---------------------------------------------------------
+    //   MeasureIndex
+    //    measures sorted by tick, rebuilt on demand by
+    //    tick2measure() after the measure list changed and
+    //    at the end of the layout, so that the layout and
+    //    render threads only read it
+    //---------------------------------------------------------
+
+    struct MeasureIndex {
+        std::vector<Measure*> measures;
+        std::vector<Fraction> ticks;
+        int revision { -1 };        // revision of _measures at build time
+        std::atomic<bool> valid { false };
+        bool sorted { true };
+        bool mmRests { false };     // Sid::createMultiMeasureRests at build time
+    };
+    mutable MeasureIndex _measureIndex;
+    mutable MeasureIndex _measureIndexMM;
+    mutable std::mutex _measureIndexMutex;
+    const MeasureIndex& measureIndex(bool mmRests) const;
     QList<Part*> _parts;
     QList<Staff*> _staves;
 
@@ -620,6 +670,8 @@ public:
     virtual bool readOnly() const;
 
     static void onElementDestruction(Element* se);
+    static void collectDestroyedElements(DestroyedElements* list) { destroyedElements = list; }
+    static void processDestroyedElements(const DestroyedElements& list);
 
     // Score Tree functions
     ScoreElement* treeParent() const override;
@@ -650,6 +702,11 @@ public:
     System* collectSystem(LayoutContext&);
     void layoutSystemElements(System* system, LayoutContext& lc);
     void getNextMeasure(LayoutContext&);        // get next measure for layout
+    void layoutMeasureNotes(LayoutContext&, Measure*);
+    void layoutStartRepeatBarLine(Measure*);
+    bool layoutInParallel(const Measure*, const LayoutContext&) const;
+    QThreadPool* layoutPool();
+    void layoutMeasuresParallel(LayoutContext&, Measure*);
 
     void resetAllPositions();
 
@@ -884,6 +941,8 @@ public:
     Fraction pos();
     Measure* tick2measure(const Fraction& tick) const;
     Measure* tick2measureMM(const Fraction& tick) const;
+    void invalidateMeasureIndex() { _measureIndex.valid = false; _measureIndexMM.valid = false; }
+    void updateMeasureIndex() const { measureIndex(false); measureIndex(true); }
     MeasureBase* tick2measureBase(const Fraction& tick) const;
     Segment* tick2segment(const Fraction& tick, bool first, SegmentType st, bool useMMrest = false) const;
     Segment* tick2segment(const Fraction& tick) const;
@@ -1113,6 +1172,8 @@ public:
 
     void doLayout();
     void doLayoutRange(const Fraction&, const Fraction&);
+    const LayoutStatistics& layoutStatistics() const { return _layoutStatistics; }
+    void setLayoutStatistics(const LayoutStatistics& s) { _layoutStatistics = s; }
     void layoutLinear(bool layoutAll, LayoutContext& lc);
 
     void layoutChords1(Segment* segment, int staffIdx);
@@ -1342,6 +1403,7 @@ class MasterScore : public Score
     MasterScore* _next      { 0 };
     MasterScore* _prev      { 0 };
     Movements* _movements   { 0 };
+    LayoutCache* _layoutCache { 0 };      // system layout read with the file, used by the first layout
 
     bool _readOnly          { false };
 
@@ -1426,6 +1488,8 @@ public:
     bool instrumentsChanged() const { return _cmdState._instrumentsChanged; }
 
     Revisions* revisions() { return _revisions; }
+    void setLayoutCache(LayoutCache* c);
+    LayoutCache* takeLayoutCache() { LayoutCache* c = _layoutCache; _layoutCache = 0; return c; }
 
     bool isSavable() const;
     void setTempomap(TempoMap* tm);
@@ -19,6 +19,7 @@
 #include "measure.h"
 #include "spanner.h"
 #include "musescoreCore.h"
+#include "taghash.h"
 
 namespace Ms {
 ElementStyle const ScoreElement::emptyStyle;
@@ -880,10 +881,10 @@ QString ScoreElement::userName() const
 
 ElementType ScoreElement::name2type(const QStringRef& s, bool silent)
 {
-    for (int i = 0; i < int(ElementType::MAXTYPE); ++i) {
-        if (s == elementNames[i].name) {
-            return ElementType(i);
-        }
+    static const TagIndex index(elementNames, int(ElementType::MAXTYPE), [](const ElementName& n) { return n.name; });
+    int idx = index.find(s);
+    if (idx >= 0) {
+        return ElementType(idx);
     }
     if (!silent) {
         qDebug("unknown type <%s>", qPrintable(s.toString()));
@@ -11,8 +11,10 @@
 //=============================================================================
 
 #include <cmath>
+#include <memory>
 #include <QDir>
 #include <QBuffer>
+#include <QCryptographicHash>
 
 #include "config.h"
 #include "score.h"
@@ -40,6 +42,7 @@
 #include "stafftype.h"
 #include "sym.h"
 #include "scoreOrder.h"
+#include "layoutcache.h"
 
 #include "preferences.h"
 
@@ -427,6 +430,7 @@ bool MasterScore::saveFile(bool generateBackup)
         return false;
     }
     temp.close();
+    imageStore.loadPending();         // the file they are read from is about to be replaced
 
     const QString name(info.filePath());
     const QString basename(info.fileName());
@@ -530,6 +534,7 @@ bool Score::saveCompressedFile(QFileInfo& info, bool onlySelection, bool createT
     if (readOnly() && info == *masterScore()->fileInfo()) {
         return false;
     }
+    imageStore.loadPending();         // the file may be the archive they are read from
     QFile fp(info.filePath());
     if (!fp.open(QIODevice::WriteOnly)) {
         MScore::lastError = tr("Open File\n%1\nfailed: %2").arg(info.filePath(), strerror(errno));
@@ -619,6 +624,19 @@ bool Score::saveCompressedFile(QIODevice* f, const QString& fn, bool onlySelecti
     dbuf.seek(0);
     uz.addFile(fn, dbuf.data());
 
+    // save the system layout to speed up the first layout after loading
+    if (MScore::saveLayoutCache && isMaster() && !onlySelection && layoutMode() == LayoutMode::PAGE
+        && !systems().isEmpty()) {
+        LayoutCache cache;
+        cache.setKey(LayoutCache::computeKey(QCryptographicHash::hash(dbuf.data(), QCryptographicHash::Sha1), this));
+        cache.collect(this);
+        QBuffer lbuf;
+        lbuf.open(QIODevice::WriteOnly);
+        XmlWriter lxml(this, &lbuf);
+        cache.write(lxml);
+        uz.addFile(LayoutCache::fileName, lbuf.data());
+    }
+
     QFileDevice* fd = dynamic_cast<QFileDevice*>(f);
     if (fd) { // if is file (may be buffer)
         fd->flush();     // flush to preserve score data in case of
@@ -674,6 +692,7 @@ bool Score::saveFile(QFileInfo& info)
     if (info.suffix().isEmpty()) {
         info.setFile(info.filePath() + ".mscx");
     }
+    imageStore.loadPending();         // the file may be the archive they are read from
     QFile fp(info.filePath());
     if (!fp.open(QIODevice::WriteOnly)) {
         MScore::lastError = tr("Open File\n%1\nfailed: %2").arg(info.filePath(), strerror(errno));
@@ -815,6 +834,51 @@ QString readRootFile(MQZipReader* uz, QList<QString>& images)
     return rootfile;
 }
 
+//---------------------------------------------------------
+//   DigestDevice
+//    read only device passing the data of another device
+//    through a SHA-1 hash, so the .mscx is hashed while it
+//    is parsed
+//---------------------------------------------------------
+
+class DigestDevice : public QIODevice
+{
+    QIODevice* _source;
+    QCryptographicHash _hash { QCryptographicHash::Sha1 };
+
+public:
+    DigestDevice(QIODevice* source)
+        : _source(source)
+    {
+        open(QIODevice::ReadOnly | QIODevice::Unbuffered);
+    }
+
+    bool isSequential() const override { return true; }
+    bool atEnd() const override { return _source->atEnd(); }
+    qint64 bytesAvailable() const override { return _source->bytesAvailable(); }
+
+    // hashes what the reader left unread
+    QByteArray result()
+    {
+        char buffer[16384];
+        while (read(buffer, sizeof(buffer)) > 0) {
+        }
+        return _hash.result();
+    }
+
+protected:
+    qint64 readData(char* data, qint64 maxSize) override
+    {
+        qint64 n = _source->read(data, maxSize);
+        if (n > 0) {
+            _hash.addData(data, int(n));
+        }
+        return n;
+    }
+
+    qint64 writeData(const char*, qint64) override { return -1; }
+};
+
 //---------------------------------------------------------
 //   loadCompressedMsc
 //    return false on error
@@ -831,30 +895,65 @@ Score::FileError MasterScore::loadCompressedMsc(QIODevice* io, bool ignoreVersio
     }
 
     //
-    // load images
+    // add images, they are inflated on first use if
+    // the archive can be opened again later
     //
     if (!MScore::noImages) {
+        QFileDevice* fd = qobject_cast<QFileDevice*>(io);
+        QString archive = fd ? QFileInfo(fd->fileName()).absoluteFilePath() : QString();
         foreach (const QString& s, sl) {
-            QByteArray dbuf = uz.fileData(s);
-            imageStore.add(s, dbuf);
+            if (archive.isEmpty() || !imageStore.addLazy(s, archive)) {
+                QByteArray dbuf = uz.fileData(s);
+                imageStore.add(s, dbuf);
+            }
         }
     }
 
-    QByteArray dbuf = uz.fileData(rootfile);
-    if (dbuf.isEmpty()) {
+    // parse the score while inflating it
+    std::unique_ptr<QIODevice> dev(uz.fileDevice(rootfile));
+    if (!dev) {
         QVector<MQZipReader::FileInfo> fil = uz.fileInfoList();
         foreach (const MQZipReader::FileInfo& fi, fil) {
             if (fi.filePath.endsWith(".mscx")) {
-                dbuf = uz.fileData(fi.filePath);
+                rootfile = fi.filePath;
+                dev.reset(uz.fileDevice(rootfile));
                 break;
             }
         }
     }
+    if (!dev) {
+        return FileError::FILE_NO_ROOTFILE;
+    }
 
-    XmlReader e(dbuf);
+    // the layout cache is keyed by the digest of the .mscx
+    std::unique_ptr<DigestDevice> digest;
+    if (MScore::saveLayoutCache) {
+        digest.reset(new DigestDevice(dev.get()));
+    }
+
+    XmlReader e(digest ? static_cast<QIODevice*>(digest.get()) : dev.get());
     e.setDocName(masterScore()->fileInfo()->completeBaseName());
 
     FileError retval = read1(e, ignoreVersionError);
+    QByteArray mscxDigest = digest ? digest->result() : QByteArray();
+    digest.reset();
+    dev.reset();
+
+    //
+    //  read layout cache
+    //
+    if (retval == FileError::FILE_NO_ERROR && MScore::saveLayoutCache) {
+        QByteArray lbuf = uz.fileData(LayoutCache::fileName);
+        if (!lbuf.isEmpty()) {
+            XmlReader le(lbuf);
+            LayoutCache* cache = new LayoutCache;
+            if (cache->read(le) && cache->key() == LayoutCache::computeKey(mscxDigest, this)) {
+                setLayoutCache(cache);
+            } else {
+                delete cache;
+            }
+        }
+    }
 
     //
     //  read audio
@@ -887,14 +986,15 @@ int MasterScore::styleDefaultByMscVersion(const int mscVer) const
     return MSCVERSION;
 }
 
-int MasterScore::readStyleDefaultsVersion()
-{
-    if (styleB(Sid::usePre_3_6_defaults)) {
-        return style().defaultStyleVersion();
-    }
+//---------------------------------------------------------
+//   scanDefaultsVersion
+//    return -1 if the file does not contain a defaultsVersion
+//---------------------------------------------------------
 
-    XmlReader e(readToBuffer());
-    e.setDocName(masterScore()->fileInfo()->completeBaseName());
+static int scanDefaultsVersion(QIODevice* dev, const QString& docName)
+{
+    XmlReader e(dev);
+    e.setDocName(docName);
 
     while (!e.atEnd()) {
         e.readNext();
@@ -902,6 +1002,38 @@ int MasterScore::readStyleDefaultsVersion()
             return e.readInt();
         }
     }
+    return -1;
+}
+
+//---------------------------------------------------------
+//   readStyleDefaultsVersion
+//---------------------------------------------------------
+
+int MasterScore::readStyleDefaultsVersion()
+{
+    if (styleB(Sid::usePre_3_6_defaults)) {
+        return style().defaultStyleVersion();
+    }
+
+    // scan the file again, streaming it instead of reading it into a buffer
+    QFile f(info.filePath());
+    if (f.open(QIODevice::ReadOnly)) {
+        int version = -1;
+        QString cs = info.suffix().toLower();
+        if (cs == "mscz") {
+            MQZipReader uz(&f);
+            QList<QString> images;
+            std::unique_ptr<QIODevice> dev(uz.fileDevice(readRootFile(&uz, images)));
+            if (dev) {
+                version = scanDefaultsVersion(dev.get(), info.completeBaseName());
+            }
+        } else if (cs == "msc" || cs == "mscx") {
+            version = scanDefaultsVersion(&f, info.completeBaseName());
+        }
+        if (version >= 0) {
+            return version;
+        }
+    }
 
     return styleDefaultByMscVersion(mscVersion());
 }
@@ -1077,11 +1209,14 @@ QByteArray MasterScore::readCompressedToBuffer()
     QString rootfile = readRootFile(&uz, images);
 
     //
-    // load images
+    // add images, inflated on first use
     //
+    QString archive = info.absoluteFilePath();
     foreach (const QString& s, images) {
-        QByteArray dbuf = uz.fileData(s);
-        imageStore.add(s, dbuf);
+        if (!imageStore.addLazy(s, archive)) {
+            QByteArray dbuf = uz.fileData(s);
+            imageStore.add(s, dbuf);
+        }
     }
 
     if (rootfile.isEmpty()) {
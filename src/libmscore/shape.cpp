@@ -10,10 +10,127 @@
 //  the file LICENCE.GPL
 //=============================================================================
 
+#include <algorithm>
+#include <limits>
+
 #include "shape.h"
 #include "segment.h"
 
+#if (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)) && !defined(QT_COORD_TYPE)
+#define SHAPE_SSE2
+#include <emmintrin.h>
+#endif
+
 namespace Ms {
+//---------------------------------------------------------
+//   reserve
+//---------------------------------------------------------
+
+void Shape::reserve(size_t n)
+{
+    if (n <= _capacity) {
+        return;
+    }
+    std::vector<qreal> data(4 * n);
+    for (size_t k = 0; k < 4; ++k) {
+        std::copy_n(_data.begin() + k * _capacity, _size, data.begin() + k * n);
+    }
+    _data.swap(data);
+    _capacity = n;
+#ifndef NDEBUG
+    _text.reserve(n);
+#endif
+}
+
+//---------------------------------------------------------
+//   append
+//---------------------------------------------------------
+
+void Shape::append(const QRectF& r)
+{
+    if (_size == _capacity) {
+        reserve(_capacity ? 2 * _capacity : 4);
+    }
+    setRect(_size++, r);
+}
+
+//---------------------------------------------------------
+//   setRect
+//---------------------------------------------------------
+
+void Shape::setRect(size_t i, const QRectF& r)
+{
+    xs()[i] = r.x();
+    ys()[i] = r.y();
+    ws()[i] = r.width();
+    hs()[i] = r.height();
+}
+
+//---------------------------------------------------------
+//   erase
+//---------------------------------------------------------
+
+void Shape::erase(size_t i)
+{
+    for (size_t k = 0; k < 4; ++k) {
+        qreal* d = _data.data() + k * _capacity;
+        std::copy(d + i + 1, d + _size, d + i);
+    }
+#ifndef NDEBUG
+    _text.erase(_text.begin() + i);
+#endif
+    --_size;
+}
+
+//---------------------------------------------------------
+//   clear
+//---------------------------------------------------------
+
+void Shape::clear()
+{
+    _size = 0;
+#ifndef NDEBUG
+    _text.clear();
+#endif
+}
+
+//---------------------------------------------------------
+//   at
+//---------------------------------------------------------
+
+ShapeElement Shape::at(size_t i) const
+{
+#ifndef NDEBUG
+    return ShapeElement(rect(i), _text[i]);
+#else
+    return ShapeElement(rect(i));
+#endif
+}
+
+//---------------------------------------------------------
+//   add
+//---------------------------------------------------------
+
+void Shape::add(const Shape& s)
+{
+    reserve(_size + s._size);
+    for (size_t i = 0; i < s._size; ++i) {
+#ifndef NDEBUG
+        add(s.rect(i), s._text[i]);
+#else
+        add(s.rect(i));
+#endif
+    }
+}
+
+#ifdef NDEBUG
+void Shape::add(const QRectF& r)
+{
+    append(r);
+}
+
+#endif
+
 //---------------------------------------------------------
 //   addHorizontalSpacing
 //    Currently implemented by adding rectangles of zero
@@ -37,24 +154,31 @@ void Shape::addHorizontalSpacing(HorizontalSpacingType type, qreal leftEdge, qre
 
 void Shape::translate(const QPointF& pt)
 {
-    for (QRectF& r : *this) {
-        r.translate(pt);
+    qreal* x = xs();
+    qreal* y = ys();
+    for (size_t i = 0; i < _size; ++i) {
+        x[i] += pt.x();
+        y[i] += pt.y();
     }
 }
 
 void Shape::translateX(qreal xo)
 {
-    for (QRectF& r : *this) {
+    for (size_t i = 0; i < _size; ++i) {
+        QRectF r = rect(i);
         r.setLeft(r.left() + xo);
         r.setRight(r.right() + xo);
+        setRect(i, r);
     }
 }
 
 void Shape::translateY(qreal yo)
 {
-    for (QRectF& r : *this) {
+    for (size_t i = 0; i < _size; ++i) {
+        QRectF r = rect(i);
         r.setTop(r.top() + yo);
         r.setBottom(r.bottom() + yo);
+        setRect(i, r);
     }
 }
 
@@ -64,17 +188,8 @@ void Shape::translateY(qreal yo)
 
 Shape Shape::translated(const QPointF& pt) const
 {
-    Shape s;
-    for (const ShapeElement& r : *this)
-#ifndef NDEBUG
-    {
-        s.add(r.translated(pt), r.text);
-    }
-#else
-    {
-        s.add(r.translated(pt));
-    }
-#endif
+    Shape s(*this);
+    s.translate(pt);
     return s;
 }
 
@@ -83,21 +198,80 @@ Shape Shape::translated(const QPointF& pt) const
 //    a is located right of this shape.
 //    Calculates the minimum horizontal distance between the two shapes
 //    so they don’t touch.
+//    Two rectangles are considered if they overlap vertically, if both
+//    have zero height at the same y, or if one of them has zero width.
 //-------------------------------------------------------------------
 
 qreal Shape::minHorizontalDistance(const Shape& a) const
 {
     qreal dist = -1000000.0;        // min real
-    for (const QRectF& r2 : a) {
-        qreal by1 = r2.top();
-        qreal by2 = r2.bottom();
-        for (const QRectF& r1 : *this) {
-            qreal ay1 = r1.top();
-            qreal ay2 = r1.bottom();
+    if (_size == 0 || a._size == 0) {
+        return dist;
+    }
+
+    const qreal* x1 = xs();
+    const qreal* y1 = ys();
+    const qreal* w1 = ws();
+    const qreal* h1 = hs();
+
+    // no rectangle of a can give more than rightmost - a.left
+    qreal right1 = dist;
+    for (size_t i = 0; i < _size; ++i) {
+        right1 = qMax(right1, x1[i] + w1[i]);
+    }
+
+    for (size_t j = 0; j < a._size; ++j) {
+        const qreal bx1 = a.xs()[j];
+        const qreal by1 = a.ys()[j];
+        const qreal bw  = a.ws()[j];
+        const qreal bh  = a.hs()[j];
+        const qreal by2 = by1 + bh;
+        if (!(right1 - bx1 > dist)) {
+            continue;
+        }
+
+        size_t i = 0;
+#ifdef SHAPE_SSE2
+        if (bw != 0.0) {
+            const __m128d zero   = _mm_setzero_pd();
+            const __m128d minV   = _mm_set1_pd(-std::numeric_limits<qreal>::infinity());
+            const __m128d bx1v   = _mm_set1_pd(bx1);
+            const __m128d by1v   = _mm_set1_pd(by1);
+            const __m128d by2v   = _mm_set1_pd(by2);
+            const __m128d allSet = _mm_cmpeq_pd(zero, zero);
+            const __m128d bValid = by1 != by2 ? allSet : zero;
+            const __m128d bFlat  = bh == 0.0 ? allSet : zero;
+            __m128d distv = _mm_set1_pd(dist);
+            for (; i + 2 <= _size; i += 2) {
+                __m128d ay1 = _mm_loadu_pd(y1 + i);
+                __m128d ah  = _mm_loadu_pd(h1 + i);
+                __m128d aw  = _mm_loadu_pd(w1 + i);
+                __m128d ay2 = _mm_add_pd(ay1, ah);
+                // Ms::intersects(ay1, ay2, by1, by2)
+                __m128d inter = _mm_and_pd(_mm_cmpgt_pd(ay2, by1v), _mm_cmplt_pd(ay1, by2v));
+                inter = _mm_andnot_pd(_mm_cmpeq_pd(ay1, ay2), _mm_and_pd(inter, bValid));
+                // both zero height at the same y
+                __m128d flat = _mm_and_pd(bFlat, _mm_and_pd(_mm_cmpeq_pd(ah, zero), _mm_cmpeq_pd(ay1, by1v)));
+                // zero width
+                __m128d thin = _mm_cmpeq_pd(aw, zero);
+                __m128d mask = _mm_or_pd(inter, _mm_or_pd(flat, thin));
+
+                __m128d d = _mm_sub_pd(_mm_add_pd(_mm_loadu_pd(x1 + i), aw), bx1v);
+                d = _mm_or_pd(_mm_and_pd(mask, d), _mm_andnot_pd(mask, minV));
+                distv = _mm_max_pd(d, distv);       // keeps distv if d is NaN, like qMax()
+            }
+            double lanes[2];
+            _mm_storeu_pd(lanes, distv);
+            dist = qMax(dist, qMax(lanes[0], lanes[1]));
+        }
+#endif
+        for (; i < _size; ++i) {
+            const qreal ay1 = y1[i];
+            const qreal ay2 = ay1 + h1[i];
             if (Ms::intersects(ay1, ay2, by1, by2)
-                || ((r1.height() == 0.0) && (r2.height() == 0.0) && (ay1 == by1))
-                || ((r1.width() == 0.0) || (r2.width() == 0.0))) {
-                dist = qMax(dist, r1.right() - r2.left());
+                || ((h1[i] == 0.0) && (bh == 0.0) && (ay1 == by1))
+                || ((w1[i] == 0.0) || (bw == 0.0))) {
+                dist = qMax(dist, x1[i] + w1[i] - bx1);
             }
         }
     }
@@ -236,8 +410,8 @@ qreal Shape::bottomDistance(const QPointF& p) const
 
 void Shape::remove(const QRectF& r)
 {
-    for (auto i = begin(); i != end(); ++i) {
-        if (*i == r) {
+    for (size_t i = 0; i < _size; ++i) {
+        if (rect(i) == r) {
             erase(i);
             return;
         }
@@ -314,8 +488,8 @@ void Shape::paint(QPainter& p) const
 void Shape::dump(const char* p) const
 {
     qDebug("Shape dump: %p %s size %zu", this, p, size());
-    for (const ShapeElement& r : *this) {
-        r.dump();
+    for (size_t i = 0; i < _size; ++i) {
+        at(i).dump();
     }
 }
 
@@ -330,7 +504,8 @@ void ShapeElement::dump() const
 
 void Shape::add(const QRectF& r, const char* t)
 {
-    push_back(ShapeElement(r, t));
+    append(r);
+    _text.push_back(t);
 }
 
 #endif
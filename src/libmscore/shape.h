@@ -13,6 +13,7 @@
 #ifndef __SHAPE_H__
 #define __SHAPE_H__
 
+#include <vector>
 #include <QPainter>
 
 namespace Ms {
@@ -40,11 +41,14 @@ struct ShapeElement : public QRectF {
 
 //---------------------------------------------------------
 //   Shape
+//    The rectangles are stored as a structure of arrays
+//    (all x, then all y, all widths, all heights) so the
+//    distance functions can process several rectangles
+//    at once. Iterating yields ShapeElement values.
 //---------------------------------------------------------
 
-class Shape : public std::vector<ShapeElement>
+class Shape
 {
-// class Shape : std::vector<ShapeElement> {
 public:
     enum HorizontalSpacingType {
         SPACING_GENERAL = 0,
@@ -52,17 +56,31 @@ public:
         SPACING_HARMONY,
     };
 
+    class const_iterator
+    {
+        const Shape* _shape;
+        size_t _idx;
+
+    public:
+        const_iterator(const Shape* s, size_t idx)
+            : _shape(s), _idx(idx) {}
+        ShapeElement operator*() const { return _shape->at(_idx); }
+        const_iterator& operator++() { ++_idx; return *this; }
+        bool operator==(const const_iterator& i) const { return _idx == i._idx; }
+        bool operator!=(const const_iterator& i) const { return _idx != i._idx; }
+    };
+
     Shape() {}
 #ifndef NDEBUG
     Shape(const QRectF& r, const char* s = 0) { add(r, s); }
 #else
     Shape(const QRectF& r) { add(r); }
 #endif
-    void add(const Shape& s) { insert(end(), s.begin(), s.end()); }
+    void add(const Shape& s);
 #ifndef NDEBUG
     void add(const QRectF& r, const char* t = 0);
 #else
-    void add(const QRectF& r) { push_back(r); }
+    void add(const QRectF& r);
 #endif
     void remove(const QRectF&);
     void remove(const Shape&);
@@ -83,9 +101,14 @@ public:
     qreal top() const;
     qreal bottom() const;
 
-    size_t size() const { return std::vector<ShapeElement>::size(); }
-    bool empty() const { return std::vector<ShapeElement>::empty(); }
-    void clear() { std::vector<ShapeElement>::clear(); }
+    size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+    void clear();
+    void reserve(size_t n);
+
+    ShapeElement at(size_t i) const;
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, _size); }
 
     bool contains(const QPointF&) const;
     bool intersects(const QRectF& rr) const;
@@ -95,6 +118,29 @@ public:
 #ifndef NDEBUG
     void dump(const char*) const;
 #endif
+
+private:
+    // _data holds four arrays of _capacity values each
+    std::vector<qreal> _data;
+    size_t _size     { 0 };
+    size_t _capacity { 0 };
+#ifndef NDEBUG
+    std::vector<const char*> _text;
+#endif
+
+    qreal* xs() { return _data.data(); }
+    qreal* ys() { return _data.data() + _capacity; }
+    qreal* ws() { return _data.data() + 2 * _capacity; }
+    qreal* hs() { return _data.data() + 3 * _capacity; }
+    const qreal* xs() const { return _data.data(); }
+    const qreal* ys() const { return _data.data() + _capacity; }
+    const qreal* ws() const { return _data.data() + 2 * _capacity; }
+    const qreal* hs() const { return _data.data() + 3 * _capacity; }
+
+    QRectF rect(size_t i) const { return QRectF(xs()[i], ys()[i], ws()[i], hs()[i]); }
+    void setRect(size_t i, const QRectF& r);
+    void append(const QRectF& r);
+    void erase(size_t i);
 };
 
 //---------------------------------------------------------
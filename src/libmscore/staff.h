@@ -52,6 +52,8 @@ enum class Key;
 struct SwingParameters {
     int swingUnit;
     int swingRatio;
+
+    bool operator==(const SwingParameters& p) const { return swingUnit == p.swingUnit && swingRatio == p.swingRatio; }
 };
 
 //---------------------------------------------------------
@@ -205,6 +207,7 @@ public:
     QList<Note*> getNotes() const;
     void addChord(QList<Note*>& list, Chord* chord, int voice) const;
 
+    const QMap<int, int>& channelList(int voice) const { return _channelList[voice]; }
     void clearChannelList(int voice) { _channelList[voice].clear(); }
     void insertIntoChannelList(int voice, const Fraction& tick, int channelId)
     {
@@ -212,10 +215,12 @@ public:
     }
 
     SwingParameters swing(const Fraction&)  const;
+    const QMap<int, SwingParameters>& swingList() const { return _swingList; }
     void clearSwingList() { _swingList.clear(); }
     void insertIntoSwingList(const Fraction& tick, SwingParameters sp) { _swingList.insert(tick.ticks(), sp); }
 
     int capo(const Fraction&) const;
+    const QMap<int, int>& capoList() const { return _capoList; }
     void clearCapoList() { _capoList.clear(); }
     void insertIntoCapoList(const Fraction& tick, int fretId) { _capoList.insert(tick.ticks(), fretId); }
 
@@ -16,20 +16,30 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
-#include <QCache>
+#include <QCryptographicHash>
+#include <QDir>
+#include <QMutex>
+#include <QResource>
+#include <QSaveFile>
+#include <QSysInfo>
 
 #include "style.h"
 #include "sym.h"
+#include "glyphcache.h"
 #include "utils.h"
 #include "score.h"
 #include "xml.h"
 #include "mscore.h"
+#include "config.h"
 
 #include FT_GLYPH_H
 #include FT_IMAGE_H
 #include FT_BBOX_H
 
 static FT_Library ftlib;
+static QMutex ftMutex;         // FreeType faces are not thread safe
+static QMutex pdfFontMutex;
+static QMutex loadMutex;       // fonts may be first used by page render threads
 
 namespace Ms {
 //---------------------------------------------------------
@@ -48,7 +58,39 @@ QVector<ScoreFont> ScoreFont::_scoreFonts {
     ScoreFont("Petaluma",   "Petaluma",    ":/fonts/petaluma/",  "Petaluma.otf"),
 };
 
-std::array<uint, size_t(SymId::lastSym) + 1> ScoreFont::_mainSymCodeTable { { 0 } };
+//---------------------------------------------------------
+//   font metrics cache
+//    binary image of the metrics a font computes in load(),
+//    the file is mapped and copied into the symbols
+//---------------------------------------------------------
+
+static const quint32 METRICS_CACHE_VERSION = 1;
+static const int SMUFL_ANCHORS = int(SmuflAnchorId::cutOutSW) + 1;
+
+struct MetricsCacheHeader {
+    char magic[4];
+    quint32 version;
+    char key[20];
+    quint32 symbols;
+    quint32 engravingDefaults;
+    double textEnclosureThickness;
+};
+
+struct MetricsCacheSym {
+    qint32 code;
+    quint32 index;
+    double bbox[4];
+    double advance;
+    quint32 anchors;                    // bit mask of the anchors set
+    quint32 reserved;
+    double anchor[SMUFL_ANCHORS][2];
+};
+
+struct MetricsCacheDefault {
+    qint32 sid;
+    quint32 reserved;
+    double value;
+};
 
 //---------------------------------------------------------
 //   table of symbol names
@@ -6421,93 +6463,111 @@ void ScoreFont::draw(SymId id, QPainter* painter, const QSizeF& mag, const QPoin
         }
         return;
     }
-    int rv = FT_Load_Glyph(face, sym(id).index(), FT_LOAD_DEFAULT);
-    if (rv) {
-        qDebug("load glyph id %d, failed: 0x%x", int(id), rv);
-        return;
-    }
 
     if (MScore::pdfPrinting) {
-        if (font == 0) {
-            QString s(_fontPath + _filename);
-            if (-1 == QFontDatabase::addApplicationFont(s)) {
-                qDebug("Mscore: fatal error: cannot load internal font <%s>", qPrintable(s));
-                return;
+        QFont f;
+        {
+            // pages may be printed from several threads at once
+            QMutexLocker locker(&pdfFontMutex);
+            if (font == 0) {
+                QString s(_fontPath + _filename);
+                if (-1 == QFontDatabase::addApplicationFont(s)) {
+                    qDebug("Mscore: fatal error: cannot load internal font <%s>", qPrintable(s));
+                    return;
+                }
+                font = new QFont;
+                font->setWeight(QFont::Normal);
+                font->setItalic(false);
+                font->setFamily(_family);
+                font->setStyleStrategy(QFont::NoFontMerging);
+                font->setHintingPreference(QFont::PreferVerticalHinting);
             }
-            font = new QFont;
-            font->setWeight(QFont::Normal);
-            font->setItalic(false);
-            font->setFamily(_family);
-            font->setStyleStrategy(QFont::NoFontMerging);
-            font->setHintingPreference(QFont::PreferVerticalHinting);
+            f = *font;
         }
         qreal size = 20.0 * MScore::pixelRatio;
-        font->setPointSize(size);
+        f.setPointSize(size);
         QSizeF imag = QSizeF(1.0 / mag.width(), 1.0 / mag.height());
         painter->scale(mag.width(), mag.height());
-        painter->setFont(*font);
+        painter->setFont(f);
         painter->drawText(QPointF(pos.x() * imag.width(), pos.y() * imag.height()), toString(id));
         painter->scale(imag.width(), imag.height());
         return;
     }
 
-    QColor color(painter->pen().color());
-
     int pr           = painter->device()->devicePixelRatio();
     qreal pixelRatio = qreal(pr > 0 ? pr : 1);
     worldScale      *= pixelRatio;
 //      if (worldScale < 1.0)
 //            worldScale = 1.0;
-    int scale16X      = lrint(worldScale * 6553.6 * mag.width() * DPI_F);
-    int scale16Y      = lrint(worldScale * 6553.6 * mag.height() * DPI_F);
 
+    const GlyphPixmap* pm = glyph(id, mag, worldScale, painter->pen().color());
+    if (pm && !pm->image.isNull()) {
+        painter->drawImage(pos + pm->offset, pm->image);
+    }
+}
+
+//---------------------------------------------------------
+//   glyph
+//    the rendered symbol from the glyph cache, rendering
+//    and caching it if it's not there yet
+//---------------------------------------------------------
+
+const GlyphPixmap* ScoreFont::glyph(SymId id, const QSizeF& mag, qreal worldScale, const QColor& color) const
+{
     GlyphKey gk(face, id, mag.width(), mag.height(), worldScale, color);
-    GlyphPixmap* pm = cache->object(gk);
-
-    if (!pm) {
-        FT_Matrix matrix {
-            scale16X, 0,
-            0,       scale16Y
-        };
-
-        FT_Glyph glyph;
-        FT_Get_Glyph(face->glyph, &glyph);
-        FT_Glyph_Transform(glyph, &matrix, 0);
-        rv = FT_Glyph_To_Bitmap(&glyph, FT_RENDER_MODE_NORMAL, 0, 1);
-        if (rv) {
-            qDebug("glyph to bitmap failed: 0x%x", rv);
-            return;
-        }
+    if (const GlyphPixmap* pm = GlyphCache::find(gk)) {
+        return pm;
+    }
 
-        FT_BitmapGlyph gb = (FT_BitmapGlyph)glyph;
-        FT_Bitmap* bm     = &gb->bitmap;
+    int scale16X      = lrint(worldScale * 6553.6 * mag.width() * DPI_F);
+    int scale16Y      = lrint(worldScale * 6553.6 * mag.height() * DPI_F);
+    FT_Matrix matrix {
+        scale16X, 0,
+        0,       scale16Y
+    };
 
-        if (bm->width == 0 || bm->rows == 0) {
-            qDebug("zero glyph, id %d", int(id));
-            return;
-        }
-        QImage img(QSize(bm->width, bm->rows), QImage::Format_ARGB32);
-        img.fill(Qt::transparent);
+    QMutexLocker locker(&ftMutex);
+    int rv = FT_Load_Glyph(face, sym(id).index(), FT_LOAD_DEFAULT);
+    if (rv) {
+        qDebug("load glyph id %d, failed: 0x%x", int(id), rv);
+        return nullptr;
+    }
+    FT_Glyph ftGlyph;
+    FT_Get_Glyph(face->glyph, &ftGlyph);
+    FT_Glyph_Transform(ftGlyph, &matrix, 0);
+    rv = FT_Glyph_To_Bitmap(&ftGlyph, FT_RENDER_MODE_NORMAL, 0, 1);
+    if (rv) {
+        qDebug("glyph to bitmap failed: 0x%x", rv);
+        FT_Done_Glyph(ftGlyph);
+        return nullptr;
+    }
 
+    FT_BitmapGlyph gb = (FT_BitmapGlyph)ftGlyph;
+    FT_Bitmap* bm     = &gb->bitmap;
+
+    GlyphPixmap pm;
+    if (bm->width == 0 || bm->rows == 0) {
+        qDebug("zero glyph, id %d", int(id));     // cached as a null image, so this is reported once
+    } else {
+        QImage img(QSize(bm->width, bm->rows), QImage::Format_ARGB32_Premultiplied);
+        QColor c(color);
         for (unsigned y = 0; y < bm->rows; ++y) {
-            unsigned* dst      = (unsigned*)img.scanLine(y);
+            QRgb* dst          = reinterpret_cast<QRgb*>(img.scanLine(y));
             unsigned char* src = (unsigned char*)(bm->buffer) + bm->pitch * y;
             for (unsigned x = 0; x < bm->width; ++x) {
                 unsigned val = *src++;
-                color.setAlpha(std::min(int(val), painter->pen().color().alpha()));
-                *dst++ = color.rgba();
+                c.setAlpha(std::min(int(val), color.alpha()));
+                *dst++ = qPremultiply(c.rgba());
             }
         }
-        pm = new GlyphPixmap;
-        pm->pm = QPixmap::fromImage(img, Qt::NoFormatConversion);
-        pm->pm.setDevicePixelRatio(worldScale);
-        pm->offset = QPointF(qreal(gb->left), -qreal(gb->top)) / worldScale;
-        if (!cache->insert(gk, pm)) {
-            qDebug("cannot cache glyph");
-        }
-        FT_Done_Glyph(glyph);
+        img.setDevicePixelRatio(worldScale);
+        pm.image  = img;
+        pm.offset = QPointF(qreal(gb->left), -qreal(gb->top)) / worldScale;
     }
-    painter->drawPixmap(pos + pm->offset, pm->pm);
+    FT_Done_Glyph(ftGlyph);
+    locker.unlock();
+
+    return GlyphCache::insert(gk, pm);
 }
 
 void ScoreFont::draw(SymId id, QPainter* painter, qreal mag, const QPointF& pos, int n) const
@@ -6565,24 +6625,12 @@ const char* Sym::id2name(SymId id)
 
 void initScoreFonts()
 {
-    QJsonObject glyphNamesJson(ScoreFont::initGlyphNamesJson());
-    if (glyphNamesJson.empty()) {
-        qFatal("initGlyphNamesJson failed");
-    }
     int error = FT_Init_FreeType(&ftlib);
     if (!ftlib || error) {
         qFatal("init freetype library failed");
     }
     for (size_t i = 0; i < Sym::symNames.size(); ++i) {
-        const char* name = Sym::symNames[i];
-        Sym::lnhash.insert(name, SymId(i));
-        bool ok;
-        uint code = glyphNamesJson.value(name).toObject().value("codepoint").toString().midRef(2).toUInt(&ok, 16);
-        if (ok) {
-            ScoreFont::_mainSymCodeTable[i] = code;
-        } else if (MScore::debugMode) {
-            qDebug("codepoint not recognized for glyph %s", qPrintable(name));
-        }
+        Sym::lnhash.insert(Sym::symNames[i], SymId(i));
     }
     for (oldName i : qAsConst(oldNames)) {
         Sym::lonhash.insert(i.name, SymId(i.symId));
@@ -6618,7 +6666,7 @@ QString ScoreFont::toString(SymId id) const
         code = s.code();
     } else {
         // fallback: search in the common SMuFL table
-        code = _mainSymCodeTable[size_t(id)];
+        code = mainSymCodeTable()[size_t(id)];
     }
     return codeToString(code);
 }
@@ -6657,24 +6705,155 @@ void ScoreFont::computeMetrics(Sym* sym, int code)
 void ScoreFont::load()
 {
     QString facePath = _fontPath + _filename;
-    QFile f(facePath);
-    if (!f.open(QIODevice::ReadOnly)) {
-        qDebug("ScoreFont::load(): open failed <%s>", qPrintable(facePath));
-        return;
+    QResource resource(facePath);
+    if (resource.isValid() && resource.compressionAlgorithm() == QResource::NoCompression) {
+        // the font is part of the program image, use it in place
+        fontImage = QByteArray::fromRawData(reinterpret_cast<const char*>(resource.data()), int(resource.size()));
+    } else {
+        QFile f(facePath);
+        if (!f.open(QIODevice::ReadOnly)) {
+            qDebug("ScoreFont::load(): open failed <%s>", qPrintable(facePath));
+            return;
+        }
+        fontImage = f.readAll();
     }
-    fontImage = f.readAll();
     int rval = FT_New_Memory_Face(ftlib, (FT_Byte*)fontImage.data(), fontImage.size(), 0, &face);
     if (rval) {
         qDebug("freetype: cannot create face <%s>: %d", qPrintable(facePath), rval);
         return;
     }
-    cache = new QCache<GlyphKey, GlyphPixmap>(100);
-
     qreal pixelSize = 200.0;
     FT_Set_Pixel_Sizes(face, 0, int(pixelSize + .5));
 
-    for (size_t id = 0; id < _mainSymCodeTable.size(); ++id) {
-        uint code = _mainSymCodeTable[id];
+    QFile fi(_fontPath + "metadata.json");
+    if (!fi.open(QIODevice::ReadOnly)) {
+        qDebug("ScoreFont: open glyph metadata file <%s> failed", qPrintable(fi.fileName()));
+    }
+    const QByteArray metadata = fi.readAll();
+
+    QString cachePath;
+    if (!MScore::fontMetricsCache.isEmpty()) {
+        cachePath = MScore::fontMetricsCache + _name + ".metrics";
+    }
+    const QByteArray key = cachePath.isEmpty() ? QByteArray() : metricsCacheKey(metadata);
+    if (cachePath.isEmpty() || !readMetricsCache(cachePath, key)) {
+        computeAllMetrics(metadata);
+        if (!cachePath.isEmpty()) {
+            writeMetricsCache(cachePath, key);
+        }
+    }
+    _engravingDefaults.push_back(std::make_pair(Sid::MusicalTextFont, QString("%1 Text").arg(_family)));
+
+    // create missing composed glyphs
+    struct Composed {
+        SymId id;
+        std::vector<SymId> rids;
+    } composed[] = {
+        { SymId::ornamentPrallMordent,
+          {
+              SymId::ornamentZigZagLineNoRightEnd,
+              SymId::ornamentZigZagLineNoRightEnd,
+              SymId::ornamentMiddleVerticalStroke,
+              SymId::ornamentZigZagLineWithRightEnd
+          } },
+        { SymId::ornamentUpPrall,
+          {
+              SymId::ornamentBottomLeftConcaveStroke,
+              SymId::ornamentZigZagLineNoRightEnd,
+              SymId::ornamentZigZagLineNoRightEnd,
+              SymId::ornamentZigZagLineWithRightEnd
+          } },
+        { SymId::ornamentUpMordent,
+          {
+              SymId::ornamentBottomLeftConcaveStroke,
+              SymId::ornamentZigZagLineNoRightEnd,
+              SymId::ornamentZigZagLineNoRightEnd,
+              SymId::ornamentMiddleVerticalStroke,
+              SymId::ornamentZigZagLineWithRightEnd
+          } },
+        { SymId::ornamentPrallDown,
+          {
+              SymId::ornamentZigZagLineNoRightEnd,
+              SymId::ornamentZigZagLineNoRightEnd,
+              SymId::ornamentZigZagLineNoRightEnd,
+              SymId::ornamentBottomRightConcaveStroke,
+          } },
+#if 0
+        {
+            SymId::ornamentDownPrall,
+            {
+                SymId::ornamentTopLeftConvexStroke,
+                SymId::ornamentZigZagLineNoRightEnd,
+                SymId::ornamentZigZagLineNoRightEnd,
+                SymId::ornamentZigZagLineWithRightEnd
+            }
+        },
+#endif
+        {
+            SymId::ornamentDownMordent,
+            {
+                SymId::ornamentLeftVerticalStroke,
+                SymId::ornamentZigZagLineNoRightEnd,
+                SymId::ornamentZigZagLineNoRightEnd,
+                SymId::ornamentMiddleVerticalStroke,
+                SymId::ornamentZigZagLineWithRightEnd
+            }
+        },
+        { SymId::ornamentPrallUp,
+          {
+              SymId::ornamentZigZagLineNoRightEnd,
+              SymId::ornamentZigZagLineNoRightEnd,
+              SymId::ornamentZigZagLineNoRightEnd,
+              SymId::ornamentTopRightConvexStroke,
+          } },
+        { SymId::ornamentLinePrall,
+          {
+              SymId::ornamentLeftVerticalStroke,
+              SymId::ornamentZigZagLineNoRightEnd,
+              SymId::ornamentZigZagLineNoRightEnd,
+              SymId::ornamentZigZagLineWithRightEnd
+          } }
+    };
+
+    for (const Composed& c : composed) {
+        if (!_symbols[int(c.id)].isValid()) {
+            Sym* sym = &_symbols[int(c.id)];
+            std::vector<SymId> s;
+            for (SymId id : c.rids) {
+                s.push_back(id);
+            }
+            sym->setSymList(s);
+            sym->setBbox(bbox(s, 1.0));
+        }
+    }
+
+#if 0
+    //
+    // check for missing symbols
+    //
+    ScoreFont* fb = ScoreFont::fallbackFont();
+    if (fb && fb != this) {
+        for (int i = 1; i < int(SymId::lastSym); ++i) {
+            const Sym& sym = _symbols[i];
+            if (!sym.isValid()) {
+                qDebug("invalid symbol %s", Sym::id2name(SymId(i)));
+            }
+        }
+    }
+#endif
+}
+
+//---------------------------------------------------------
+//   computeAllMetrics
+//    metrics of all symbols from the font and its
+//    metadata.json, this is what the metrics cache holds
+//---------------------------------------------------------
+
+void ScoreFont::computeAllMetrics(const QByteArray& metadata)
+{
+    const SymCodeTable& codeTable = mainSymCodeTable();
+    for (size_t id = 0; id < codeTable.size(); ++id) {
+        uint code = codeTable[id];
         if (code == 0) {
             continue;
         }
@@ -6684,13 +6863,9 @@ void ScoreFont::load()
     }
 
     QJsonParseError error;
-    QFile fi(_fontPath + "metadata.json");
-    if (!fi.open(QIODevice::ReadOnly)) {
-        qDebug("ScoreFont: open glyph metadata file <%s> failed", qPrintable(fi.fileName()));
-    }
-    QJsonObject metadataJson = QJsonDocument::fromJson(fi.readAll(), &error).object();
+    QJsonObject metadataJson = QJsonDocument::fromJson(metadata, &error).object();
     if (error.error != QJsonParseError::NoError) {
-        qDebug("Json parse error in <%s>(offset: %d): %s", qPrintable(fi.fileName()),
+        qDebug("Json parse error in <%smetadata.json>(offset: %d): %s", qPrintable(_fontPath),
                error.offset, qPrintable(error.errorString()));
     }
 
@@ -6783,91 +6958,6 @@ void ScoreFont::load()
             }
         }
     }
-    _engravingDefaults.push_back(std::make_pair(Sid::MusicalTextFont, QString("%1 Text").arg(_family)));
-
-    // create missing composed glyphs
-    struct Composed {
-        SymId id;
-        std::vector<SymId> rids;
-    } composed[] = {
-        { SymId::ornamentPrallMordent,
-          {
-              SymId::ornamentZigZagLineNoRightEnd,
-              SymId::ornamentZigZagLineNoRightEnd,
-              SymId::ornamentMiddleVerticalStroke,
-              SymId::ornamentZigZagLineWithRightEnd
-          } },
-        { SymId::ornamentUpPrall,
-          {
-              SymId::ornamentBottomLeftConcaveStroke,
-              SymId::ornamentZigZagLineNoRightEnd,
-              SymId::ornamentZigZagLineNoRightEnd,
-              SymId::ornamentZigZagLineWithRightEnd
-          } },
-        { SymId::ornamentUpMordent,
-          {
-              SymId::ornamentBottomLeftConcaveStroke,
-              SymId::ornamentZigZagLineNoRightEnd,
-              SymId::ornamentZigZagLineNoRightEnd,
-              SymId::ornamentMiddleVerticalStroke,
-              SymId::ornamentZigZagLineWithRightEnd
-          } },
-        { SymId::ornamentPrallDown,
-          {
-              SymId::ornamentZigZagLineNoRightEnd,
-              SymId::ornamentZigZagLineNoRightEnd,
-              SymId::ornamentZigZagLineNoRightEnd,
-              SymId::ornamentBottomRightConcaveStroke,
-          } },
-#if 0
-        {
-            SymId::ornamentDownPrall,
-            {
-                SymId::ornamentTopLeftConvexStroke,
-                SymId::ornamentZigZagLineNoRightEnd,
-                SymId::ornamentZigZagLineNoRightEnd,
-                SymId::ornamentZigZagLineWithRightEnd
-            }
-        },
-#endif
-        {
-            SymId::ornamentDownMordent,
-            {
-                SymId::ornamentLeftVerticalStroke,
-                SymId::ornamentZigZagLineNoRightEnd,
-                SymId::ornamentZigZagLineNoRightEnd,
-                SymId::ornamentMiddleVerticalStroke,
-                SymId::ornamentZigZagLineWithRightEnd
-            }
-        },
-        { SymId::ornamentPrallUp,
-          {
-              SymId::ornamentZigZagLineNoRightEnd,
-              SymId::ornamentZigZagLineNoRightEnd,
-              SymId::ornamentZigZagLineNoRightEnd,
-              SymId::ornamentTopRightConvexStroke,
-          } },
-        { SymId::ornamentLinePrall,
-          {
-              SymId::ornamentLeftVerticalStroke,
-              SymId::ornamentZigZagLineNoRightEnd,
-              SymId::ornamentZigZagLineNoRightEnd,
-              SymId::ornamentZigZagLineWithRightEnd
-          } }
-    };
-
-    for (const Composed& c : composed) {
-        if (!_symbols[int(c.id)].isValid()) {
-            Sym* sym = &_symbols[int(c.id)];
-            std::vector<SymId> s;
-            for (SymId id : c.rids) {
-                s.push_back(id);
-            }
-            sym->setSymList(s);
-            sym->setBbox(bbox(s, 1.0));
-        }
-    }
-
     // access needed stylistic alternates
 
     struct StylisticAlternate {
@@ -6963,21 +7053,166 @@ void ScoreFont::load()
     // add space symbol
     Sym* sym = &_symbols[int(SymId::space)];
     computeMetrics(sym, 32);
+}
 
-#if 0
-    //
-    // check for missing symbols
-    //
-    ScoreFont* fb = ScoreFont::fallbackFont();
-    if (fb && fb != this) {
-        for (int i = 1; i < int(SymId::lastSym); ++i) {
-            const Sym& sym = _symbols[i];
-            if (!sym.isValid()) {
-                qDebug("invalid symbol %s", Sym::id2name(SymId(i)));
+//---------------------------------------------------------
+//   mainSymCodeTable
+//    SMuFL code points of all symbols, glyphnames.json is
+//    read only when a font has to compute its metrics
+//---------------------------------------------------------
+
+const ScoreFont::SymCodeTable& ScoreFont::mainSymCodeTable()
+{
+    static const SymCodeTable table = []() {
+        SymCodeTable t { { 0 } };
+        QJsonObject glyphNamesJson(ScoreFont::initGlyphNamesJson());
+        if (glyphNamesJson.empty()) {
+            qFatal("initGlyphNamesJson failed");
+        }
+        for (size_t i = 0; i < Sym::symNames.size(); ++i) {
+            const char* name = Sym::symNames[i];
+            bool ok;
+            uint code = glyphNamesJson.value(name).toObject().value("codepoint").toString().midRef(2).toUInt(&ok, 16);
+            if (ok) {
+                t[i] = code;
+            } else if (MScore::debugMode) {
+                qDebug("codepoint not recognized for glyph %s", name);
             }
         }
+        return t;
+    }();
+    return table;
+}
+
+//---------------------------------------------------------
+//   metricsCacheKey
+//    the metrics depend on the font, its metadata and on
+//    the program and FreeType versions computing them
+//---------------------------------------------------------
+
+QByteArray ScoreFont::metricsCacheKey(const QByteArray& metadata) const
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(fontImage);
+    hash.addData(metadata);
+    hash.addData(VERSION);
+    hash.addData(QByteArray::number(METRICS_CACHE_VERSION));
+    hash.addData(QByteArray::number(FREETYPE_MAJOR * 10000 + FREETYPE_MINOR * 100 + FREETYPE_PATCH));
+    hash.addData(QSysInfo::buildAbi().toUtf8());
+    return hash.result();
+}
+
+//---------------------------------------------------------
+//   readMetricsCache
+//    return false if there is no valid cache for key
+//---------------------------------------------------------
+
+bool ScoreFont::readMetricsCache(const QString& path, const QByteArray& key)
+{
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    const qint64 size = f.size();
+    if (size < qint64(sizeof(MetricsCacheHeader))) {
+        return false;
+    }
+    QByteArray buffer;
+    const char* data = reinterpret_cast<const char*>(f.map(0, size));
+    if (!data) {
+        buffer = f.readAll();
+        data = buffer.constData();
+    }
+
+    MetricsCacheHeader h;
+    memcpy(&h, data, sizeof(h));
+    if (memcmp(h.magic, "MSFM", 4) != 0 || h.version != METRICS_CACHE_VERSION
+        || key.size() != int(sizeof(h.key)) || memcmp(h.key, key.constData(), sizeof(h.key)) != 0
+        || h.symbols != quint32(_symbols.size())
+        || size != qint64(sizeof(h) + h.symbols * sizeof(MetricsCacheSym)
+                          + h.engravingDefaults * sizeof(MetricsCacheDefault))) {
+        return false;
+    }
+
+    const char* p = data + sizeof(h);
+    for (Sym& sym : _symbols) {
+        MetricsCacheSym cs;
+        memcpy(&cs, p, sizeof(cs));
+        p += sizeof(cs);
+        sym._code    = cs.code;
+        sym._index   = cs.index;
+        sym._bbox    = QRectF(cs.bbox[0], cs.bbox[1], cs.bbox[2], cs.bbox[3]);
+        sym._advance = cs.advance;
+        sym.smuflAnchors.clear();
+        for (int i = 0; i < SMUFL_ANCHORS; ++i) {
+            if (cs.anchors & (1u << i)) {
+                sym.smuflAnchors[SmuflAnchorId(i)] = QPointF(cs.anchor[i][0], cs.anchor[i][1]);
+            }
+        }
+    }
+    _engravingDefaults.clear();
+    for (quint32 i = 0; i < h.engravingDefaults; ++i) {
+        MetricsCacheDefault cd;
+        memcpy(&cd, p, sizeof(cd));
+        p += sizeof(cd);
+        _engravingDefaults.push_back(std::make_pair(Sid(cd.sid), QVariant(cd.value)));
+    }
+    _textEnclosureThickness = h.textEnclosureThickness;
+    return true;
+}
+
+//---------------------------------------------------------
+//   writeMetricsCache
+//---------------------------------------------------------
+
+void ScoreFont::writeMetricsCache(const QString& path, const QByteArray& key) const
+{
+    if (!QDir().mkpath(QFileInfo(path).absolutePath())) {
+        return;
+    }
+    QSaveFile f(path);
+    if (!f.open(QIODevice::WriteOnly)) {
+        qDebug("ScoreFont: cannot write metrics cache <%s>", qPrintable(path));
+        return;
+    }
+
+    MetricsCacheHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, "MSFM", 4);
+    h.version = METRICS_CACHE_VERSION;
+    memcpy(h.key, key.constData(), qMin(size_t(key.size()), sizeof(h.key)));
+    h.symbols = quint32(_symbols.size());
+    h.engravingDefaults = quint32(_engravingDefaults.size());
+    h.textEnclosureThickness = _textEnclosureThickness;
+    f.write(reinterpret_cast<const char*>(&h), sizeof(h));
+
+    for (const Sym& sym : _symbols) {
+        MetricsCacheSym cs;
+        memset(&cs, 0, sizeof(cs));
+        cs.code    = sym._code;
+        cs.index   = sym._index;
+        cs.bbox[0] = sym._bbox.x();
+        cs.bbox[1] = sym._bbox.y();
+        cs.bbox[2] = sym._bbox.width();
+        cs.bbox[3] = sym._bbox.height();
+        cs.advance = sym._advance;
+        for (const auto& a : sym.smuflAnchors) {
+            cs.anchors |= 1u << int(a.first);
+            cs.anchor[int(a.first)][0] = a.second.x();
+            cs.anchor[int(a.first)][1] = a.second.y();
+        }
+        f.write(reinterpret_cast<const char*>(&cs), sizeof(cs));
+    }
+    for (const auto& d : _engravingDefaults) {
+        MetricsCacheDefault cd;
+        memset(&cd, 0, sizeof(cd));
+        cd.sid   = int(d.first);
+        cd.value = d.second.toDouble();
+        f.write(reinterpret_cast<const char*>(&cd), sizeof(cd));
+    }
+    if (!f.commit()) {
+        qDebug("ScoreFont: cannot write metrics cache <%s>", qPrintable(path));
     }
-#endif
 }
 
 //---------------------------------------------------------
@@ -7002,9 +7237,7 @@ ScoreFont* ScoreFont::fontFactory(QString s)
         return fallbackFont();
     }
 
-    if (!f->face) {
-        f->load();
-    }
+    f->loadOnce();
     return f;
 }
 
@@ -7015,12 +7248,22 @@ ScoreFont* ScoreFont::fontFactory(QString s)
 ScoreFont* ScoreFont::fallbackFont()
 {
     ScoreFont* f = &_scoreFonts[FALLBACK_FONT];
-    if (!f->face) {
-        f->load();
-    }
+    f->loadOnce();
     return f;
 }
 
+//---------------------------------------------------------
+//   loadOnce
+//---------------------------------------------------------
+
+void ScoreFont::loadOnce()
+{
+    QMutexLocker locker(&loadMutex);
+    if (!face) {
+        load();
+    }
+}
+
 //---------------------------------------------------------
 //   fallbackTextFont
 //---------------------------------------------------------
@@ -7134,11 +7377,9 @@ ScoreFont::ScoreFont(const ScoreFont& f)
     _filename = f._filename;
 
     // fontImage;
-    cache = 0;
 }
 
 ScoreFont::~ScoreFont()
 {
-    delete cache;
 }
 }
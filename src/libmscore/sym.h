@@ -14,6 +14,7 @@
 #define __SYM_H__
 
 #include <QApplication>
+#include <QImage>
 
 #include "config.h"
 #include "style.h"
@@ -3128,13 +3129,17 @@ public:
 //---------------------------------------------------------
 
 struct GlyphPixmap {
-    QPixmap pm;
+    QImage image;           // premultiplied, safe to share between threads
     QPointF offset;
 };
 
 inline uint qHash(const GlyphKey& k)
 {
-    return (int(k.id) << 16) + (int(k.magX * 100) << 8) + k.magY * 100;
+    uint h = ::qHash(quintptr(k.face)) ^ (uint(k.id) << 8);
+    h = 31 * h + ::qHash(k.magX);
+    h = 31 * h + ::qHash(k.magY);
+    h = 31 * h + ::qHash(k.worldScale);
+    return 31 * h + k.color.rgba();
 }
 
 //---------------------------------------------------------
@@ -3151,15 +3156,20 @@ class ScoreFont
     QString _fontPath;
     QString _filename;
     QByteArray fontImage;
-    QCache<GlyphKey, GlyphPixmap>* cache { 0 };
     std::list<std::pair<Sid, QVariant> > _engravingDefaults;
     double _textEnclosureThickness = 0;
     mutable QFont* font { 0 };
 
     static QVector<ScoreFont> _scoreFonts;
-    static std::array<uint, size_t(SymId::lastSym) + 1> _mainSymCodeTable;
+    typedef std::array<uint, size_t(SymId::lastSym) + 1> SymCodeTable;
+    static const SymCodeTable& mainSymCodeTable();
     void load();
+    void loadOnce();
     void computeMetrics(Sym* sym, int code);
+    void computeAllMetrics(const QByteArray& metadata);
+    QByteArray metricsCacheKey(const QByteArray& metadata) const;
+    bool readMetricsCache(const QString& path, const QByteArray& key);
+    void writeMetricsCache(const QString& path, const QByteArray& key) const;
 
 public:
     ScoreFont() {}
@@ -3210,6 +3220,8 @@ public:
 
     QPointF smuflAnchor(SymId symId, SmuflAnchorId anchorId, qreal mag) const;
 
+    const GlyphPixmap* glyph(SymId id, const QSizeF& mag, qreal worldScale, const QColor& color) const;
+
     bool isValid(SymId id) const { return sym(id).isValid(); }
     bool useFallbackFont(SymId id) const;
 
@@ -0,0 +1,118 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+#ifndef __TAGHASH_H__
+#define __TAGHASH_H__
+
+#include <initializer_list>
+#include <vector>
+#include <QMultiHash>
+#include <QStringRef>
+
+namespace Ms {
+typedef quint64 TagHash;
+
+static constexpr TagHash TAG_HASH_BASIS = 0xcbf29ce484222325ULL;
+static constexpr TagHash TAG_HASH_PRIME = 0x100000001b3ULL;
+
+//---------------------------------------------------------
+//   tagHash
+//    64 bit FNV-1a over the characters of an xml tag name.
+//    The constexpr overload allows switching on tag names,
+//    e.g. in readProperties():
+//          switch (tagHash(e.name())) {
+//          case tagHash("pitch"): ...
+//    Two handled names with the same hash would be duplicate
+//    case labels and fail to compile. Switch on
+//    TagIndex::hash() instead of tagHash() so that a tag
+//    which merely shares the hash of a name is not taken.
+//---------------------------------------------------------
+
+constexpr TagHash tagHash(const char* s)
+{
+    TagHash h = TAG_HASH_BASIS;
+    for (; *s; ++s) {
+        h = (h ^ TagHash(static_cast<unsigned char>(*s))) * TAG_HASH_PRIME;
+    }
+    return h;
+}
+
+inline TagHash tagHash(const QStringRef& s)
+{
+    TagHash h = TAG_HASH_BASIS;
+    const QChar* p = s.unicode();
+    for (int i = 0; i < s.size(); ++i) {
+        h = (h ^ TagHash(p[i].unicode())) * TAG_HASH_PRIME;
+    }
+    return h;
+}
+
+//---------------------------------------------------------
+//   TagIndex
+//    maps the names of a table to their index; the name
+//    of an entry is compared on a hash hit
+//---------------------------------------------------------
+
+class TagIndex
+{
+    QMultiHash<TagHash, int> _index;
+    std::vector<const char*> _names;
+
+    int find(const QStringRef& s, TagHash h) const
+    {
+        for (auto i = _index.constFind(h); i != _index.cend() && i.key() == h; ++i) {
+            if (s == QLatin1String(_names[size_t(i.value())])) {
+                return i.value();
+            }
+        }
+        return -1;
+    }
+
+public:
+    template<typename T, typename NameFunc>
+    TagIndex(const T* table, int n, NameFunc name)
+    {
+        _names.reserve(size_t(n));
+        for (int i = 0; i < n; ++i) {
+            _names.push_back(name(table[i]));
+        }
+        _index.reserve(n);
+        // the most recently inserted entry is found first, so the first one wins on duplicate names
+        for (int i = n - 1; i >= 0; --i) {
+            if (_names[size_t(i)]) {            // entries without a name are not read from xml
+                _index.insert(tagHash(_names[size_t(i)]), i);
+            }
+        }
+    }
+
+    TagIndex(std::initializer_list<const char*> names)
+        : TagIndex(names.begin(), int(names.size()), [](const char* n) { return n; }) {}
+
+    // index of the entry named s, -1 if there is none
+    int find(const QStringRef& s) const { return find(s, tagHash(s)); }
+
+    // tagHash(s) if s is one of the names, 0 otherwise
+    TagHash hash(const QStringRef& s) const
+    {
+        const TagHash h = tagHash(s);
+        return find(s, h) >= 0 ? h : 0;
+    }
+};
+}     // namespace Ms
+#endif
@@ -0,0 +1,186 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+#include <thread>
+
+#include "testing/qtestsuite.h"
+#include "testbase.h"
+#include "libmscore/glyphcache.h"
+#include "libmscore/note.h"
+#include "libmscore/page.h"
+#include "libmscore/score.h"
+
+static const QString GLYPHCACHE_DATA_DIR("note_data/");
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestGlyphCache
+//---------------------------------------------------------
+
+class TestGlyphCache : public QObject, public MTest
+{
+    Q_OBJECT
+
+    static GlyphKey key(SymId id) { return GlyphKey(nullptr, id, 1.0, 1.0, 1.0, Qt::black); }
+    static GlyphPixmap glyph();
+
+private slots:
+    void initTestCase();
+    void init();
+    void cleanupTestCase();
+    void hitsAndMisses();
+    void sharedBetweenThreads();
+    void budget();
+    void prewarm();
+};
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestGlyphCache::initTestCase()
+{
+    initMTest();
+}
+
+void TestGlyphCache::init()
+{
+    GlyphCache::clear();
+    GlyphCache::resetStatistics();
+}
+
+void TestGlyphCache::cleanupTestCase()
+{
+    GlyphCache::setBudget(32 * 1024 * 1024);
+}
+
+//---------------------------------------------------------
+//   glyph
+//    100x100 pixels, 40000 bytes of image data
+//---------------------------------------------------------
+
+GlyphPixmap TestGlyphCache::glyph()
+{
+    GlyphPixmap pm;
+    pm.image = QImage(100, 100, QImage::Format_ARGB32_Premultiplied);
+    pm.image.fill(Qt::black);
+    return pm;
+}
+
+//---------------------------------------------------------
+//   hitsAndMisses
+//---------------------------------------------------------
+
+void TestGlyphCache::hitsAndMisses()
+{
+    QVERIFY(!GlyphCache::find(key(SymId::noteheadBlack)));
+    GlyphCache::insert(key(SymId::noteheadBlack), glyph());
+    QVERIFY(GlyphCache::find(key(SymId::noteheadBlack)));
+    QVERIFY(!GlyphCache::find(key(SymId::noteheadHalf)));
+
+    GlyphCache::Statistics s = GlyphCache::statistics();
+    QCOMPARE(s.hits, quint64(1));
+    QCOMPARE(s.misses, quint64(2));
+    QCOMPARE(s.sharedGlyphs, 1);
+}
+
+//---------------------------------------------------------
+//   sharedBetweenThreads
+//    a glyph rendered by one thread is found by the others
+//    and shares its image data
+//---------------------------------------------------------
+
+void TestGlyphCache::sharedBetweenThreads()
+{
+    const GlyphPixmap* pm = GlyphCache::insert(key(SymId::noteheadBlack), glyph());
+    const qint64 imageKey = pm->image.cacheKey();
+
+    qint64 found = 0;
+    std::thread thread([&found]() {
+        const GlyphPixmap* pm = GlyphCache::find(key(SymId::noteheadBlack));
+        found = pm ? pm->image.cacheKey() : -1;
+    });
+    thread.join();
+    QCOMPARE(found, imageKey);
+}
+
+//---------------------------------------------------------
+//   budget
+//    the least recently used glyphs are dropped when the
+//    glyphs take more memory than the budget
+//---------------------------------------------------------
+
+void TestGlyphCache::budget()
+{
+    GlyphCache::setBudget(100000);
+    GlyphCache::insert(key(SymId::noteheadBlack), glyph());
+    GlyphCache::insert(key(SymId::noteheadHalf), glyph());
+    GlyphCache::insert(key(SymId::noteheadWhole), glyph());
+
+    GlyphCache::Statistics s = GlyphCache::statistics();
+    QCOMPARE(s.sharedGlyphs, 2);
+    QVERIFY(s.sharedBytes <= GlyphCache::budget());
+
+    // a new thread only sees the shared glyphs
+    bool black = true;
+    bool whole = false;
+    std::thread thread([&black, &whole]() {
+        black = GlyphCache::find(key(SymId::noteheadBlack));
+        whole = GlyphCache::find(key(SymId::noteheadWhole));
+    });
+    thread.join();
+    QVERIFY(!black);
+    QVERIFY(whole);
+
+    GlyphCache::setBudget(32 * 1024 * 1024);
+}
+
+//---------------------------------------------------------
+//   prewarm
+//    noteheads of a prewarmed page are drawn from the cache
+//---------------------------------------------------------
+
+void TestGlyphCache::prewarm()
+{
+    MasterScore* score = readScore(GLYPHCACHE_DATA_DIR + "grace.mscx");
+    QVERIFY(score);
+    QVERIFY(!score->pages().empty());
+
+    const QList<Element*> elements = score->pages().front()->elements();
+    GlyphCache::prewarm(elements, 1.0);
+    GlyphCache::resetStatistics();
+
+    int notes = 0;
+    for (const Element* e : elements) {
+        if (e->isNote() && e->visible()) {
+            const Note* note = toNote(e);
+            const qreal mag = note->magS();
+            QVERIFY(score->scoreFont()->glyph(note->noteHead(), QSizeF(mag, mag), 1.0, note->curColor()));
+            ++notes;
+        }
+    }
+    QVERIFY(notes > 0);
+    QCOMPARE(GlyphCache::statistics().misses, quint64(0));
+
+    delete score;
+}
+
+QTEST_MAIN(TestGlyphCache)
+#include "tst_glyphcache.moc"
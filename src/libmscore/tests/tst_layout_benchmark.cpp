@@ -10,8 +10,14 @@
 //  the file LICENCE.GPL
 //=============================================================================
 
+#include <QSet>
+#include <QTemporaryDir>
+#include <QThread>
+
 #include "testing/qtestsuite.h"
 #include "testbase.h"
+#include "libmscore/measure.h"
+#include "libmscore/page.h"
 #include "libmscore/score.h"
 
 static const QString LAYOUT_DATA_DIR("layout_data/");
@@ -32,13 +38,21 @@ class TestLayoutBenchmark : public QObject, public MTest
 
     MasterScore * score;
     void beam(const char* path);
+    void writeOrchestralScore(const QString& path, int staves, int measures);
+    MasterScore* readLongScore(const QString& path, int pages);
 
 private slots:
     void initTestCase();
     void benchmark3();
+    void benchmark3Orchestral();    // load a large synthetic score
     void benchmark1();
+    void benchmark2_data();
     void benchmark2();
     void benchmark4();              // incremental layout (one page)
+    void parallelLayout();
+    void bspTreeUpdate_data();
+    void bspTreeUpdate();          // page queries after an edit on a 100 page score
+    void bspTreeIncremental();
 };
 
 //---------------------------------------------------------
@@ -65,6 +79,69 @@ void TestLayoutBenchmark::benchmark3()
     }
 }
 
+//---------------------------------------------------------
+//   writeOrchestralScore
+//    write a score of quarter note chords on many staves
+//---------------------------------------------------------
+
+void TestLayoutBenchmark::writeOrchestralScore(const QString& path, int staves, int measures)
+{
+    QFile f(path);
+    QVERIFY(f.open(QIODevice::WriteOnly));
+    QTextStream ts(&f);
+    auto tpc = [](int pitch) { return 14 + (pitch * 7) % 12; };        // spelled with sharps
+    ts << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+       << "<museScore version=\"3.02\">\n<Score>\n<Division>480</Division>\n";
+    for (int i = 1; i <= staves; ++i) {
+        ts << "<Part>\n<Staff id=\"" << i << "\">\n"
+           << "<StaffType group=\"pitched\"><name>stdNormal</name></StaffType>\n</Staff>\n"
+           << "<trackName>Violin</trackName>\n<Instrument>\n<longName>Violin</longName>\n"
+           << "<trackName>Violin</trackName>\n<Channel><program value=\"40\"/></Channel>\n"
+           << "</Instrument>\n</Part>\n";
+    }
+    for (int i = 1; i <= staves; ++i) {
+        ts << "<Staff id=\"" << i << "\">\n";
+        for (int m = 0; m < measures; ++m) {
+            ts << "<Measure>\n<voice>\n";
+            if (m == 0) {
+                ts << "<Clef><concertClefType>G</concertClefType><transposingClefType>G</transposingClefType></Clef>\n"
+                   << "<TimeSig><sigN>4</sigN><sigD>4</sigD></TimeSig>\n";
+            }
+            for (int n = 0; n < 4; ++n) {
+                int pitch = 60 + (m + n + i) % 12;
+                ts << "<Chord>\n<durationType>quarter</durationType>\n"
+                   << "<Note>\n<pitch>" << pitch << "</pitch>\n<tpc>" << tpc(pitch) << "</tpc>\n</Note>\n"
+                   << "<Note>\n<pitch>" << pitch + 4 << "</pitch>\n<tpc>" << tpc(pitch + 4) << "</tpc>\n</Note>\n"
+                   << "</Chord>\n";
+            }
+            ts << "</voice>\n</Measure>\n";
+        }
+        ts << "</Staff>\n";
+    }
+    ts << "</Score>\n</museScore>\n";
+}
+
+//---------------------------------------------------------
+//   benchmark3Orchestral
+//    about 10 MB of .mscx
+//---------------------------------------------------------
+
+void TestLayoutBenchmark::benchmark3Orchestral()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QString path = dir.filePath("orchestral.mscx");
+    writeOrchestralScore(path, 24, 800);
+    QVERIFY(QFileInfo(path).size() >= 10000000);
+
+    QBENCHMARK {
+        MasterScore* s = new MasterScore(mscore->baseStyle());
+        s->setName(path);
+        QCOMPARE(s->loadMsc(path, false), Score::FileError::FILE_NO_ERROR);
+        delete s;
+    }
+}
+
 void TestLayoutBenchmark::benchmark1()
 {
     // score = readScore(LAYOUT_DATA_DIR + "goldberg.mscx");
@@ -73,12 +150,22 @@ void TestLayoutBenchmark::benchmark1()
     }
 }
 
+void TestLayoutBenchmark::benchmark2_data()
+{
+    QTest::addColumn<int>("threads");
+    QTest::newRow("sequential") << 1;
+    QTest::newRow("parallel") << QThread::idealThreadCount();
+}
+
 void TestLayoutBenchmark::benchmark2()
 {
+    QFETCH(int, threads);
+    MScore::layoutThreads = threads;
     score->doLayout();
     QBENCHMARK {                          // warm run
         score->doLayout();
     }
+    MScore::layoutThreads = 1;
 }
 
 void TestLayoutBenchmark::benchmark4()
@@ -90,5 +177,138 @@ void TestLayoutBenchmark::benchmark4()
     }
 }
 
+//---------------------------------------------------------
+//   parallelLayout
+//    laying out measures on several threads must give
+//    the same result as the sequential layout
+//---------------------------------------------------------
+
+void TestLayoutBenchmark::parallelLayout()
+{
+    MScore::layoutThreads = 1;
+    score->doLayout();
+    QVector<QRectF> sequential;
+    for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+        sequential.append(QRectF(m->pagePos(), QSizeF(m->width(), m->height())));
+    }
+
+    MScore::layoutThreads = qMax(QThread::idealThreadCount(), 4);
+    score->doLayout();
+    MScore::layoutThreads = 1;
+
+    int i = 0;
+    for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure(), ++i) {
+        QVERIFY(i < sequential.size());
+        QCOMPARE(QRectF(m->pagePos(), QSizeF(m->width(), m->height())), sequential[i]);
+    }
+    QCOMPARE(i, sequential.size());
+}
+
+//---------------------------------------------------------
+//   readLongScore
+//    read a synthetic score of at least the given number of pages
+//---------------------------------------------------------
+
+MasterScore* TestLayoutBenchmark::readLongScore(const QString& path, int pages)
+{
+    for (int measures = 1000;; measures *= 2) {
+        writeOrchestralScore(path, 2, measures);
+        MasterScore* s = readCreatedScore(path);
+        if (!s || s->npages() >= pages) {
+            return s;
+        }
+        delete s;
+    }
+}
+
+//---------------------------------------------------------
+//   bspTreeUpdate
+//    edit one measure in the middle of the score and query
+//    every page, "full" rebuilds all trees for comparison
+//---------------------------------------------------------
+
+void TestLayoutBenchmark::bspTreeUpdate_data()
+{
+    QTest::addColumn<bool>("full");
+    QTest::newRow("incremental") << false;
+    QTest::newRow("full") << true;
+}
+
+void TestLayoutBenchmark::bspTreeUpdate()
+{
+    QFETCH(bool, full);
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    MasterScore* s = readLongScore(dir.filePath("long.mscx"), 100);
+    QVERIFY(s);
+
+    Measure* m = s->firstMeasure();
+    for (int i = 0; m && i < s->nmeasures() / 2; ++i) {
+        m = m->nextMeasure();
+    }
+    QVERIFY(m);
+
+    for (Page* p : s->pages()) {
+        p->items(p->abbox());
+    }
+
+    QBENCHMARK {
+        s->startCmd();
+        s->setLayout(m->tick(), -1);
+        s->endCmd();
+        if (full) {
+            s->rebuildBspTree();
+        }
+        for (Page* p : s->pages()) {
+            p->items(p->abbox());
+        }
+    }
+    delete s;
+}
+
+//---------------------------------------------------------
+//   bspTreeIncremental
+//    after an edit the updated trees must find the same
+//    elements as trees built from scratch
+//---------------------------------------------------------
+
+void TestLayoutBenchmark::bspTreeIncremental()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QString path = dir.filePath("edit.mscx");
+    writeOrchestralScore(path, 2, 200);
+    MasterScore* s = readCreatedScore(path);
+    QVERIFY(s);
+
+    for (Page* p : s->pages()) {
+        p->items(p->abbox());
+    }
+
+    Measure* m = s->firstMeasure();
+    for (int i = 0; m && i < 30; ++i) {
+        m = m->nextMeasure();
+    }
+    QVERIFY(m);
+    s->startCmd();
+    s->undoChangeProperty(m, Pid::USER_STRETCH, 3.0);
+    s->endCmd();
+
+    QVector<QSet<Element*> > updated;
+    for (Page* p : s->pages()) {
+        QList<Element*> items = p->items(p->abbox());
+        updated.append(QSet<Element*>(items.begin(), items.end()));
+    }
+
+    s->rebuildBspTree();
+    for (int i = 0; i < s->npages(); ++i) {
+        Page* p = s->pages()[i];
+        QList<Element*> items = p->items(p->abbox());
+        QCOMPARE(updated[i], QSet<Element*>(items.begin(), items.end()));
+    }
+    delete s;
+}
+
 QTEST_MAIN(TestLayoutBenchmark)
 #include "tst_layout_benchmark.moc"
@@ -0,0 +1,285 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+#include <QTemporaryDir>
+
+#include "testing/qtestsuite.h"
+#include "testbase.h"
+#include "libmscore/chord.h"
+#include "libmscore/measure.h"
+#include "libmscore/note.h"
+#include "libmscore/page.h"
+#include "libmscore/score.h"
+#include "libmscore/segment.h"
+#include "libmscore/system.h"
+
+static const QString GOLDBERG_PATH("/../../../demos/goldberg.mscz");
+
+using namespace Ms;
+
+struct ElementLayout {
+    ElementType type;
+    QRectF bbox;
+};
+
+//---------------------------------------------------------
+//   TestLayoutCache
+//---------------------------------------------------------
+
+class TestLayoutCache : public QObject, public MTest
+{
+    Q_OBJECT
+
+    struct MeasureLayout {
+        QPointF pos;
+        qreal width;
+        int systemIdx;
+    };
+
+    Chord* chordAt(Score* score, int measureIdx);
+    QVector<MeasureLayout> measureLayout(Score* score);
+    QVector<ElementLayout> elementLayout(Score* score);
+    void edit(Score* score, int edit);
+
+private slots:
+    void initTestCase();
+    void fullLayout();
+    void editReusesMeasures_data();
+    void editReusesMeasures();
+    void savedSystemBreaks();
+};
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestLayoutCache::initTestCase()
+{
+    initMTest();
+}
+
+//---------------------------------------------------------
+//   chordAt
+//---------------------------------------------------------
+
+Chord* TestLayoutCache::chordAt(Score* score, int measureIdx)
+{
+    Measure* m = score->firstMeasure();
+    for (int i = 0; m && i < measureIdx; ++i) {
+        m = m->nextMeasure();
+    }
+    for (Segment* s = m ? m->first(SegmentType::ChordRest) : nullptr; s; s = s->next1(SegmentType::ChordRest)) {
+        for (Element* e : s->elist()) {
+            if (e && e->isChord()) {
+                return toChord(e);
+            }
+        }
+    }
+    return nullptr;
+}
+
+//---------------------------------------------------------
+//   elementLayout
+//    position and size of every element, in scan order
+//---------------------------------------------------------
+
+static void collectElementLayout(void* data, Element* e)
+{
+    static_cast<QVector<ElementLayout>*>(data)->append({ e->type(), e->pageBoundingRect() });
+}
+
+QVector<ElementLayout> TestLayoutCache::elementLayout(Score* score)
+{
+    QVector<ElementLayout> layout;
+    for (Page* page : score->pages()) {
+        page->scanElements(&layout, collectElementLayout, true);
+    }
+    return layout;
+}
+
+//---------------------------------------------------------
+//   edit
+//---------------------------------------------------------
+
+void TestLayoutCache::edit(Score* score, int edit)
+{
+    Chord* chord = chordAt(score, 3);
+    QVERIFY(chord);
+
+    score->startCmd();
+    switch (edit) {
+    case 0:
+        chord->undoChangeProperty(Pid::SMALL, true);
+        break;
+    case 1:
+        chord->undoChangeProperty(Pid::STEM_DIRECTION, QVariant::fromValue<Direction>(Direction::DOWN));
+        break;
+    case 2:
+        chord->measure()->undoChangeProperty(Pid::USER_STRETCH, 2.0);
+        break;
+    case 3:
+        chord->notes().front()->undoChangeProperty(Pid::PITCH, chord->notes().front()->pitch() + 1);
+        break;
+    }
+    score->endCmd();
+}
+
+//---------------------------------------------------------
+//   measureLayout
+//---------------------------------------------------------
+
+QVector<TestLayoutCache::MeasureLayout> TestLayoutCache::measureLayout(Score* score)
+{
+    QVector<MeasureLayout> layout;
+    for (Measure* m = score->firstMeasureMM(); m; m = m->nextMeasureMM()) {
+        layout.append({ m->pagePos(), m->width(), score->systems().indexOf(m->system()) });
+    }
+    return layout;
+}
+
+//---------------------------------------------------------
+//   fullLayout
+//    a full layout has nothing to reuse
+//---------------------------------------------------------
+
+void TestLayoutCache::fullLayout()
+{
+    MasterScore* score = readCreatedScore(root + GOLDBERG_PATH);
+    QVERIFY(score);
+
+    score->doLayout();
+    const LayoutStatistics& ls = score->layoutStatistics();
+    QCOMPARE(ls.measuresReused, 0);
+    QCOMPARE(ls.measuresLaidOut, score->nmeasures());
+    QCOMPARE(ls.systemsCollected, score->systems().size());
+
+    delete score;
+}
+
+//---------------------------------------------------------
+//   editReusesMeasures
+//    an edit near the start only recomputes the measures
+//    around it, and every element ends up where it is
+//    without reusing measures
+//---------------------------------------------------------
+
+void TestLayoutCache::editReusesMeasures_data()
+{
+    QTest::addColumn<int>("edit");
+    QTest::newRow("small") << 0;
+    QTest::newRow("stem") << 1;
+    QTest::newRow("stretch") << 2;
+    QTest::newRow("pitch") << 3;
+}
+
+void TestLayoutCache::editReusesMeasures()
+{
+    QFETCH(int, edit);
+
+    MasterScore* reused = readCreatedScore(root + GOLDBERG_PATH);
+    QVERIFY(reused);
+    this->edit(reused, edit);
+
+    const LayoutStatistics ls = reused->layoutStatistics();
+    QVERIFY(ls.measuresReused > 0);
+    QVERIFY(ls.measuresLaidOut < reused->nmeasures());
+
+    MScore::reuseMeasureLayout = false;
+    MasterScore* recomputed = readCreatedScore(root + GOLDBERG_PATH);
+    QVERIFY(recomputed);
+    this->edit(recomputed, edit);
+    MScore::reuseMeasureLayout = true;
+    QCOMPARE(recomputed->layoutStatistics().measuresReused, 0);
+
+    QVector<MeasureLayout> m1 = measureLayout(reused);
+    QVector<MeasureLayout> m2 = measureLayout(recomputed);
+    QCOMPARE(m1.size(), m2.size());
+    for (int i = 0; i < m1.size(); ++i) {
+        QCOMPARE(m1[i].systemIdx, m2[i].systemIdx);
+    }
+
+    QVector<ElementLayout> e1 = elementLayout(reused);
+    QVector<ElementLayout> e2 = elementLayout(recomputed);
+    QCOMPARE(e1.size(), e2.size());
+    for (int i = 0; i < e1.size(); ++i) {
+        QCOMPARE(e1[i].type, e2[i].type);
+        QCOMPARE(e1[i].bbox, e2[i].bbox);
+    }
+
+    delete reused;
+    delete recomputed;
+}
+
+//---------------------------------------------------------
+//   savedSystemBreaks
+//    a score saved with its layout cache is laid out the
+//    same way after loading, with the measures at the
+//    cached positions; the cache is ignored when switched
+//    off
+//---------------------------------------------------------
+
+void TestLayoutCache::savedSystemBreaks()
+{
+    MasterScore* score = readCreatedScore(root + GOLDBERG_PATH);
+    QVERIFY(score);
+    QCOMPARE(score->layoutStatistics().systemsFromCache, 0);
+    QVector<MeasureLayout> original = measureLayout(score);
+    QVector<ElementLayout> originalElements = elementLayout(score);
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QString path = dir.filePath("goldberg.mscz");
+    QFile f(path);
+    QVERIFY(f.open(QIODevice::WriteOnly));
+    QVERIFY(score->saveCompressedFile(&f, "goldberg.mscx", false, false));
+    f.close();
+    delete score;
+
+    score = readCreatedScore(path);
+    QVERIFY(score);
+    QVERIFY(score->layoutStatistics().systemsFromCache > 0);
+    QVector<MeasureLayout> cached = measureLayout(score);
+    QCOMPARE(cached.size(), original.size());
+    for (int i = 0; i < original.size(); ++i) {
+        QCOMPARE(cached[i].systemIdx, original[i].systemIdx);
+        QCOMPARE(cached[i].pos, original[i].pos);
+        QCOMPARE(cached[i].width, original[i].width);
+    }
+    QVector<ElementLayout> cachedElements = elementLayout(score);
+    QCOMPARE(cachedElements.size(), originalElements.size());
+    for (int i = 0; i < originalElements.size(); ++i) {
+        QCOMPARE(cachedElements[i].type, originalElements[i].type);
+        QCOMPARE(cachedElements[i].bbox, originalElements[i].bbox);
+    }
+
+    // the cache is used once
+    score->doLayout();
+    QCOMPARE(score->layoutStatistics().systemsFromCache, 0);
+    delete score;
+
+    MScore::saveLayoutCache = false;
+    score = readCreatedScore(path);
+    QVERIFY(score);
+    QCOMPARE(score->layoutStatistics().systemsFromCache, 0);
+    delete score;
+    MScore::saveLayoutCache = true;
+}
+
+QTEST_MAIN(TestLayoutCache)
+#include "tst_layoutcache.moc"
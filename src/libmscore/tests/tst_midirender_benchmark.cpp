@@ -0,0 +1,350 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+#include "testing/qtestsuite.h"
+#include "testbase.h"
+#include "libmscore/chord.h"
+#include "libmscore/dynamic.h"
+#include "libmscore/measure.h"
+#include "libmscore/mscoreview.h"
+#include "libmscore/note.h"
+#include "libmscore/repeatlist.h"
+#include "libmscore/rendermidi.h"
+#include "libmscore/score.h"
+#include "libmscore/segment.h"
+#include "libmscore/synthesizerstate.h"
+#include "framework/midi_old/event.h"
+#include "midi/miditypes.h"
+
+static const QString GOLDBERG_PATH("/../../../demos/goldberg.mscz");
+static const int MIN_CHUNK_SIZE = 10;       // measures, same as the playback uses
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   EditRangeView
+//    gets the ticks changed by a command from the layout,
+//    as the notation playback does
+//---------------------------------------------------------
+
+class EditRangeView : public MuseScoreView
+{
+public:
+    Fraction tick1 { -1, 1 };
+    Fraction tick2 { -1, 1 };
+
+    void layoutChanged() override
+    {
+        const CmdState& cmdState = score()->cmdState();
+        tick1 = cmdState.layoutRange() ? cmdState.startTick() : Fraction(-1, 1);
+        tick2 = cmdState.layoutRange() ? cmdState.endTick() : Fraction(-1, 1);
+    }
+
+    void dataChanged(const QRectF&) override {}
+    void updateAll() override {}
+    void drawBackground(QPainter*, const QRectF&) const override {}
+    const QRect geometry() const override { return QRect(); }
+};
+
+//---------------------------------------------------------
+//   TestMidiRenderBenchmark
+//---------------------------------------------------------
+
+class TestMidiRenderBenchmark : public QObject, public MTest
+{
+    Q_OBJECT
+
+    MasterScore* score = nullptr;
+
+    Note* middleNote() const;
+    void changeVelocity(Note* note, int offset);
+    void render(MidiRenderer& renderer, const MidiRenderer::Chunk& chunk, EventMap* events);
+    mu::midi::Chunk playerChunk(MidiRenderer& renderer, const MidiRenderer::Chunk& chunk);
+    int playerVelocity(const mu::midi::MidiData& data, int utick, int pitch) const;
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void changedChunks();
+    void changedStateChunks();
+    void benchmarkEdit_data();
+    void benchmarkEdit();
+};
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestMidiRenderBenchmark::initTestCase()
+{
+    initMTest();
+    score = readCreatedScore(root + GOLDBERG_PATH);
+    QVERIFY(score);
+}
+
+void TestMidiRenderBenchmark::cleanupTestCase()
+{
+    delete score;
+}
+
+//---------------------------------------------------------
+//   middleNote
+//    the first note of the middle measure
+//---------------------------------------------------------
+
+Note* TestMidiRenderBenchmark::middleNote() const
+{
+    Measure* m = score->tick2measure(score->lastMeasure()->endTick() * Fraction(1, 2));
+    for (Segment* s = m->first(SegmentType::ChordRest); s; s = s->next(SegmentType::ChordRest)) {
+        Element* e = s->element(0);
+        if (e && e->isChord()) {
+            return toChord(e)->upNote();
+        }
+    }
+    return nullptr;
+}
+
+void TestMidiRenderBenchmark::changeVelocity(Note* note, int offset)
+{
+    score->startCmd();
+    note->undoChangeProperty(Pid::VELO_OFFSET, offset);
+    score->endCmd();
+}
+
+void TestMidiRenderBenchmark::render(MidiRenderer& renderer, const MidiRenderer::Chunk& chunk, EventMap* events)
+{
+    SynthesizerState synthState;
+    MidiRenderer::Context ctx(synthState);
+    renderer.renderChunk(chunk, events, ctx);
+}
+
+//---------------------------------------------------------
+//   playerChunk
+//    renders a chunk into the events of the player,
+//    the same as NotationPlayback::makeChunk()
+//---------------------------------------------------------
+
+mu::midi::Chunk TestMidiRenderBenchmark::playerChunk(MidiRenderer& renderer, const MidiRenderer::Chunk& chunk)
+{
+    EventMap events;
+    SynthesizerState synthState;
+    MidiRenderer::Context ctx(synthState);
+    ctx.metronome = true;
+    ctx.renderHarmony = true;
+    renderer.renderChunk(chunk, &events, ctx);
+
+    mu::midi::Chunk result;
+    result.beginTick = chunk.utick1();
+    result.endTick = chunk.utick2();
+    for (const auto& evp : events) {
+        const NPlayEvent& ev = evp.second;
+        if (ev.type() == ME_INVALID || ev.type() == ME_EOT || ev.type() == ME_TICK1 || ev.type() == ME_TICK2) {
+            continue;
+        }
+        result.events.insert({ evp.first, mu::midi::Event(static_cast<mu::midi::channel_t>(ev.channel()),
+                                                          static_cast<mu::midi::EventType>(ev.type()),
+                                                          static_cast<uint8_t>(ev.dataA()),
+                                                          static_cast<uint8_t>(ev.dataB())) });
+    }
+    return result;
+}
+
+//---------------------------------------------------------
+//   playerVelocity
+//    the velocity the player sends for the note,
+//    -1 if it doesn't have it
+//---------------------------------------------------------
+
+int TestMidiRenderBenchmark::playerVelocity(const mu::midi::MidiData& data, int utick, int pitch) const
+{
+    auto chunkIt = data.chunks.upper_bound(utick);
+    if (chunkIt == data.chunks.begin()) {
+        return -1;
+    }
+    const mu::midi::Chunk& chunk = std::prev(chunkIt)->second;
+    auto range = chunk.events.equal_range(utick);
+    for (auto it = range.first; it != range.second; ++it) {
+        const mu::midi::Event& e = it->second;
+        if (e.type() == ME_NOTEON && e.note() == pitch && e.velocity() > 0) {
+            return e.velocity();
+        }
+    }
+    return -1;
+}
+
+//---------------------------------------------------------
+//   changedChunks
+//    an edit makes only the chunks containing it render
+//    again, and they render as a new renderer does
+//---------------------------------------------------------
+
+void TestMidiRenderBenchmark::changedChunks()
+{
+    MidiRenderer renderer(score);
+    renderer.setMinChunkSize(MIN_CHUNK_SIZE);
+
+    const std::vector<MidiRenderer::Chunk> all = renderer.takeChangedChunks();
+    QVERIFY(all.size() > 1);
+    QVERIFY(renderer.takeChangedChunks().empty());
+
+    Note* note = middleNote();
+    QVERIFY(note);
+    const Fraction tick = note->tick();
+    changeVelocity(note, 30);
+    renderer.setScoreChanged(tick, tick);
+
+    const std::vector<MidiRenderer::Chunk> changed = renderer.takeChangedChunks();
+    QVERIFY(!changed.empty());
+    QVERIFY(changed.size() < all.size());
+    for (const MidiRenderer::Chunk& ch : changed) {
+        QVERIFY(ch.tick1() <= tick.ticks() && tick.ticks() < ch.tick2());
+
+        EventMap incremental;
+        render(renderer, ch, &incremental);
+
+        MidiRenderer fresh(score);
+        fresh.setMinChunkSize(MIN_CHUNK_SIZE);
+        EventMap reference;
+        render(fresh, fresh.getChunkAt(ch.utick1()), &reference);
+
+        QCOMPARE(incremental.size(), reference.size());
+        auto i2 = reference.cbegin();
+        for (auto i1 = incremental.cbegin(); i1 != incremental.cend(); ++i1, ++i2) {
+            QCOMPARE(i1->first, i2->first);
+            QVERIFY(static_cast<const MidiCoreEvent&>(i1->second) == static_cast<const MidiCoreEvent&>(i2->second));
+        }
+    }
+
+    score->undoRedo(true, 0);
+}
+
+//---------------------------------------------------------
+//   changedStateChunks
+//    a new dynamic changes the velocities up to the end
+//    of the score
+//---------------------------------------------------------
+
+void TestMidiRenderBenchmark::changedStateChunks()
+{
+    MidiRenderer renderer(score);
+    renderer.setMinChunkSize(MIN_CHUNK_SIZE);
+    renderer.takeChangedChunks();
+
+    Note* note = middleNote();
+    QVERIFY(note);
+    const Fraction tick = note->tick();
+
+    score->startCmd();
+    Dynamic* dynamic = new Dynamic(score);
+    dynamic->setDynamicType(Dynamic::Type::PPP);
+    dynamic->setTrack(note->track());
+    dynamic->setParent(note->chord()->segment());
+    score->undoAddElement(dynamic);
+    score->endCmd();
+    renderer.setScoreChanged(tick, tick);
+
+    const std::vector<MidiRenderer::Chunk> changed = renderer.takeChangedChunks();
+    for (const MidiRenderer::Chunk& ch : changed) {
+        QVERIFY(ch.tick2() > tick.ticks());
+    }
+    QVERIFY(renderer.takeChangedChunks().empty());
+
+    size_t following = 0;
+    MidiRenderer fresh(score);
+    fresh.setMinChunkSize(MIN_CHUNK_SIZE);
+    for (const MidiRenderer::Chunk& ch : fresh.takeChangedChunks()) {
+        if (ch.tick2() > tick.ticks()) {
+            ++following;
+        }
+    }
+    QCOMPARE(changed.size(), following);
+
+    score->undoRedo(true, 0);
+}
+
+//---------------------------------------------------------
+//   benchmarkEdit
+//    from a velocity edit to the events the player sends:
+//    the edit command with its layout, the changed ticks
+//    reported by the layout, the render of the changed
+//    chunks and their replacement in the player data
+//---------------------------------------------------------
+
+void TestMidiRenderBenchmark::benchmarkEdit_data()
+{
+    QTest::addColumn<bool>("incremental");
+    QTest::newRow("full") << false;
+    QTest::newRow("incremental") << true;
+}
+
+void TestMidiRenderBenchmark::benchmarkEdit()
+{
+    QFETCH(bool, incremental);
+
+    MidiRenderer renderer(score);
+    renderer.setMinChunkSize(MIN_CHUNK_SIZE);
+
+    mu::midi::MidiData player;
+    for (const MidiRenderer::Chunk& ch : renderer.takeChangedChunks()) {
+        player.replaceChunk(playerChunk(renderer, ch));
+    }
+
+    Note* note = middleNote();
+    QVERIFY(note);
+    const int utick = score->repeatList().tick2utick(note->tick().ticks());
+    const int pitch = note->ppitch();
+
+    EditRangeView view;
+    view.setScore(score);
+    score->addViewer(&view);
+
+    int offset = 0;
+    QBENCHMARK {
+        offset = (offset == 0) ? 30 : 0;
+        changeVelocity(note, offset);
+
+        if (incremental && view.tick1 >= Fraction(0, 1)) {
+            renderer.setScoreChanged(view.tick1, view.tick2);
+        } else {
+            renderer.setScoreChanged();
+        }
+
+        for (const MidiRenderer::Chunk& ch : renderer.takeChangedChunks()) {
+            player.replaceChunk(playerChunk(renderer, ch));
+        }
+
+        QVERIFY(playerVelocity(player, utick, pitch) > 0);
+    }
+
+    score->removeViewer(&view);
+
+    //! NOTE The player has what a new render of the edited score gives
+    MidiRenderer fresh(score);
+    fresh.setMinChunkSize(MIN_CHUNK_SIZE);
+    mu::midi::MidiData reference;
+    reference.replaceChunk(playerChunk(fresh, fresh.getChunkAt(utick)));
+    QCOMPARE(playerVelocity(player, utick, pitch), playerVelocity(reference, utick, pitch));
+
+    if (offset != 0) {
+        changeVelocity(note, 0);
+    }
+}
+
+QTEST_MAIN(TestMidiRenderBenchmark)
+#include "tst_midirender_benchmark.moc"
@@ -0,0 +1,172 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+#include "testing/qtestsuite.h"
+#include "testbase.h"
+#include "libmscore/score.h"
+#include "libmscore/shape.h"
+
+static const QString GOLDBERG_PATH("/../../../demos/goldberg.mscz");
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestShape
+//---------------------------------------------------------
+
+class TestShape : public QObject, public MTest
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void minHorizontalDistance();
+    void minHorizontalDistanceSpecialCases();
+    void editShape();
+    void benchmarkMinHorizontalDistance();
+    void benchmarkLayout();
+};
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestShape::initTestCase()
+{
+    initMTest();
+}
+
+//---------------------------------------------------------
+//   minHorizontalDistance
+//---------------------------------------------------------
+
+void TestShape::minHorizontalDistance()
+{
+    Shape a;
+    Shape b;
+
+    a.add(QRectF(-10, -10, 20, 20));
+    QCOMPARE(a.minHorizontalDistance(b), -1000000.0);     // b is empty
+
+    b.add(QRectF(0, 0, 10, 10));
+    QCOMPARE(a.minHorizontalDistance(b), 10.0);
+    QCOMPARE(a.minVerticalDistance(b), 10.0);
+
+    // rectangles not overlapping vertically are ignored
+    b.add(QRectF(-30, 20, 10, 10));
+    QCOMPARE(a.minHorizontalDistance(b), 10.0);
+
+    // more rectangles than one simd register holds
+    for (int i = 0; i < 7; ++i) {
+        a.add(QRectF(i, -5 + i, 12 + i, 1));
+    }
+    QCOMPARE(a.minHorizontalDistance(b), 24.0);
+}
+
+//---------------------------------------------------------
+//   minHorizontalDistanceSpecialCases
+//    zero width rectangles collide with everything,
+//    zero height ones with zero height ones at the same y
+//---------------------------------------------------------
+
+void TestShape::minHorizontalDistanceSpecialCases()
+{
+    Shape a;
+    a.add(QRectF(0, 0, 10, 10));
+    a.add(QRectF(0, 0, 4, 10));
+
+    Shape thin(QRectF(2, 100, 0, 1));
+    QCOMPARE(a.minHorizontalDistance(thin), 8.0);
+
+    Shape flat;
+    flat.addHorizontalSpacing(Shape::SPACING_LYRICS, 1, 3);
+    QCOMPARE(a.minHorizontalDistance(flat), -1000000.0);
+    a.addHorizontalSpacing(Shape::SPACING_LYRICS, 0, 5);
+    QCOMPARE(a.minHorizontalDistance(flat), 4.0);
+    a.addHorizontalSpacing(Shape::SPACING_HARMONY, 0, 20);
+    QCOMPARE(a.minHorizontalDistance(flat), 4.0);
+}
+
+//---------------------------------------------------------
+//   editShape
+//---------------------------------------------------------
+
+void TestShape::editShape()
+{
+    Shape a;
+    for (int i = 0; i < 10; ++i) {
+        a.add(QRectF(i, i, 1, 1));
+    }
+    QCOMPARE(a.size(), size_t(10));
+
+    a.remove(QRectF(3, 3, 1, 1));
+    QCOMPARE(a.size(), size_t(9));
+    QCOMPARE(a.right(), 10.0);
+    QCOMPARE(a.bottom(), 10.0);
+
+    a.translate(QPointF(1, 2));
+    QCOMPARE(a.right(), 11.0);
+    QCOMPARE(a.bottom(), 12.0);
+
+    size_t n = 0;
+    for (const QRectF& r : a) {
+        QCOMPARE(r.width(), 1.0);
+        ++n;
+    }
+    QCOMPARE(n, a.size());
+
+    a.clear();
+    QVERIFY(a.empty());
+}
+
+//---------------------------------------------------------
+//   benchmarkMinHorizontalDistance
+//---------------------------------------------------------
+
+void TestShape::benchmarkMinHorizontalDistance()
+{
+    Shape a;
+    Shape b;
+    for (int i = 0; i < 32; ++i) {
+        a.add(QRectF(i % 7, i * 0.5, 3, 2));
+        b.add(QRectF(20 + i % 5, i * 0.5 + 0.25, 3, 2));
+    }
+    qreal d = 0.0;
+    QBENCHMARK {
+        d += a.minHorizontalDistance(b);
+    }
+    QVERIFY(d != 0.0);
+}
+
+//---------------------------------------------------------
+//   benchmarkLayout
+//---------------------------------------------------------
+
+void TestShape::benchmarkLayout()
+{
+    MasterScore* score = readCreatedScore(root + GOLDBERG_PATH);
+    QVERIFY(score);
+    QBENCHMARK {
+        score->doLayout();
+    }
+    delete score;
+}
+
+QTEST_MAIN(TestShape)
+#include "tst_shape.moc"
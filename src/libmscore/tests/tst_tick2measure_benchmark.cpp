@@ -0,0 +1,164 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+#include "testing/qtestsuite.h"
+#include "testbase.h"
+#include "libmscore/score.h"
+#include "libmscore/measure.h"
+
+static const QString MEASURE_DATA_DIR("measure_data/");
+static const QString GOLDBERG_PATH("/../../../demos/goldberg.mscz");
+static const int SYNTHETIC_MEASURES = 2000;
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestTick2MeasureBenchmark
+//---------------------------------------------------------
+
+class TestTick2MeasureBenchmark : public QObject, public MTest
+{
+    Q_OBJECT
+
+    MasterScore* syntheticScore();
+    void lookupAll(Score* score);
+
+private slots:
+    void initTestCase();
+    void lookup();
+    void lookupAfterInsert();
+    void benchmarkGoldberg();
+    void benchmarkSynthetic();
+};
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestTick2MeasureBenchmark::initTestCase()
+{
+    initMTest();
+}
+
+//---------------------------------------------------------
+//   syntheticScore
+//---------------------------------------------------------
+
+MasterScore* TestTick2MeasureBenchmark::syntheticScore()
+{
+    MasterScore* score = readScore(MEASURE_DATA_DIR + "measure-1.mscx");
+    score->startCmd();
+    score->appendMeasures(SYNTHETIC_MEASURES - score->nmeasures());
+    score->endCmd();
+    return score;
+}
+
+//---------------------------------------------------------
+//   lookupAll
+//    look up the start and the middle of every measure
+//---------------------------------------------------------
+
+void TestTick2MeasureBenchmark::lookupAll(Score* score)
+{
+    for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+        Fraction mid = m->tick() + m->ticks() * Fraction(1, 2);
+        QCOMPARE(score->tick2measure(m->tick()), m);
+        QCOMPARE(score->tick2measure(mid), m);
+    }
+}
+
+//---------------------------------------------------------
+//   lookup
+//---------------------------------------------------------
+
+void TestTick2MeasureBenchmark::lookup()
+{
+    MasterScore* score = syntheticScore();
+    QCOMPARE(score->nmeasures(), SYNTHETIC_MEASURES);
+
+    lookupAll(score);
+    QCOMPARE(score->tick2measure(Fraction(-1, 1)), score->lastMeasure());
+    QCOMPARE(score->tick2measure(score->lastMeasure()->endTick()), score->lastMeasure());
+    QVERIFY(!score->tick2measure(score->lastMeasure()->endTick() + Fraction(1, 4)));
+
+    delete score;
+}
+
+//---------------------------------------------------------
+//   lookupAfterInsert
+//    the index must follow insertions and deletions
+//---------------------------------------------------------
+
+void TestTick2MeasureBenchmark::lookupAfterInsert()
+{
+    MasterScore* score = syntheticScore();
+    lookupAll(score);
+
+    score->startCmd();
+    score->insertMeasure(ElementType::MEASURE, score->firstMeasure()->nextMeasure());
+    score->endCmd();
+    QCOMPARE(score->nmeasures(), SYNTHETIC_MEASURES + 1);
+    lookupAll(score);
+
+    score->undoRedo(true, 0);
+    QCOMPARE(score->nmeasures(), SYNTHETIC_MEASURES);
+    lookupAll(score);
+
+    delete score;
+}
+
+//---------------------------------------------------------
+//   benchmarkGoldberg
+//---------------------------------------------------------
+
+void TestTick2MeasureBenchmark::benchmarkGoldberg()
+{
+    MasterScore* score = readCreatedScore(root + GOLDBERG_PATH);
+    QVERIFY(score);
+
+    Fraction end = score->lastMeasure()->endTick();
+    QBENCHMARK {
+        for (Fraction t(0, 1); t < end; t += Fraction(1, 16)) {
+            score->tick2measure(t);
+            score->tick2measureMM(t);
+        }
+    }
+    delete score;
+}
+
+//---------------------------------------------------------
+//   benchmarkSynthetic
+//---------------------------------------------------------
+
+void TestTick2MeasureBenchmark::benchmarkSynthetic()
+{
+    MasterScore* score = syntheticScore();
+
+    Fraction end = score->lastMeasure()->endTick();
+    QBENCHMARK {
+        for (Fraction t(0, 1); t < end; t += Fraction(1, 16)) {
+            score->tick2measure(t);
+            score->tick2measureMM(t);
+        }
+    }
+    delete score;
+}
+
+QTEST_MAIN(TestTick2MeasureBenchmark)
+#include "tst_tick2measure_benchmark.moc"
@@ -10,6 +10,7 @@
 //  the file LICENCE.GPL
 //=============================================================================
 
+#include <algorithm>
 #include <cmath>
 #include <QtMath>
 
@@ -42,6 +43,63 @@ QRectF handleRect(const QPointF& pos)
     return QRectF(pos.x() - 4, pos.y() - 4, 8, 8);
 }
 
+//---------------------------------------------------------
+//   measureIndex
+//    rebuild the index if measures were added, removed,
+//    moved or multimeasure rests were switched on or off
+//    The measures are not changed while threads look up
+//    measures, only the first of them rebuilds the index.
+//---------------------------------------------------------
+
+const Score::MeasureIndex& Score::measureIndex(bool mmRests) const
+{
+    MeasureIndex& index = mmRests ? _measureIndexMM : _measureIndex;
+    bool createMMRests = mmRests && styleB(Sid::createMultiMeasureRests);
+    if (index.valid.load(std::memory_order_acquire) && index.revision == _measures.revision() && index.mmRests == createMMRests) {
+        return index;
+    }
+
+    std::lock_guard<std::mutex> lock(_measureIndexMutex);
+    if (index.valid.load(std::memory_order_relaxed) && index.revision == _measures.revision() && index.mmRests == createMMRests) {
+        return index;
+    }
+
+    index.measures.clear();
+    index.ticks.clear();
+    index.sorted = true;
+    Measure* m = mmRests ? firstMeasureMM() : firstMeasure();
+    while (m) {
+        if (!index.ticks.empty() && m->tick() < index.ticks.back()) {
+            index.sorted = false;             // measure list is being edited
+        }
+        index.measures.push_back(m);
+        index.ticks.push_back(m->tick());
+        m = mmRests ? m->nextMeasureMM() : m->nextMeasure();
+    }
+    index.revision = _measures.revision();
+    index.mmRests  = createMMRests;
+    index.valid.store(true, std::memory_order_release);
+    return index;
+}
+
+//---------------------------------------------------------
+//   measureAfter
+//    index of the first measure starting after tick
+//---------------------------------------------------------
+
+static size_t measureAfter(const std::vector<Fraction>& ticks, bool sorted, const Fraction& tick)
+{
+    if (sorted) {
+        return std::upper_bound(ticks.begin(), ticks.end(), tick) - ticks.begin();
+    }
+    for (size_t i = 0; i < ticks.size(); ++i) {
+        if (tick < ticks[i]) {
+            return i;
+        }
+    }
+    return ticks.size();
+}
+
 //---------------------------------------------------------
 //   tick2measure
 //---------------------------------------------------------
@@ -55,15 +113,14 @@ Measure* Score::tick2measure(const Fraction& tick) const
         return firstMeasure();
     }
 
-    Measure* lm = 0;
-    for (Measure* m = firstMeasure(); m; m = m->nextMeasure()) {
-        if (tick < m->tick()) {
-            Q_ASSERT(lm);
-            return lm;
-        }
-        lm = m;
+    const MeasureIndex& index = measureIndex(false);
+    size_t idx = measureAfter(index.ticks, index.sorted, tick);
+    if (idx < index.measures.size()) {
+        Q_ASSERT(idx > 0);
+        return idx > 0 ? index.measures[idx - 1] : 0;
     }
     // check last measure
+    Measure* lm = index.measures.empty() ? 0 : index.measures.back();
     if (lm && (tick >= lm->tick()) && (tick <= lm->endTick())) {
         return lm;
     }
@@ -85,16 +142,14 @@ Measure* Score::tick2measureMM(const Fraction& t) const
         tick = Fraction(0,1);
     }
 
-    Measure* lm = 0;
-
-    for (Measure* m = firstMeasureMM(); m; m = m->nextMeasureMM()) {
-        if (tick < m->tick()) {
-            Q_ASSERT(lm);
-            return lm;
-        }
-        lm = m;
+    const MeasureIndex& index = measureIndex(true);
+    size_t idx = measureAfter(index.ticks, index.sorted, tick);
+    if (idx < index.measures.size()) {
+        Q_ASSERT(idx > 0);
+        return idx > 0 ? index.measures[idx - 1] : 0;
     }
     // check last measure
+    Measure* lm = index.measures.empty() ? 0 : index.measures.back();
     if (lm && (tick >= lm->tick()) && (tick <= lm->endTick())) {
         return lm;
     }
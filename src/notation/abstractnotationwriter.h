@@ -26,6 +26,9 @@ namespace mu::notation {
 class AbstractNotationWriter : public INotationWriter
 {
 public:
+    Ret writePages(const INotationPtr notation, const std::vector<system::IODevice*>& destinationDevices, int firstPage,
+                   const Options& options = Options()) override;
+
     void abort() override;
     framework::ProgressChannel progress() const override;
 
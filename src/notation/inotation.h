@@ -20,6 +20,7 @@
 #define MU_NOTATION_INOTATION_H
 
 #include "async/notification.h"
+#include "async/channel.h"
 #include "internal/inotationundostack.h"
 #include "notationtypes.h"
 #include "inotationstyle.h"
@@ -54,6 +55,11 @@ public:
     virtual ViewMode viewMode() const = 0;
     virtual void paint(QPainter* painter, const QRectF& frameRect) = 0;
 
+    //! The pages of the score only, this is what can be cached between the repaints
+    virtual void paintScore(QPainter* painter, const QRectF& frameRect) = 0;
+    //! The editing decorations (selection, grips, shadow note...) over the pages
+    virtual void paintInteraction(QPainter* painter) = 0;
+
     virtual ValCh<bool> opened() const = 0;
     virtual void setOpened(bool opened) = 0;
 
@@ -83,6 +89,10 @@ public:
 
     // notify
     virtual async::Notification notationChanged() const = 0;
+
+    //! The canvas area changed by the last command, sent before notationChanged.
+    //! An empty rect means that everything may have changed
+    virtual async::Channel<QRectF> canvasChanged() const = 0;
 };
 }
 
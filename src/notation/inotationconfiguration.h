@@ -81,6 +81,9 @@ public:
 
     virtual ValCh<framework::Orientation> navigatorOrientation() const = 0;
     virtual void setNavigatorOrientation(framework::Orientation orientation) = 0;
+
+    virtual int layoutThreads() const = 0;
+    virtual void setLayoutThreads(int threads) = 0;
 };
 }
 
@@ -34,6 +34,12 @@ public:
 
     virtual std::shared_ptr<midi::MidiStream> midiStream() const = 0;
 
+    //! NOTE Synchronous access to the midi data for offline (non real-time) rendering,
+    //! it doesn't touch the playback stream
+    virtual midi::MidiData offlineMidiData() const = 0;
+    virtual midi::Chunk offlineMidiChunk(midi::tick_t fromTick) const = 0;
+    virtual midi::tick_t offlineLastTick() const = 0;
+
     virtual float tickToSec(int tick) const = 0;
     virtual int secToTick(float sec) const = 0;
 
@@ -20,6 +20,8 @@
 #ifndef MU_NOTATION_INOTATIONWRITER_H
 #define MU_NOTATION_INOTATIONWRITER_H
 
+#include <vector>
+
 #include "ret.h"
 #include "val.h"
 
@@ -44,6 +46,11 @@ public:
     virtual ~INotationWriter() = default;
 
     virtual Ret write(const INotationPtr notation, system::IODevice& destinationDevice, const Options& options = Options()) = 0;
+
+    //! Writes one page per device, starting with firstPage, for formats storing a single page per file.
+    //! The pages may be rendered concurrently, the devices are written in page order.
+    virtual Ret writePages(const INotationPtr notation, const std::vector<system::IODevice*>& destinationDevices, int firstPage,
+                           const Options& options = Options()) = 0;
     virtual void abort() = 0;
     virtual framework::ProgressChannel progress() const = 0;
 };
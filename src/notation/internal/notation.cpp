@@ -82,7 +82,7 @@ Notation::Notation(Ms::Score* score)
 
     m_undoStack = std::make_shared<NotationUndoStack>(this, m_notationChanged);
     m_interaction = std::make_shared<NotationInteraction>(this, m_undoStack);
-    m_playback = std::make_shared<NotationPlayback>(this);
+    m_playback = std::make_shared<NotationPlayback>(this, m_notationChanged, m_scoreUpdateListener.scoreChanged());
     m_midiInput = std::make_shared<NotationMidiInput>(this, m_undoStack);
     m_accessibility = std::make_shared<NotationAccessibility>(this, m_interaction->selectionChanged());
     m_parts = std::make_shared<NotationParts>(this, m_interaction, m_undoStack);
@@ -122,6 +122,9 @@ Notation::Notation(Ms::Score* score)
 
 Notation::~Notation()
 {
+    if (m_score) {
+        m_score->removeViewer(&m_scoreUpdateListener);
+    }
     delete m_score;
 }
 
@@ -141,9 +144,15 @@ void Notation::init()
 
 void Notation::setScore(Ms::Score* score)
 {
+    if (m_score) {
+        m_score->removeViewer(&m_scoreUpdateListener);
+    }
+
     m_score = score;
+    m_scoreUpdateListener.setScore(score);
 
     if (score) {
+        score->addViewer(&m_scoreUpdateListener);
         static_cast<NotationInteraction*>(m_interaction.get())->init();
         static_cast<NotationPlayback*>(m_playback.get())->init();
     }
@@ -236,6 +245,12 @@ ViewMode Notation::viewMode() const
 }
 
 void Notation::paint(QPainter* painter, const QRectF& frameRect)
+{
+    paintScore(painter, frameRect);
+    paintInteraction(painter);
+}
+
+void Notation::paintScore(QPainter* painter, const QRectF& frameRect)
 {
     const QList<Ms::Page*>& pages = score()->pages();
     if (pages.empty()) {
@@ -255,7 +270,10 @@ void Notation::paint(QPainter* painter, const QRectF& frameRect)
         paintPages(painter, frameRect, pages, paintBorders);
     }
     }
+}
 
+void Notation::paintInteraction(QPainter* painter)
+{
     static_cast<NotationInteraction*>(m_interaction.get())->paint(painter);
 }
 
@@ -363,6 +381,11 @@ mu::async::Notification Notation::notationChanged() const
     return m_notationChanged;
 }
 
+mu::async::Channel<QRectF> Notation::canvasChanged() const
+{
+    return m_scoreUpdateListener.canvasChanged();
+}
+
 INotationAccessibilityPtr Notation::accessibility() const
 {
     return m_accessibility;
@@ -21,6 +21,7 @@
 
 #include "inotation.h"
 #include "igetscore.h"
+#include "scoreupdatelistener.h"
 #include "async/asyncable.h"
 
 #include "modularity/ioc.h"
@@ -53,6 +54,8 @@ public:
     void setViewMode(const ViewMode& viewMode) override;
     ViewMode viewMode() const override;
     void paint(QPainter* painter, const QRectF& frameRect) override;
+    void paintScore(QPainter* painter, const QRectF& frameRect) override;
+    void paintInteraction(QPainter* painter) override;
 
     ValCh<bool> opened() const override;
     void setOpened(bool opened) override;
@@ -67,6 +70,7 @@ public:
     INotationPartsPtr parts() const override;
 
     async::Notification notationChanged() const override;
+    async::Channel<QRectF> canvasChanged() const override;
 
 protected:
     Ms::Score* score() const override;
@@ -97,6 +101,7 @@ private:
     INotationPartsPtr m_parts;
 
     async::Notification m_notationChanged;
+    ScoreUpdateListener m_scoreUpdateListener;
 };
 }
 
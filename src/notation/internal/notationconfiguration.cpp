@@ -18,6 +18,8 @@
 //=============================================================================
 #include "notationconfiguration.h"
 
+#include <QThread>
+
 #include "libmscore/preferences.h"
 #include "libmscore/mscore.h"
 
@@ -302,6 +304,16 @@ void NotationConfiguration::setNavigatorOrientation(Orientation orientation)
     settings()->setValue(NAVIGATOR_ORIENTATION, Val(isVertical));
 }
 
+int NotationConfiguration::layoutThreads() const
+{
+    return Ms::MScore::layoutThreads;
+}
+
+void NotationConfiguration::setLayoutThreads(int threads)
+{
+    Ms::MScore::layoutThreads = threads > 0 ? threads : QThread::idealThreadCount();
+}
+
 std::vector<std::string> NotationConfiguration::parseToolbarActions(const std::string& actions) const
 {
     if (actions.empty()) {
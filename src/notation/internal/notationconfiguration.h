@@ -83,6 +83,9 @@ public:
     ValCh<framework::Orientation> navigatorOrientation() const override;
     void setNavigatorOrientation(framework::Orientation orientation) override;
 
+    int layoutThreads() const override;
+    void setLayoutThreads(int threads) override;
+
 private:
     std::vector<std::string> parseToolbarActions(const std::string& actions) const;
 
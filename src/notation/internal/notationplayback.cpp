@@ -47,12 +47,21 @@ using namespace mu::midi;
 
 static constexpr int MIN_CHUNK_SIZE(10); // measure
 
-NotationPlayback::NotationPlayback(IGetScore* getScore)
+NotationPlayback::NotationPlayback(IGetScore* getScore, async::Notification notationChanged,
+                                   async::Channel<ScoreChangesRange> scoreChanged)
     : m_getScore(getScore)
 {
     m_midiStream = std::make_shared<MidiStream>();
     m_midiStream->isStreamingAllowed = true;
     m_midiStream->request.onReceive(this, [this](tick_t tick) { onChunkRequest(tick); });
+
+    scoreChanged.onReceive(this, [this](const ScoreChangesRange& range) {
+        onScoreChanged(range);
+    });
+
+    notationChanged.onNotify(this, [this]() {
+        onNotationChanged();
+    });
 }
 
 NotationPlayback::~NotationPlayback()
@@ -73,6 +82,10 @@ void NotationPlayback::init()
     m_midiRenderer = std::unique_ptr<Ms::MidiRenderer>(new Ms::MidiRenderer(score()));
     m_midiRenderer->setMinChunkSize(MIN_CHUNK_SIZE);
 
+    //! NOTE Offline export partitions the score on its own, so the chunks of the stream are left alone
+    m_offlineMidiRenderer = std::unique_ptr<Ms::MidiRenderer>(new Ms::MidiRenderer(score()));
+    m_offlineMidiRenderer->setMinChunkSize(MIN_CHUNK_SIZE);
+
     QObject::connect(score(), &Ms::Score::posChanged, [this](Ms::POS pos, int tick) {
         if (Ms::POS::CURRENT == pos) {
             m_playPositionTickChanged.send(tick);
@@ -100,9 +113,14 @@ std::shared_ptr<MidiStream> NotationPlayback::midiStream() const
     m_midiStream->initData = MidiData();
     m_midiRenderer->setScoreChanged();
 
+    //! NOTE The new stream is rendered from scratch, so only the edits made after this need to be streamed again
+    m_midiRenderer->takeChangedChunks();
+    m_streamedChunks.clear();
+
     makeInitData(m_midiStream->initData, score());
     midi::Chunk firstChunk;
-    makeChunk(firstChunk, 0 /*fromTick*/);
+    makeChunk(firstChunk, 0 /*fromTick*/, *m_midiRenderer);
+    setChunkStreamed(firstChunk.beginTick, firstChunk.endTick);
     m_midiStream->initData.chunks.insert({ firstChunk.beginTick, std::move(firstChunk) });
 
     m_midiStream->lastTick = score()->lastMeasure()->endTick().ticks();
@@ -110,6 +128,40 @@ std::shared_ptr<MidiStream> NotationPlayback::midiStream() const
     return m_midiStream;
 }
 
+MidiData NotationPlayback::offlineMidiData() const
+{
+    MidiData data;
+    if (!score()) {
+        return data;
+    }
+
+    IF_ASSERT_FAILED(m_offlineMidiRenderer) {
+        return data;
+    }
+
+    m_offlineMidiRenderer->setScoreChanged();
+    makeInitData(data, score());
+
+    return data;
+}
+
+midi::Chunk NotationPlayback::offlineMidiChunk(tick_t fromTick) const
+{
+    midi::Chunk chunk;
+    if (!score() || fromTick >= offlineLastTick()) {
+        return chunk;
+    }
+
+    makeChunk(chunk, fromTick, *m_offlineMidiRenderer);
+    return chunk;
+}
+
+tick_t NotationPlayback::offlineLastTick() const
+{
+    //! NOTE In uticks, so repeats are included
+    return score() ? score()->repeatList().ticks() : 0;
+}
+
 void NotationPlayback::makeInitData(MidiData& data, Ms::Score* score) const
 {
     data.division = Ms::MScore::division;
@@ -209,27 +261,110 @@ void NotationPlayback::onChunkRequest(tick_t tick)
     }
 
     midi::Chunk chunk;
-    makeChunk(chunk, tick);
+    makeChunk(chunk, tick, *m_midiRenderer);
+    setChunkStreamed(chunk.beginTick, chunk.endTick);
     m_midiStream->stream.send(chunk);
 }
 
-void NotationPlayback::makeChunk(midi::Chunk& chunk, tick_t fromTick) const
+void NotationPlayback::onScoreChanged(const ScoreChangesRange& range)
 {
-    Ms::EventMap msevents;
+    if (!m_midiRenderer) {
+        return;
+    }
+
+    if (range.isValid()) {
+        m_midiRenderer->setScoreChanged(Fraction::fromTicks(range.tickFrom), Fraction::fromTicks(range.tickTo));
+    } else {
+        m_midiRenderer->setScoreChanged();
+    }
 
-    const Ms::MidiRenderer::Chunk mschunk = m_midiRenderer->chunkAt(fromTick);
+    m_scoreChangeReceived = true;
+}
+
+void NotationPlayback::onNotationChanged()
+{
+    if (!m_midiRenderer || !score()) {
+        return;
+    }
+
+    //! NOTE The score was changed without a layout, so we don't know what was changed
+    if (!m_scoreChangeReceived) {
+        m_midiRenderer->setScoreChanged();
+    }
+    m_scoreChangeReceived = false;
+
+    if (m_streamedChunks.empty()) {
+        return;
+    }
+
+    //! NOTE Only the chunks the player already has are rendered again,
+    //! the others will be requested by it when needed
+    for (const Ms::MidiRenderer::Chunk& mschunk : m_midiRenderer->takeChangedChunks()) {
+        if (!isChunkStreamed(mschunk.utick1(), mschunk.utick2())) {
+            continue;
+        }
+
+        midi::Chunk chunk;
+        makeChunk(chunk, mschunk, *m_midiRenderer);
+        setChunkStreamed(chunk.beginTick, chunk.endTick);
+        m_midiStream->replace.send(chunk);
+    }
+
+    if (score()->lastMeasure()) {
+        m_midiStream->lastTick = score()->lastMeasure()->endTick().ticks();
+    }
+}
+
+bool NotationPlayback::isChunkStreamed(tick_t beginTick, tick_t endTick) const
+{
+    auto it = m_streamedChunks.upper_bound(beginTick);
+    if (it != m_streamedChunks.begin() && std::prev(it)->second > beginTick) {
+        return true;
+    }
+    return it != m_streamedChunks.end() && it->first < endTick;
+}
+
+void NotationPlayback::setChunkStreamed(tick_t beginTick, tick_t endTick) const
+{
+    if (beginTick >= endTick) {
+        return;
+    }
+
+    //! NOTE Same as the player does, a chunk replaces the ones it overlaps
+    auto it = m_streamedChunks.lower_bound(beginTick);
+    if (it != m_streamedChunks.begin() && std::prev(it)->second > beginTick) {
+        --it;
+    }
+    while (it != m_streamedChunks.end() && it->first < endTick) {
+        it = m_streamedChunks.erase(it);
+    }
+    m_streamedChunks.insert({ beginTick, endTick });
+}
+
+void NotationPlayback::makeChunk(midi::Chunk& chunk, tick_t fromTick, Ms::MidiRenderer& renderer) const
+{
+    const Ms::MidiRenderer::Chunk mschunk = renderer.chunkAt(fromTick);
     if (!mschunk) {
         return;
     }
 
-    chunk.beginTick = mschunk.tick1();
-    chunk.endTick = mschunk.tick2();
+    makeChunk(chunk, mschunk, renderer);
+}
+
+void NotationPlayback::makeChunk(midi::Chunk& chunk, const Ms::MidiRenderer::Chunk& mschunk,
+                                 Ms::MidiRenderer& renderer) const
+{
+    Ms::EventMap msevents;
+
+    //! NOTE Events are rendered in uticks, so the chunk bounds are too
+    chunk.beginTick = mschunk.utick1();
+    chunk.endTick = mschunk.utick2();
 
     Ms::SynthesizerState synState;// = mscore->synthesizerState();
     Ms::MidiRenderer::Context ctx(synState);
     ctx.metronome = true;
     ctx.renderHarmony = true;
-    m_midiRenderer->renderChunk(mschunk, &msevents, ctx);
+    renderer.renderChunk(mschunk, &msevents, ctx);
 
     for (const auto& evp : msevents) {
         tick_t tick = evp.first;
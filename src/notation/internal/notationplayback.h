@@ -20,28 +20,37 @@
 #define MU_NOTATION_NOTATIONPLAYBACK_H
 
 #include <memory>
+#include <map>
 
 #include "../inotationplayback.h"
 #include "igetscore.h"
 #include "async/asyncable.h"
+#include "async/notification.h"
+#include "async/channel.h"
+#include "../notationtypes.h"
+
+#include "libmscore/rendermidi.h"
 
 namespace Ms {
 class Score;
 class EventMap;
-class MidiRenderer;
 }
 
 namespace mu::notation {
 class NotationPlayback : public INotationPlayback, public async::Asyncable
 {
 public:
-    NotationPlayback(IGetScore* getScore);
+    NotationPlayback(IGetScore* getScore, async::Notification notationChanged, async::Channel<ScoreChangesRange> scoreChanged);
     ~NotationPlayback();
 
     void init();
 
     std::shared_ptr<midi::MidiStream> midiStream() const override;
 
+    midi::MidiData offlineMidiData() const override;
+    midi::Chunk offlineMidiChunk(midi::tick_t fromTick) const override;
+    midi::tick_t offlineLastTick() const override;
+
     float tickToSec(int tick) const override;
     int secToTick(float sec) const override;
 
@@ -67,7 +76,13 @@ private:
     void makeSynthMap(midi::SynthMap& synthMap, const Ms::Score* score) const;
 
     void onChunkRequest(midi::tick_t tick);
-    void makeChunk(midi::Chunk& chunk, midi::tick_t fromTick) const;
+    void makeChunk(midi::Chunk& chunk, midi::tick_t fromTick, Ms::MidiRenderer& renderer) const;
+    void makeChunk(midi::Chunk& chunk, const Ms::MidiRenderer::Chunk& mschunk, Ms::MidiRenderer& renderer) const;
+
+    void onScoreChanged(const ScoreChangesRange& range);
+    void onNotationChanged();
+    bool isChunkStreamed(midi::tick_t beginTick, midi::tick_t endTick) const;
+    void setChunkStreamed(midi::tick_t beginTick, midi::tick_t endTick) const;
 
     int instrumentBank(const Ms::Instrument* instrument) const;
 
@@ -83,6 +98,9 @@ private:
     IGetScore* m_getScore = nullptr;
     std::shared_ptr<midi::MidiStream> m_midiStream;
     std::unique_ptr<Ms::MidiRenderer> m_midiRenderer;
+    std::unique_ptr<Ms::MidiRenderer> m_offlineMidiRenderer;
+    bool m_scoreChangeReceived = false;
+    mutable std::map<midi::tick_t /*begin*/, midi::tick_t /*end*/> m_streamedChunks;
     async::Channel<int> m_playPositionTickChanged;
     async::Channel<LoopBoundary> m_loopBoundaryChanged;
 };
@@ -0,0 +1,73 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include "scoreupdatelistener.h"
+
+#include <QPainter>
+
+#include "libmscore/score.h"
+
+using namespace mu::notation;
+
+mu::async::Channel<QRectF> ScoreUpdateListener::canvasChanged() const
+{
+    return m_canvasChanged;
+}
+
+mu::async::Channel<ScoreChangesRange> ScoreUpdateListener::scoreChanged() const
+{
+    return m_scoreChanged;
+}
+
+void ScoreUpdateListener::layoutChanged()
+{
+    ScoreChangesRange range;
+
+    //! NOTE Called at the end of the layout, the command state is not reset yet
+    if (_score && _score->cmdState().layoutRange()) {
+        range.tickFrom = _score->cmdState().startTick().ticks();
+        range.tickTo = _score->cmdState().endTick().ticks();
+    }
+
+    m_scoreChanged.send(range);
+}
+
+void ScoreUpdateListener::dataChanged(const QRectF& rect)
+{
+    if (rect.isEmpty()) {
+        return;
+    }
+
+    m_canvasChanged.send(rect);
+}
+
+void ScoreUpdateListener::updateAll()
+{
+    m_canvasChanged.send(QRectF());
+}
+
+void ScoreUpdateListener::drawBackground(QPainter* painter, const QRectF& rect) const
+{
+    //! NOTE Same as libmscore does for a score without views
+    painter->fillRect(rect, Qt::white);
+}
+
+const QRect ScoreUpdateListener::geometry() const
+{
+    return QRect();
+}
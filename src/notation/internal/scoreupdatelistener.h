@@ -0,0 +1,56 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_NOTATION_SCOREUPDATELISTENER_H
+#define MU_NOTATION_SCOREUPDATELISTENER_H
+
+#include <QRectF>
+#include <QRect>
+
+#include "async/channel.h"
+
+#include "libmscore/mscoreview.h"
+#include "../notationtypes.h"
+
+namespace mu::notation {
+//! Registered as a view of the score to get the canvas area
+//! and the ticks which Score::update() reports as changed by a command
+class ScoreUpdateListener : public Ms::MuseScoreView
+{
+public:
+    ScoreUpdateListener() { _score = nullptr; }
+
+    //! An empty rect means that everything may have changed
+    async::Channel<QRectF> canvasChanged() const;
+
+    //! An invalid range means that the whole score may have changed
+    async::Channel<ScoreChangesRange> scoreChanged() const;
+
+    void layoutChanged() override;
+    void dataChanged(const QRectF& rect) override;
+    void updateAll() override;
+    void drawBackground(QPainter* painter, const QRectF& rect) const override;
+    const QRect geometry() const override;
+
+private:
+    async::Channel<QRectF> m_canvasChanged;
+    async::Channel<ScoreChangesRange> m_scoreChanged;
+};
+}
+
+#endif // MU_NOTATION_SCOREUPDATELISTENER_H
@@ -175,11 +175,13 @@ void NotationModule::registerUiTypes()
     Ms::MScore::registerUiTypes();
 }
 
-void NotationModule::onInit(const IApplication::RunMode&)
+void NotationModule::onInit(const IApplication::RunMode& mode)
 {
     s_configuration->init();
-    s_actionController->init();
-    s_midiInputController->init();
+    if (mode == IApplication::RunMode::Editor) {
+        s_actionController->init();
+        s_midiInputController->init();
+    }
 
     Notation::init();
 }
@@ -278,6 +278,13 @@ struct SelectionRange {
     Fraction endTick;
 };
 
+struct ScoreChangesRange {
+    int tickFrom = -1;
+    int tickTo = -1;
+
+    bool isValid() const { return tickFrom >= 0 && tickTo >= tickFrom; }
+};
+
 struct StaffConfig
 {
     bool visible = false;
@@ -89,6 +89,11 @@ void NotationPaintView::initBackground()
         m_backgroundColor = color;
         update();
     });
+
+    configuration()->foregroundColorChanged().onReceive(this, [this](const QColor&) {
+        m_tileCache.invalidateAll();
+        update();
+    });
 }
 
 void NotationPaintView::initNavigatorOrientation()
@@ -161,11 +166,15 @@ void NotationPaintView::onCurrentNotationChanged()
 
     if (m_notation) {
         m_notation->notationChanged().resetOnNotify(this);
+        m_notation->canvasChanged().resetOnReceive(this);
         INotationInteractionPtr interaction = m_notation->interaction();
         interaction->noteInput()->stateChanged().resetOnNotify(this);
         interaction->selectionChanged().resetOnNotify(this);
     }
 
+    m_tileCache.invalidateAll();
+    m_selectionCanvasRect = QRectF();
+
     m_notation = globalContext()->currentNotation();
     if (!m_notation) {
         return;
@@ -173,8 +182,12 @@ void NotationPaintView::onCurrentNotationChanged()
 
     onViewSizeChanged(); //! NOTE Set view size to notation
 
+    m_notation->canvasChanged().onReceive(this, [this](const QRectF& canvasRect) {
+        onCanvasChanged(canvasRect);
+    });
+
     m_notation->notationChanged().onNotify(this, [this]() {
-        update();
+        onNotationChanged();
     });
 
     onNoteInputChanged();
@@ -207,8 +220,34 @@ void NotationPaintView::onCurrentNotationChanged()
     update();
 }
 
+void NotationPaintView::onCanvasChanged(const QRectF& canvasRect)
+{
+    if (canvasRect.isEmpty()) {
+        m_tileCache.invalidateAll();
+    } else {
+        m_tileCache.invalidate(canvasRect);
+    }
+
+    m_canvasChangeReceived = true;
+    update();
+}
+
+void NotationPaintView::onNotationChanged()
+{
+    //! NOTE Not every change goes through Score::update(), which reports the changed area
+    if (!m_canvasChangeReceived) {
+        m_tileCache.invalidateAll();
+    }
+
+    m_canvasChangeReceived = false;
+    m_selectionCanvasRect = selectionCanvasRect();
+    update();
+}
+
 void NotationPaintView::onViewSizeChanged()
 {
+    m_tileCache.invalidateAll();
+
     if (!notation()) {
         return;
     }
@@ -270,6 +309,8 @@ void NotationPaintView::onNoteInputChanged()
 {
     TRACEFUNC;
 
+    invalidateSelectionTiles();
+
     if (isNoteEnterMode()) {
         setAcceptHoverEvents(true);
         QRectF cursorRect = notationNoteInput()->cursorRect();
@@ -283,6 +324,8 @@ void NotationPaintView::onNoteInputChanged()
 
 void NotationPaintView::onSelectionChanged()
 {
+    invalidateSelectionTiles();
+
     if (notationSelection()->isNone()) {
         return;
     }
@@ -295,6 +338,31 @@ void NotationPaintView::onSelectionChanged()
     update();
 }
 
+//! NOTE The selected elements are painted in the selection colors,
+//! so the tiles under the previous and the new selection are painted again
+void NotationPaintView::invalidateSelectionTiles()
+{
+    if (!m_selectionCanvasRect.isNull()) {
+        m_tileCache.invalidate(m_selectionCanvasRect);
+    }
+
+    m_selectionCanvasRect = selectionCanvasRect();
+
+    if (!m_selectionCanvasRect.isNull()) {
+        m_tileCache.invalidate(m_selectionCanvasRect);
+    }
+}
+
+QRectF NotationPaintView::selectionCanvasRect() const
+{
+    INotationSelectionPtr selection = notationSelection();
+    if (!selection || selection->isNone()) {
+        return QRectF();
+    }
+
+    return selection->canvasBoundingRect();
+}
+
 bool NotationPaintView::isNoteEnterMode() const
 {
     return notationNoteInput() ? notationNoteInput()->isNoteInputMode() : false;
@@ -326,9 +394,14 @@ void NotationPaintView::paint(QPainter* painter)
     QRect rect(0, 0, width(), height());
     painter->fillRect(rect, m_backgroundColor);
 
+    m_tileCache.draw(painter, m_matrix, toLogical(rect), [this](QPainter* tilePainter, const QRectF& frameRect) {
+        notation()->paintScore(tilePainter, frameRect);
+    });
+    m_canvasChangeReceived = false;
+
     painter->setTransform(m_matrix);
 
-    notation()->paint(painter, toLogical(rect));
+    notation()->paintInteraction(painter);
 
     m_playbackCursor->paint(painter);
     m_noteInputCursor->paint(painter);
@@ -36,6 +36,7 @@
 #include "noteinputcursor.h"
 #include "playbackcursor.h"
 #include "loopmarker.h"
+#include "notationtilecache.h"
 
 namespace mu::notation {
 class NotationPaintView : public QQuickPaintedItem, public IControlledView, public async::Asyncable, public actions::Actionable
@@ -158,6 +159,10 @@ private:
 
     void onNoteInputChanged();
     void onSelectionChanged();
+    void onCanvasChanged(const QRectF& canvasRect);
+    void onNotationChanged();
+    void invalidateSelectionTiles();
+    QRectF selectionCanvasRect() const;
 
     void onPlayingChanged();
     void movePlaybackCursor(uint32_t tick);
@@ -175,6 +180,9 @@ private:
     std::unique_ptr<NoteInputCursor> m_noteInputCursor;
     std::unique_ptr<LoopMarker> m_loopInMarker;
     std::unique_ptr<LoopMarker> m_loopOutMarker;
+    NotationTileCache m_tileCache;
+    bool m_canvasChangeReceived = false;
+    QRectF m_selectionCanvasRect;
 
     qreal m_previousVerticalScrollPosition = 0;
     qreal m_previousHorizontalScrollPosition = 0;
@@ -0,0 +1,156 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include "notationtilecache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <QPainter>
+
+using namespace mu::notation;
+
+static constexpr int TILE_SIZE = 256; // in view pixels
+static constexpr qint64 MAX_CACHE_BYTES = 96 * 1024 * 1024; // tiles outside of the view are kept up to this size
+
+NotationTileCache::TileKey NotationTileCache::tileKey(int column, int row)
+{
+    return (TileKey(quint32(column)) << 32) | TileKey(quint32(row));
+}
+
+void NotationTileCache::draw(QPainter* painter, const QTransform& matrix, const QRectF& frameRect, const PaintFunc& paint)
+{
+    const qreal scaling = matrix.m11();
+    const bool isAligned = matrix.type() <= QTransform::TxScale && qFuzzyCompare(scaling, matrix.m22()) && scaling > 0;
+
+    if (!isAligned) {
+        //! NOTE The tiles can't be put together in a rotated or distorted view, paint without the cache
+        painter->setTransform(matrix);
+        paint(painter, frameRect);
+        return;
+    }
+
+    const qreal devicePixelRatio = painter->device()->devicePixelRatioF();
+    if (!qFuzzyCompare(scaling, m_scaling) || !qFuzzyCompare(devicePixelRatio, m_devicePixelRatio)) {
+        invalidateAll();
+        m_scaling = scaling;
+        m_devicePixelRatio = devicePixelRatio;
+    }
+
+    ++m_drawCount;
+
+    //! NOTE Tile (column, row) covers the view pixels [column * TILE_SIZE, (column + 1) * TILE_SIZE)
+    //! of the canvas scaled to the view, so only the scroll offset is left to apply when blitting
+    painter->save();
+    painter->setTransform(QTransform::fromTranslate(matrix.dx(), matrix.dy()));
+
+    const QRect range = tilesRange(frameRect);
+    for (int row = range.top(); row <= range.bottom(); ++row) {
+        for (int column = range.left(); column <= range.right(); ++column) {
+            Tile& tile = m_tiles[tileKey(column, row)];
+            if (tile.image.isNull()) {
+                tile.image = renderTile(column, row, painter, paint);
+            }
+            tile.lastUsed = m_drawCount;
+
+            painter->drawImage(QPointF(column * TILE_SIZE, row * TILE_SIZE), tile.image);
+        }
+    }
+
+    painter->restore();
+
+    removeUnusedTiles();
+}
+
+void NotationTileCache::invalidate(const QRectF& canvasRect)
+{
+    if (m_tiles.isEmpty()) {
+        return;
+    }
+
+    const QRect range = tilesRange(canvasRect);
+    for (int row = range.top(); row <= range.bottom(); ++row) {
+        for (int column = range.left(); column <= range.right(); ++column) {
+            m_tiles.remove(tileKey(column, row));
+        }
+    }
+}
+
+void NotationTileCache::invalidateAll()
+{
+    m_tiles.clear();
+}
+
+QRect NotationTileCache::tilesRange(const QRectF& canvasRect) const
+{
+    //! NOTE One pixel around for the antialiasing of the elements at the edges
+    QRectF viewRect(canvasRect.topLeft() * m_scaling, canvasRect.size() * m_scaling);
+    viewRect.adjust(-1, -1, 1, 1);
+
+    int left = static_cast<int>(std::floor(viewRect.left() / TILE_SIZE));
+    int top = static_cast<int>(std::floor(viewRect.top() / TILE_SIZE));
+    int right = static_cast<int>(std::floor(viewRect.right() / TILE_SIZE));
+    int bottom = static_cast<int>(std::floor(viewRect.bottom() / TILE_SIZE));
+
+    return QRect(QPoint(left, top), QPoint(right, bottom));
+}
+
+QImage NotationTileCache::renderTile(int column, int row, const QPainter* viewPainter, const PaintFunc& paint) const
+{
+    const int imageSize = std::lrint(TILE_SIZE * m_devicePixelRatio);
+
+    QImage image(imageSize, imageSize, QImage::Format_ARGB32_Premultiplied);
+    image.setDevicePixelRatio(m_devicePixelRatio);
+    image.fill(Qt::transparent);
+
+    QRectF tileRect(column * TILE_SIZE / m_scaling, row * TILE_SIZE / m_scaling, TILE_SIZE / m_scaling, TILE_SIZE / m_scaling);
+
+    QPainter painter(&image);
+    painter.setRenderHints(viewPainter->renderHints());
+    painter.scale(m_scaling, m_scaling);
+    painter.translate(-tileRect.topLeft());
+
+    const qreal pixel = 1.0 / m_scaling;
+    paint(&painter, tileRect.adjusted(-pixel, -pixel, pixel, pixel));
+
+    return image;
+}
+
+void NotationTileCache::removeUnusedTiles()
+{
+    const qint64 tileBytes = qint64(TILE_SIZE * m_devicePixelRatio) * qint64(TILE_SIZE * m_devicePixelRatio) * 4;
+    qint64 excessBytes = m_tiles.size() * tileBytes - MAX_CACHE_BYTES;
+    if (excessBytes <= 0) {
+        return;
+    }
+
+    std::vector<std::pair<quint64 /*lastUsed*/, TileKey> > unused;
+    for (auto it = m_tiles.cbegin(); it != m_tiles.cend(); ++it) {
+        if (it.value().lastUsed != m_drawCount) {
+            unused.push_back({ it.value().lastUsed, it.key() });
+        }
+    }
+
+    std::sort(unused.begin(), unused.end());
+
+    for (size_t i = 0; i < unused.size() && excessBytes > 0; ++i) {
+        m_tiles.remove(unused[i].second);
+        excessBytes -= tileBytes;
+    }
+}
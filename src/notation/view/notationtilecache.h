@@ -0,0 +1,70 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_NOTATION_NOTATIONTILECACHE_H
+#define MU_NOTATION_NOTATIONTILECACHE_H
+
+#include <functional>
+
+#include <QHash>
+#include <QImage>
+#include <QRectF>
+#include <QTransform>
+
+class QPainter;
+
+namespace mu::notation {
+//! Keeps the painted score as tiles rasterised at the current zoom level,
+//! so that scrolling and repaints for overlays (cursors, markers) only blit them.
+//! The tiles are aligned on the canvas, not on the view, and painted
+//! again only after they were invalidated or when the zoom changes.
+class NotationTileCache
+{
+public:
+    using PaintFunc = std::function<void (QPainter* painter, const QRectF& frameRect)>;
+
+    NotationTileCache() = default;
+
+    //! Draws the canvas area frameRect as seen through the view matrix,
+    //! the missing tiles are painted with paint() first
+    void draw(QPainter* painter, const QTransform& matrix, const QRectF& frameRect, const PaintFunc& paint);
+
+    void invalidate(const QRectF& canvasRect);
+    void invalidateAll();
+
+private:
+    struct Tile {
+        QImage image;
+        quint64 lastUsed = 0;
+    };
+
+    using TileKey = quint64;
+    static TileKey tileKey(int column, int row);
+
+    QRect tilesRange(const QRectF& canvasRect) const;
+    QImage renderTile(int column, int row, const QPainter* viewPainter, const PaintFunc& paint) const;
+    void removeUnusedTiles();
+
+    QHash<TileKey, Tile> m_tiles;
+    qreal m_scaling = 0;
+    qreal m_devicePixelRatio = 0;
+    quint64 m_drawCount = 0;
+};
+}
+
+#endif // MU_NOTATION_NOTATIONTILECACHE_H
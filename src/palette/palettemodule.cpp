@@ -64,6 +64,11 @@ std::string PaletteModule::moduleName() const
     return "palette";
 }
 
+bool PaletteModule::isUsedByConverter() const
+{
+    return false;
+}
+
 void PaletteModule::registerExports()
 {
     ioc()->registerExport<IPaletteAdapter>(moduleName(), s_adapter);
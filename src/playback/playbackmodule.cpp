@@ -48,6 +48,11 @@ std::string PlaybackModule::moduleName() const
     return "playback";
 }
 
+bool PlaybackModule::isUsedByConverter() const
+{
+    return false;
+}
+
 void PlaybackModule::registerExports()
 {
     ioc()->registerExport<IPlaybackController>(moduleName(), s_playbackController);
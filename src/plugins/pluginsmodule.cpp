@@ -48,6 +48,11 @@ std::string PluginsModule::moduleName() const
     return "plugins";
 }
 
+bool PluginsModule::isUsedByConverter() const
+{
+    return false;
+}
+
 void PluginsModule::registerExports()
 {
     ioc()->registerExport<IPluginsService>(moduleName(), new PluginsService());
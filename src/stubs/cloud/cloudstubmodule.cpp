@@ -37,6 +37,11 @@ std::string CloudStubModule::moduleName() const
     return "cloud_stub";
 }
 
+bool CloudStubModule::isUsedByConverter() const
+{
+    return false;
+}
+
 void CloudStubModule::registerExports()
 {
     ioc()->registerExport<IAccountController>(moduleName(), new AccountControllerStub());
@@ -38,6 +38,11 @@ std::string ExtensionsStubModule::moduleName() const
     return "extensions_stub";
 }
 
+bool ExtensionsStubModule::isUsedByConverter() const
+{
+    return false;
+}
+
 void ExtensionsStubModule::registerExports()
 {
     ioc()->registerExport<IExtensionsConfiguration>(moduleName(), new ExtensionsConfigurationStub());
@@ -30,6 +30,11 @@ std::string NetworkStubModule::moduleName() const
     return "network_stub";
 }
 
+bool NetworkStubModule::isUsedByConverter() const
+{
+    return false;
+}
+
 void NetworkStubModule::registerExports()
 {
     ioc()->registerExport<INetworkManagerCreator>(moduleName(), new NetworkManagerCreatorStub());
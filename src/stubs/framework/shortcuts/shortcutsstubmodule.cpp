@@ -40,6 +40,11 @@ std::string ShortcutsStubModule::moduleName() const
     return "shortcuts_stub";
 }
 
+bool ShortcutsStubModule::isUsedByConverter() const
+{
+    return false;
+}
+
 void ShortcutsStubModule::registerExports()
 {
     ioc()->registerExport<IShortcutsRegister>(moduleName(), new ShortcutsRegisterStub());
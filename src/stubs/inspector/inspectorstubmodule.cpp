@@ -36,6 +36,11 @@ std::string InspectorModule::moduleName() const
     return "inspector";
 }
 
+bool InspectorModule::isUsedByConverter() const
+{
+    return false;
+}
+
 void InspectorModule::registerExports()
 {
     ioc()->registerExport<IInspectorAdapter>(moduleName(), new InspectorAdapterStub());
@@ -28,6 +28,7 @@ public:
     InspectorModule() = default;
 
     std::string moduleName() const override;
+    bool isUsedByConverter() const override;
     void registerExports() override;
     void registerResources() override;
     void registerUiTypes() override;
@@ -38,6 +38,11 @@ std::string LanguagesStubModule::moduleName() const
     return "languages_stub";
 }
 
+bool LanguagesStubModule::isUsedByConverter() const
+{
+    return false;
+}
+
 void LanguagesStubModule::registerExports()
 {
     ioc()->registerExport<ILanguagesConfiguration>(moduleName(), new LanguagesConfigurationStub());
@@ -39,6 +39,11 @@ std::string PaletteStubModule::moduleName() const
     return "palette_stub";
 }
 
+bool PaletteStubModule::isUsedByConverter() const
+{
+    return false;
+}
+
 void PaletteStubModule::registerExports()
 {
     ioc()->registerExport<IPaletteAdapter>(moduleName(), new PaletteAdapterStub());
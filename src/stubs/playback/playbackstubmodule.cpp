@@ -37,6 +37,11 @@ std::string PlaybackStubModule::moduleName() const
     return "playback_stub";
 }
 
+bool PlaybackStubModule::isUsedByConverter() const
+{
+    return false;
+}
+
 void PlaybackStubModule::registerExports()
 {
     ioc()->registerExport<IPlaybackController>(moduleName(), new PlaybackControllerStub());
@@ -40,6 +40,11 @@ std::string PluginsStubModule::moduleName() const
     return "plugins_stub";
 }
 
+bool PluginsStubModule::isUsedByConverter() const
+{
+    return false;
+}
+
 void PluginsStubModule::registerExports()
 {
     ioc()->registerExport<IPluginsService>(moduleName(), new PluginsServiceStub());
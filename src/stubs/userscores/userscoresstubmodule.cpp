@@ -39,6 +39,11 @@ std::string UserScoresStubModule::moduleName() const
     return "userscores_stub";
 }
 
+bool UserScoresStubModule::isUsedByConverter() const
+{
+    return false;
+}
+
 void UserScoresStubModule::registerExports()
 {
     ioc()->registerExport<IFileScoreController>(moduleName(), new FileScoreControllerStub());
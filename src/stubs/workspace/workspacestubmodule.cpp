@@ -42,6 +42,11 @@ std::string WorkspaceStubModule::moduleName() const
     return "workspace_stub";
 }
 
+bool WorkspaceStubModule::isUsedByConverter() const
+{
+    return false;
+}
+
 void WorkspaceStubModule::registerExports()
 {
     ioc()->registerExport<IWorkspaceConfiguration>(moduleName(), new WorkspaceConfigurationStub());
@@ -51,6 +51,11 @@ std::string UserScoresModule::moduleName() const
     return "userscores";
 }
 
+bool UserScoresModule::isUsedByConverter() const
+{
+    return false;
+}
+
 void UserScoresModule::registerExports()
 {
     ioc()->registerExport<IFileScoreController>(moduleName(), s_fileController);
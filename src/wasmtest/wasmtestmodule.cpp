@@ -26,6 +26,11 @@ std::string WasmTestModule::moduleName() const
     return "wasmTest";
 }
 
+bool WasmTestModule::isUsedByConverter() const
+{
+    return false;
+}
+
 void WasmTestModule::onStartApp()
 {
     Ms::Score score;
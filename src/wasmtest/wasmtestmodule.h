@@ -35,6 +35,7 @@ class WasmTestModule : public framework::IModuleSetup
 public:
 
     std::string moduleName() const override;
+    bool isUsedByConverter() const override;
     void onStartApp() override;
 };
 }
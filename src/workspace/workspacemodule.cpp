@@ -55,6 +55,11 @@ std::string WorkspaceModule::moduleName() const
     return "workspace";
 }
 
+bool WorkspaceModule::isUsedByConverter() const
+{
+    return false;
+}
+
 void WorkspaceModule::registerExports()
 {
     ioc()->registerExport<IWorkspaceConfiguration>(moduleName(), s_configuration);
@@ -43,6 +43,9 @@
 #include <QDebug>
 #include <QFileInfo>
 
+#include <cstring>
+#include <limits>
+
 #include "qzipreader_p.h"
 #include "qzipwriter_p.h"
 
@@ -542,6 +545,8 @@ public:
     }
 
     void scanFiles();
+    bool locateFile(const QString& fileName, qint64* dataStart, int* compressedSize, int* uncompressedSize,
+                    int* compressionMethod);
 
     MQZipReader::Status status;
 };
@@ -965,49 +970,67 @@ MQZipReader::FileInfo MQZipReader::entryInfoAt(int index) const
     return MQZipReader::FileInfo();
 }
 
-/*!
-    Fetch the file contents from the zip archive and return the uncompressed bytes.
+/*
+    Find the entry \a fileName and return the position of its data in the archive,
+    its sizes and compression method.
 */
-QByteArray MQZipReader::fileData(const QString& fileName) const
+bool MQZipReaderPrivate::locateFile(const QString& fileName, qint64* dataStart, int* compressedSize,
+                                    int* uncompressedSize, int* compressionMethod)
 {
-    d->scanFiles();
+    scanFiles();
     int i;
-    for (i = 0; i < d->fileHeaders.size(); ++i) {
-        if (QString::fromUtf8(d->fileHeaders.at(i).file_name) == fileName) {
+    for (i = 0; i < fileHeaders.size(); ++i) {
+        if (QString::fromUtf8(fileHeaders.at(i).file_name) == fileName) {
             break;
         }
     }
-    if (i == d->fileHeaders.size()) {
-        return QByteArray();
+    if (i == fileHeaders.size()) {
+        return false;
     }
 
-    FileHeader header = d->fileHeaders.at(i);
+    FileHeader header = fileHeaders.at(i);
 
     ushort version_needed = readUShort(header.h.version_needed);
     if (version_needed > ZIP_VERSION) {
         qWarning("QZip: .ZIP specification version %d implementationis needed to extract the data.", version_needed);
-        return QByteArray();
+        return false;
     }
 
     ushort general_purpose_bits = readUShort(header.h.general_purpose_bits);
-    int compressed_size = readUInt(header.h.compressed_size);
-    int uncompressed_size = readUInt(header.h.uncompressed_size);
+    *compressedSize = readUInt(header.h.compressed_size);
+    *uncompressedSize = readUInt(header.h.uncompressed_size);
     int start = readUInt(header.h.offset_local_header);
     //qDebug("uncompressing file %d: local header at %d", i, start);
 
-    d->device->seek(start);
+    device->seek(start);
     LocalFileHeader lh;
-    d->device->read((char*)&lh, sizeof(LocalFileHeader));
+    device->read((char*)&lh, sizeof(LocalFileHeader));
     uint skip = readUShort(lh.file_name_length) + readUShort(lh.extra_field_length);
-    d->device->seek(d->device->pos() + skip);
+    *dataStart = device->pos() + skip;
 
-    int compression_method = readUShort(lh.compression_method);
-    //qDebug("file=%s: compressed_size=%d, uncompressed_size=%d", fileName.toLocal8Bit().data(), compressed_size, uncompressed_size);
+    *compressionMethod = readUShort(lh.compression_method);
+    //qDebug("file=%s: compressed_size=%d, uncompressed_size=%d", fileName.toLocal8Bit().data(), *compressedSize, *uncompressedSize);
 
     if ((general_purpose_bits & Encrypted) != 0) {
         qWarning("QZip: Unsupported encryption method is needed to extract the data.");
+        return false;
+    }
+    return true;
+}
+
+/*!
+    Fetch the file contents from the zip archive and return the uncompressed bytes.
+*/
+QByteArray MQZipReader::fileData(const QString& fileName) const
+{
+    qint64 dataStart;
+    int compressed_size;
+    int uncompressed_size;
+    int compression_method;
+    if (!d->locateFile(fileName, &dataStart, &compressed_size, &uncompressed_size, &compression_method)) {
         return QByteArray();
     }
+    d->device->seek(dataStart);
 
     //qDebug("file at %lld", d->device->pos());
     QByteArray compressed = d->device->read(compressed_size);
@@ -1051,6 +1074,134 @@ QByteArray MQZipReader::fileData(const QString& fileName) const
     return QByteArray();
 }
 
+/*
+    Sequential device inflating one entry of the archive on demand.
+    The archive device is shared with the reader and other entry
+    devices, so every read seeks to where this entry left off.
+*/
+class MQZipFileDevice : public QIODevice
+{
+public:
+    MQZipFileDevice(QIODevice* archive, qint64 dataStart, int compressedSize, bool deflated)
+        : _archive(archive), _pos(dataStart), _remaining(compressedSize), _deflated(deflated)
+    {
+        memset(&_stream, 0, sizeof(_stream));
+        _streamOk = !_deflated || inflateInit2(&_stream, -MAX_WBITS) == Z_OK;
+        if (_deflated) {
+            _inBuf.resize(IN_BUF_SIZE);
+        }
+    }
+
+    ~MQZipFileDevice()
+    {
+        if (_deflated && _streamOk) {
+            inflateEnd(&_stream);
+        }
+    }
+
+    bool isSequential() const override { return true; }
+    bool atEnd() const override { return _finished && QIODevice::atEnd(); }
+
+protected:
+    qint64 readData(char* data, qint64 maxSize) override;
+    qint64 writeData(const char*, qint64) override { return -1; }
+
+private:
+    static const int IN_BUF_SIZE = 64 * 1024;
+
+    QIODevice* _archive;
+    qint64 _pos;                // position of the next compressed byte in the archive
+    qint64 _remaining;          // compressed bytes not yet read from the archive
+    bool _deflated;
+    bool _streamOk;
+    bool _finished { false };
+    z_stream _stream;
+    QByteArray _inBuf;
+};
+
+qint64 MQZipFileDevice::readData(char* data, qint64 maxSize)
+{
+    if (_finished || maxSize <= 0) {
+        return 0;
+    }
+    if (!_streamOk) {
+        return -1;
+    }
+    if (!_deflated) {
+        _archive->seek(_pos);
+        qint64 n = _archive->read(data, qMin(maxSize, _remaining));
+        if (n <= 0) {
+            _finished = true;
+            return n < 0 ? -1 : 0;
+        }
+        _pos += n;
+        _remaining -= n;
+        _finished = _remaining == 0;
+        return n;
+    }
+
+    _stream.next_out = reinterpret_cast<Bytef*>(data);
+    _stream.avail_out = uInt(qMin(maxSize, qint64(std::numeric_limits<uInt>::max())));
+    while (_stream.avail_out > 0) {
+        if (_stream.avail_in == 0 && _remaining > 0) {
+            _archive->seek(_pos);
+            qint64 n = _archive->read(_inBuf.data(), qMin(qint64(IN_BUF_SIZE), _remaining));
+            if (n <= 0) {
+                qWarning("QZip: unexpected end of compressed data");
+                _finished = true;
+                break;
+            }
+            _pos += n;
+            _remaining -= n;
+            _stream.next_in = reinterpret_cast<Bytef*>(_inBuf.data());
+            _stream.avail_in = uInt(n);
+        }
+        uInt availOut = _stream.avail_out;
+        int res = inflate(&_stream, Z_NO_FLUSH);
+        if (res == Z_STREAM_END) {
+            _finished = true;
+            break;
+        }
+        if (res != Z_OK && res != Z_BUF_ERROR) {
+            qWarning("QZip: inflate error %d: input data is corrupted", res);
+            _finished = true;
+            break;
+        }
+        if (_stream.avail_out == availOut && _stream.avail_in == 0 && _remaining == 0) {
+            _finished = true;           // truncated stream, no progress possible
+            break;
+        }
+    }
+    return qint64(reinterpret_cast<char*>(_stream.next_out) - data);
+}
+
+/*!
+    Returns an open, read only device inflating the file \a fileName while
+    it is read, or \c nullptr if there is no such file.
+    The caller owns the device; it must not outlive this reader.
+*/
+QIODevice* MQZipReader::fileDevice(const QString& fileName) const
+{
+    qint64 dataStart;
+    int compressedSize;
+    int uncompressedSize;
+    int compressionMethod;
+    if (!d->locateFile(fileName, &dataStart, &compressedSize, &uncompressedSize, &compressionMethod)) {
+        return nullptr;
+    }
+    if (compressionMethod != CompressionMethodStored && compressionMethod != CompressionMethodDeflated) {
+        qWarning("QZip: Unsupported compression method %d is needed to extract the data.", compressionMethod);
+        return nullptr;
+    }
+    if (compressionMethod == CompressionMethodStored) {
+        compressedSize = qMin(compressedSize, uncompressedSize);
+    }
+    QIODevice* dev = new MQZipFileDevice(d->device, dataStart, compressedSize,
+                                         compressionMethod == CompressionMethodDeflated);
+    dev->open(QIODevice::ReadOnly);
+    return dev;
+}
+
 /*!
     Extracts the full contents of the zip file into \a destinationDir on
     the local filesystem.